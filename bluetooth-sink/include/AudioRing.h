@@ -0,0 +1,35 @@
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+
+/* Lock-free ring of 16 bit stereo frames, from the A2DP data callback (the
+ * only producer) to the I2S task (the only consumer). Each side only moves
+ * its own index and reads the other one, so neither blocks. */
+class AudioRing
+{
+public:
+  static const uint32_t CAPACITY = 8192; // Frames, a power of 2 (186 ms at 44.1 kHz)
+
+  // Producer. Frames that don't fit are dropped, counted as an overrun.
+  void write(const uint8_t *data, uint32_t length);
+
+  // Consumer. Copies up to count frames, returns how many.
+  uint32_t read(uint32_t *frames, uint32_t count);
+  // Consumer. Drops everything buffered.
+  void clear();
+
+  uint32_t fill() const
+  {
+    return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+  }
+  uint32_t getOverruns() const { return overruns_; }
+  uint32_t getDroppedFrames() const { return droppedFrames_; }
+
+private:
+  uint32_t frames_[CAPACITY];
+  std::atomic<uint32_t> head_{0}; // Frames written, wraps
+  std::atomic<uint32_t> tail_{0}; // Frames read, wraps
+  volatile uint32_t overruns_ = 0;
+  volatile uint32_t droppedFrames_ = 0;
+};
@@ -0,0 +1,38 @@
+#include "AudioRing.h"
+
+void AudioRing::write(const uint8_t *data, uint32_t length)
+{
+  uint32_t count = length / sizeof(uint32_t);
+  uint32_t head = head_.load(std::memory_order_relaxed);
+  uint32_t space = CAPACITY - (head - tail_.load(std::memory_order_acquire));
+  if (count > space)
+  {
+    overruns_++;
+    droppedFrames_ += count - space;
+    count = space;
+  }
+
+  uint32_t index = head & (CAPACITY - 1);
+  uint32_t first = min(count, CAPACITY - index);
+  memcpy(&frames_[index], data, first * sizeof(uint32_t));
+  memcpy(frames_, data + first * sizeof(uint32_t), (count - first) * sizeof(uint32_t));
+  head_.store(head + count, std::memory_order_release);
+}
+
+uint32_t AudioRing::read(uint32_t *frames, uint32_t count)
+{
+  uint32_t tail = tail_.load(std::memory_order_relaxed);
+  count = min(count, head_.load(std::memory_order_acquire) - tail);
+
+  uint32_t index = tail & (CAPACITY - 1);
+  uint32_t first = min(count, CAPACITY - index);
+  memcpy(frames, &frames_[index], first * sizeof(uint32_t));
+  memcpy(frames + first, frames_, (count - first) * sizeof(uint32_t));
+  tail_.store(tail + count, std::memory_order_release);
+  return count;
+}
+
+void AudioRing::clear()
+{
+  tail_.store(head_.load(std::memory_order_acquire), std::memory_order_release);
+}
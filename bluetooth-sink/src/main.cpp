@@ -3,26 +3,82 @@
 #include <Adafruit_NeoPixel.h>
 #include "BluetoothA2DPSink.h"
 #include "AudioTools.h"
+#include "AudioRing.h"
+#include <atomic>
+#include <esp_freertos_hooks.h>
 
 #define DEBUG_BT_AUDIO false
 
 #define I2C_ADDRESS 0x03
-#define MAX_BT_DATA_LENGTH 136
+#define MAX_FIELD_LENGTH 32                    // Characters of each text field sent to the main board
+#define BT_STATUS_LENGTH 20                    // Status frame, see publishStatus()
+#define BT_FIELD_LENGTH (3 + MAX_FIELD_LENGTH) // Text field frame
+#define PLAY_POS_INTERVAL 5                    // Seconds between AVRCP play position notifications
 
 #define CONFIG_I2S_LRCK_PIN G22
 #define CONFIG_I2S_BCK_PIN G19
 #define CONFIG_I2S_DATA_PIN G23
 
+// Audio path: A2DP data callback -> ring -> I2S task
+#define TARGET_LATENCY_MS 80   // Buffered audio the I2S task keeps
+#define FILL_TOLERANCE_MS 20   // Drift allowed around the target before correcting it
+#define CHUNK_FRAMES 128       // Frames per I2S write
+#define CORRECTION_INTERVAL 16 // Chunks between two one frame corrections (0.05 %)
+#define AUDIO_STATS_INTERVAL 5000
+
+// Task placement. The Bluetooth controller and Bluedroid are pinned to core 0
+// by the sdkconfig (CONFIG_BT_BLUEDROID_PINNED_TO_CORE). The A2DP data callback
+// is not called from the library's app task but from Bluedroid's A2DP sink
+// task ("BtA2dSinkT", configMAX_PRIORITIES - 3), right after the SBC decode,
+// so the audio path (data callback -> ring -> I2S) is on core 0 whatever
+// set_task_core() says. The control plane runs on core 1 with loop(): AVRCP
+// and connection callbacks (the app task, "BtAppTask"), status publishing,
+// LED, recovery. printTaskStats() reports where the data callback ran.
+#define AUDIO_CORE 0
+#define CONTROL_CORE 1
+#define I2S_TASK_PRIORITY (configMAX_PRIORITIES - 3) // The decoder's, below the controller
+#define A2DP_TASK_PRIORITY 4                         // App task running the AVRCP callbacks
+#define LED_TASK_PRIORITY 2                          // loop() is 1
+#define LED_ON_TIME 1000                             // ms a command colour stays on
+
 I2SStream i2s;
+I2SConfig i2sConfig;
 BluetoothA2DPSink a2dp_sink(i2s);
+AudioRing audioRing;
+volatile uint16_t sampleRate = 44100; // From the source, applied by the I2S task
+
+struct AudioStats
+{
+  uint32_t underruns;
+  uint32_t framesDropped;  // Fill control, the ring's own drops are overruns
+  uint32_t framesInserted; // Fill control
+  uint32_t minFill;
+  uint32_t maxFill;
+} audioStats;
+
 Adafruit_NeoPixel pixels = Adafruit_NeoPixel(1, G27, NEO_GRB + NEO_KHZ800);
-unsigned long last = 0;
+TaskHandle_t ledTaskHandle;
+
+// Text fields, the main board reads them one by one when their revision changes
+enum MetadataField
+{
+  FIELD_TITLE,
+  FIELD_ARTIST,
+  FIELD_ALBUM,
+  FIELD_PEER_NAME, // Can come after the connection, see updatePeerName()
+  FIELD_COUNT
+};
 
 // Add these global variables to store metadata
 struct MetadataStore
 {
-  String title;
-  String artist;
+  char fields[FIELD_COUNT][MAX_FIELD_LENGTH + 1];
+  uint8_t revisions[FIELD_COUNT]; // Bumped on each change of the field
+  uint16_t trackNumber;
+  uint16_t trackCount;
+  uint32_t duration;        // ms, 0 when unknown
+  uint32_t position;        // ms, at the last play position notification
+  uint8_t positionRevision; // Bumped on each notification, even with the same position
   unsigned long lastUpdate;
   esp_avrc_playback_stat_t playbackState;
   bool isConnected;
@@ -44,16 +100,229 @@ volatile uint8_t lastAudioState = 2;
 #define LOG_DEBUGF(x, ...)
 #endif
 
-// Add to global variables
-#define ESP_AVRC_RN_PLAY_POS_CHANGED 0x05
+volatile int8_t selectedField = -1; // Field sent by the next request, -1 for the status
+#if DEBUG_BT_AUDIO
+TaskHandle_t dataCallbackTask = nullptr;
+int dataCallbackCore = -1;
+#endif
+
+void audioDataReceived(const uint8_t *data, uint32_t length)
+{
+#if DEBUG_BT_AUDIO
+  if (!dataCallbackTask)
+  {
+    dataCallbackCore = xPortGetCoreID();
+    dataCallbackTask = xTaskGetCurrentTaskHandle();
+  }
+#endif
+  audioRing.write(data, length);
+}
+
+void sampleRateChanged(uint16_t rate)
+{
+  sampleRate = rate;
+}
+
+uint32_t msToFrames(uint32_t ms)
+{
+  return ms * sampleRate / 1000;
+}
+
+// Merges the last two frames of a chunk, each channel averaged
+uint32_t mergeFrames(uint32_t a, uint32_t b)
+{
+  int16_t left = ((int16_t)(a & 0xFFFF) + (int16_t)(b & 0xFFFF)) / 2;
+  int16_t right = ((int16_t)(a >> 16) + (int16_t)(b >> 16)) / 2;
+  return (uint16_t)left | ((uint32_t)(uint16_t)right << 16);
+}
+
+// Feeds I2S from the ring. It waits for the target latency before starting,
+// and again after an underrun. Source and I2S clocks drift apart: while the
+// smoothed fill is off the target, one frame every CORRECTION_INTERVAL chunks
+// is merged with the next one or repeated.
+void i2sTask(void *)
+{
+  static uint32_t chunk[CHUNK_FRAMES + 1];
+  bool buffering = true;
+  uint16_t appliedRate = i2sConfig.sample_rate;
+  float smoothedFill = 0;
+  uint32_t chunksSinceCorrection = 0;
+
+  for (;;)
+  {
+    if (needsRecovery || sampleRate != appliedRate)
+    {
+      LOG_DEBUGF("Restarting I2S at %u Hz\n", sampleRate);
+      appliedRate = sampleRate;
+      i2sConfig.sample_rate = appliedRate;
+      i2s.begin(i2sConfig);
+      audioRing.clear();
+      buffering = true;
+      if (needsRecovery)
+      {
+        esp_a2d_media_ctrl(ESP_A2D_MEDIA_CTRL_CHECK_SRC_RDY);
+        needsRecovery = false;
+      }
+    }
+
+    uint32_t fill = audioRing.fill();
+    uint32_t target = msToFrames(TARGET_LATENCY_MS);
+    if (buffering)
+    {
+      if (fill < target)
+      {
+        vTaskDelay(pdMS_TO_TICKS(5)); // I2S plays silence meanwhile (auto_clear)
+        continue;
+      }
+      buffering = false;
+      smoothedFill = fill;
+    }
+
+    smoothedFill += (fill - smoothedFill) / 32;
+    audioStats.minFill = min(audioStats.minFill, fill);
+    audioStats.maxFill = max(audioStats.maxFill, fill);
+
+    int correction = 0; // Extra frames read
+    if (++chunksSinceCorrection >= CORRECTION_INTERVAL)
+    {
+      uint32_t tolerance = msToFrames(FILL_TOLERANCE_MS);
+      if (smoothedFill > target + tolerance)
+      {
+        correction = 1;
+      }
+      else if (smoothedFill < target - tolerance)
+      {
+        correction = -1;
+      }
+    }
+
+    uint32_t wanted = CHUNK_FRAMES + correction;
+    uint32_t count = audioRing.read(chunk, wanted);
+    if (count < wanted)
+    {
+      // The end of a stream drains the ring too, only count a starved one
+      if (a2dp_sink.get_audio_state() == ESP_A2D_AUDIO_STATE_STARTED)
+      {
+        audioStats.underruns++;
+      }
+      i2s.write((uint8_t *)chunk, count * sizeof(uint32_t));
+      buffering = true;
+      continue;
+    }
+
+    if (correction > 0)
+    {
+      chunk[CHUNK_FRAMES - 1] = mergeFrames(chunk[CHUNK_FRAMES - 1], chunk[CHUNK_FRAMES]);
+      audioStats.framesDropped++;
+      chunksSinceCorrection = 0;
+    }
+    else if (correction < 0)
+    {
+      chunk[CHUNK_FRAMES - 1] = chunk[CHUNK_FRAMES - 2];
+      audioStats.framesInserted++;
+      chunksSinceCorrection = 0;
+    }
+    i2s.write((uint8_t *)chunk, CHUNK_FRAMES * sizeof(uint32_t)); // Blocks on the DMA buffers
+  }
+}
+
+void printAudioStats()
+{
+  Serial.printf("Audio: fill %lu ms (min %lu, max %lu), underruns %lu, overruns %lu (%lu frames), corrections -%lu +%lu\n",
+                audioRing.fill() * 1000 / sampleRate, audioStats.minFill * 1000 / sampleRate,
+                audioStats.maxFill * 1000 / sampleRate, audioStats.underruns, audioRing.getOverruns(),
+                audioRing.getDroppedFrames(), audioStats.framesDropped, audioStats.framesInserted);
+  audioStats.minFill = UINT32_MAX;
+  audioStats.maxFill = 0;
+}
+
+#if DEBUG_BT_AUDIO
+// CPU load per core, measured from its idle task: the time between two calls
+// of the idle hook is idle time, unless another task ran in between.
+#define IDLE_GAP_US 50
+struct CoreLoad
+{
+  volatile int64_t lastIdle;
+  volatile int64_t idleTime;
+} coreLoad[2];
+
+bool recordIdle(int core)
+{
+  int64_t now = esp_timer_get_time();
+  int64_t gap = now - coreLoad[core].lastIdle;
+  if (gap < IDLE_GAP_US)
+  {
+    coreLoad[core].idleTime += gap;
+  }
+  coreLoad[core].lastIdle = now;
+  return false; // No waiti, or the gaps would be a tick long
+}
+
+bool idleHookCore0() { return recordIdle(0); }
+bool idleHookCore1() { return recordIdle(1); }
+
+// Tasks not found (names vary with the core and library versions) are skipped
+const char *const WATCHED_TASKS[] = {"i2s", "led", "loopTask", "BtAppTask", "BtA2dSinkT", "BTC_TASK", "BTU_TASK", "btController", "i2c_slave_task_0"};
+
+void printTaskStats()
+{
+  static int64_t lastReport = 0;
+  int64_t now = esp_timer_get_time();
+  int64_t elapsed = now - lastReport;
+  lastReport = now;
+  Serial.print("CPU:");
+  for (int core = 0; core < 2; core++)
+  {
+    int64_t idle = coreLoad[core].idleTime;
+    coreLoad[core].idleTime = 0;
+    Serial.printf(" core %d %d %%", core, (int)(100 - min(idle, elapsed) * 100 / elapsed));
+  }
+  Serial.print(", free stack:");
+  for (const char *name : WATCHED_TASKS)
+  {
+    TaskHandle_t task = xTaskGetHandle(name);
+    if (task)
+    {
+      Serial.printf(" %s %u", name, uxTaskGetStackHighWaterMark(task));
+    }
+  }
+  Serial.printf(", min free heap %lu\n", (unsigned long)esp_get_minimum_free_heap_size());
+  if (dataCallbackTask)
+  {
+    Serial.printf("A2DP data callback: %s on core %d\n", pcTaskGetName(dataCallbackTask), dataCallbackCore);
+  }
+}
+#endif
+
+// The NeoPixel is bit-banged with interrupts masked, it is never shown from
+// the I2C callbacks: they hand the colour over to this task.
+void ledTask(void *)
+{
+  uint32_t color = 0;
+  for (;;)
+  {
+    // A colour goes back to off after LED_ON_TIME without a new one
+    if (xTaskNotifyWait(0, 0, &color, color ? pdMS_TO_TICKS(LED_ON_TIME) : portMAX_DELAY) != pdTRUE)
+    {
+      color = 0;
+    }
+    pixels.setPixelColor(0, color);
+    pixels.show();
+  }
+}
+
+void setLed(uint32_t color)
+{
+  xTaskNotify(ledTaskHandle, color, eSetValueWithOverwrite);
+}
 
 void i2cReceive(int numBytes)
 {
   static unsigned long lastCommandTime = 0;
   bool validCommand = false;
+  uint32_t color = 0; // Unchanged
 
   LOG_DEBUGF("I2C Receive called with %d bytes\n", numBytes);
-  pixels.setPixelColor(0, pixels.Color(0, 0, 255));
 
   if (numBytes < 1)
   {
@@ -64,11 +333,24 @@ void i2cReceive(int numBytes)
   i2cRegister = Wire.read();
   LOG_DEBUGF("Command received: '%c' (0x%02X)\n", i2cRegister, i2cRegister);
 
+  // Field selection for the next request, not a user command: no cooldown, no LED
+  if (i2cRegister == 'f')
+  {
+    int field = Wire.read();
+    selectedField = (field >= 0 && field < FIELD_COUNT) ? field : -1;
+    while (Wire.available())
+    {
+      Wire.read();
+    }
+    return;
+  }
+  color = pixels.Color(0, 0, 255);
+
   // Check cooldown
   if (millis() - lastCommandTime < COMMAND_COOLDOWN)
   {
     LOG_DEBUG("Command ignored - in cooldown period");
-    pixels.setPixelColor(0, pixels.Color(255, 165, 0));
+    color = pixels.Color(255, 165, 0);
     goto cleanup;
   }
 
@@ -76,12 +358,12 @@ void i2cReceive(int numBytes)
   switch (i2cRegister)
   {
   case 'p': // play
-    pixels.setPixelColor(0, pixels.Color(0, 255, 0));
+    color = pixels.Color(0, 255, 0);
     a2dp_sink.play();
     validCommand = true;
     break;
   case 's': // stop
-    pixels.setPixelColor(0, pixels.Color(255, 0, 0));
+    color = pixels.Color(255, 0, 0);
     a2dp_sink.pause();
     validCommand = true;
     break;
@@ -107,62 +389,136 @@ cleanup:
   {
     Wire.read();
   }
-  pixels.show();
+  if (color)
+  {
+    setLed(color);
+  }
+}
+
+// The responses are built by publishStatus() whenever what they show changes,
+// in one of two buffers. The request handler runs in the I2C slave callback,
+// it only writes from the published buffer: no formatting, no allocation.
+//
+// Status frame (BT_STATUS_LENGTH bytes, little endian):
+//   0     '#'
+//   1     'D' disconnected, 'S' stopped / paused, 'P' playing
+//   2-5   revision of each text field (MetadataField order)
+//   6     play position revision
+//   7     0
+//   8-11  play position at the last notification, ms
+//   12-15 track duration, ms, 0 when unknown
+//   16-17 track number, 18-19 number of tracks, 0 when unknown
+// Field frame (BT_FIELD_LENGTH bytes), after an 'f' + field index write:
+//   'F', field index, revision, then the text padded with zeros
+#define SNAPSHOT_LENGTH (BT_STATUS_LENGTH + FIELD_COUNT * BT_FIELD_LENGTH)
+struct StatusSnapshot
+{
+  uint8_t buffers[2][SNAPSHOT_LENGTH];
+  std::atomic<uint8_t> published{0};
+  std::atomic<uint8_t> reading{0}; // Buffer being sent + 1, 0 when idle
+} status;
+SemaphoreHandle_t publishMutex; // Callbacks and loop() both publish
+volatile bool publishPending = false; // Given up on a busy buffer, loop() publishes again
+#define PUBLISH_RETRIES 5             // Ticks to wait for the request handler
+
+void publishStatus()
+{
+  xSemaphoreTake(publishMutex, portMAX_DELAY);
+  uint8_t back = 1 - status.published.load();
+  // The request handler may still be sending the previous snapshot. It only
+  // copies a frame, block a tick at a time so it can run, even on this core
+  for (uint8_t tries = 0; status.reading.load() == back + 1; tries++)
+  {
+    if (tries == PUBLISH_RETRIES)
+    {
+      publishPending = true;
+      xSemaphoreGive(publishMutex);
+      return;
+    }
+    vTaskDelay(1);
+  }
+  publishPending = false;
+
+  uint8_t *frame = status.buffers[back];
+  memset(frame, 0, SNAPSHOT_LENGTH);
+  frame[0] = '#';
+  frame[1] = !metadata.isConnected ? 'D' : metadata.playbackState == ESP_AVRC_PLAYBACK_PLAYING ? 'P' : 'S';
+  memcpy(&frame[2], metadata.revisions, FIELD_COUNT);
+  frame[6] = metadata.positionRevision;
+  memcpy(&frame[8], &metadata.position, 4);
+  memcpy(&frame[12], &metadata.duration, 4);
+  memcpy(&frame[16], &metadata.trackNumber, 2);
+  memcpy(&frame[18], &metadata.trackCount, 2);
+
+  for (uint8_t field = 0; field < FIELD_COUNT; field++)
+  {
+    uint8_t *fieldFrame = &frame[BT_STATUS_LENGTH + field * BT_FIELD_LENGTH];
+    const char *text = metadata.fields[field];
+    if (!text[0] && (field == FIELD_TITLE || field == FIELD_ARTIST))
+    {
+      text = "-";
+    }
+    fieldFrame[0] = 'F';
+    fieldFrame[1] = field;
+    fieldFrame[2] = metadata.revisions[field];
+    strncpy((char *)&fieldFrame[3], text, MAX_FIELD_LENGTH);
+  }
+  status.published.store(back);
+  xSemaphoreGive(publishMutex);
 }
 
 void i2cRequest()
 {
   static unsigned long lastRequestTime = 0;
-  static uint16_t requestCount = 0;
-  const int MAX_FIELD_LENGTH = 32;
-  static char buffer[MAX_BT_DATA_LENGTH];
-
   unsigned long now = millis();
-  unsigned long delta = now - lastRequestTime;
-  LOG_DEBUGF("I2C Request at %lu (delta: %lu ms)\n", now, delta);
+  LOG_DEBUGF("I2C Request at %lu (delta: %lu ms)\n", now, now - lastRequestTime);
+  lastRequestTime = now;
 
-  if (delta > 1000)
-  {
-    LOG_DEBUG("Large timing gap detected!");
-    LOG_DEBUGF("Audio State: %d\n", a2dp_sink.get_audio_state());
-    LOG_DEBUGF("I2S Sample Rate: %d\n", a2dp_sink.sample_rate());
-    LOG_DEBUGF("Wire Available: %d\n", Wire.available());
-  }
-  LOG_DEBUGF("Attempting to write %d bytes\n", MAX_BT_DATA_LENGTH);
+  // A field selection only applies to the request that follows it
+  int8_t field = selectedField;
+  selectedField = -1;
 
-  // Build response string
-  String dataToSend = "";
+  // Claim the published buffer, publishStatus() won't overwrite it meanwhile.
+  // Sequentially consistent: each side stores its index then loads the other's
+  uint8_t index;
+  do
+  {
+    index = status.published.load();
+    status.reading.store(index + 1);
+  } while (status.published.load() != index);
 
-  if (!a2dp_sink.is_connected())
+  if (field >= 0)
   {
-    dataToSend += "|T-|A-|SUNKNOWN|Cdisconnected";
+    Wire.write(&status.buffers[index][BT_STATUS_LENGTH + field * BT_FIELD_LENGTH], BT_FIELD_LENGTH);
   }
   else
   {
-    const char *stateStr = (metadata.playbackState == ESP_AVRC_PLAYBACK_PLAYING) ? "PLAYING" : "STOPPED";
-
-    if (metadata.playbackState == ESP_AVRC_PLAYBACK_PLAYING)
-    {
-      dataToSend += "|T" + (metadata.title.length() ? metadata.title.substring(0, MAX_FIELD_LENGTH) : "-");
-      dataToSend += "|A" + (metadata.artist.length() ? metadata.artist.substring(0, MAX_FIELD_LENGTH) : "-");
-    }
-    else
-    {
-      dataToSend += "|T-|A-";
-    }
-
-    dataToSend += "|S" + String(stateStr);
-    dataToSend += "|C" + String(a2dp_sink.get_peer_name()).substring(0, MAX_FIELD_LENGTH);
+    Wire.write(status.buffers[index], BT_STATUS_LENGTH);
   }
+  status.reading.store(0);
 
-  // Copy to buffer with null termination
-  strncpy(buffer, dataToSend.c_str(), MAX_BT_DATA_LENGTH - 1);
-  buffer[MAX_BT_DATA_LENGTH - 1] = '\0';
+  LOG_DEBUGF("Sent %s\n", field >= 0 ? "field" : "status");
+}
 
-  Wire.write((uint8_t *)buffer, MAX_BT_DATA_LENGTH);
+// Returns true if the field changed
+bool setField(MetadataField field, const char *text)
+{
+  if (strncmp(metadata.fields[field], text, MAX_FIELD_LENGTH) == 0)
+  {
+    return false;
+  }
+  strlcpy(metadata.fields[field], text, sizeof(metadata.fields[field]));
+  metadata.revisions[field]++;
+  return true;
+}
 
-  LOG_DEBUGF("Write complete. Sent: %s\n", buffer);
-  lastRequestTime = now;
+void updatePeerName()
+{
+  const char *name = a2dp_sink.get_peer_name();
+  if (name && setField(FIELD_PEER_NAME, name))
+  {
+    publishStatus();
+  }
 }
 
 void avrc_metadata_callback(uint8_t id, const uint8_t *text)
@@ -170,19 +526,48 @@ void avrc_metadata_callback(uint8_t id, const uint8_t *text)
   switch (id)
   {
   case ESP_AVRC_MD_ATTR_TITLE:
-    metadata.title = String((char *)text);
+    setField(FIELD_TITLE, (const char *)text);
     break;
   case ESP_AVRC_MD_ATTR_ARTIST:
-    metadata.artist = String((char *)text);
+    setField(FIELD_ARTIST, (const char *)text);
+    break;
+  case ESP_AVRC_MD_ATTR_ALBUM:
+    setField(FIELD_ALBUM, (const char *)text);
+    break;
+  case ESP_AVRC_MD_ATTR_TRACK_NUM:
+    metadata.trackNumber = atoi((const char *)text);
+    break;
+  case ESP_AVRC_MD_ATTR_NUM_TRACKS:
+    metadata.trackCount = atoi((const char *)text);
+    break;
+  case ESP_AVRC_MD_ATTR_PLAYING_TIME:
+    metadata.duration = strtoul((const char *)text, nullptr, 10);
     break;
   }
   metadata.lastUpdate = millis();
+  publishStatus();
+}
+
+void avrc_rn_play_pos_callback(uint32_t position)
+{
+  metadata.position = position;
+  metadata.positionRevision++;
+  publishStatus();
+}
+
+void avrc_rn_track_change_callback(uint8_t *id)
+{
+  // The next position notification may only come PLAY_POS_INTERVAL later
+  metadata.position = 0;
+  metadata.positionRevision++;
+  publishStatus();
 }
 
 void avrc_rn_playstatus_callback(esp_avrc_playback_stat_t playback)
 {
   metadata.playbackState = playback;
   metadata.lastUpdate = millis();
+  publishStatus();
 
   if (playback == ESP_AVRC_PLAYBACK_STOPPED ||
       playback == ESP_AVRC_PLAYBACK_PAUSED)
@@ -192,7 +577,8 @@ void avrc_rn_playstatus_callback(esp_avrc_playback_stat_t playback)
     LOG_DEBUGF("A2DP Audio Type: %d\n", a2dp_sink.get_audio_type());
     LOG_DEBUGF("I2S Sample Rate: %d\n", a2dp_sink.sample_rate());
 
-    // Set up timer to monitor for BT stack state changes
+    // Set up timer to monitor for BT stack state changes. Its interrupt is
+    // allocated on the core running this callback, the control core.
     static hw_timer_t *timer = NULL;
     if (timer == NULL)
     {
@@ -227,15 +613,23 @@ void connection_state_changed(esp_a2d_connection_state_t state, void *ptr)
   // Clear all metadata on disconnect
   if (!metadata.isConnected)
   {
-    metadata.title = "";
-    metadata.artist = "";
+    for (uint8_t field = 0; field < FIELD_COUNT; field++)
+    {
+      setField((MetadataField)field, "");
+    }
+    metadata.trackNumber = 0;
+    metadata.trackCount = 0;
+    metadata.duration = 0;
+    metadata.position = 0;
     metadata.playbackState = ESP_AVRC_PLAYBACK_STOPPED;
   }
+  publishStatus();
 }
 
 void setup()
 {
-  auto cfg = i2s.defaultConfig();
+  auto &cfg = i2sConfig;
+  cfg = i2s.defaultConfig();
   cfg.pin_bck = CONFIG_I2S_BCK_PIN;
   cfg.pin_ws = CONFIG_I2S_LRCK_PIN;
   cfg.pin_data = CONFIG_I2S_DATA_PIN;
@@ -253,8 +647,8 @@ void setup()
   i2s.begin(cfg);
 
   pixels.begin();
-  pixels.setPixelColor(0, pixels.Color(255, 0, 0));
-  pixels.show();
+  xTaskCreatePinnedToCore(ledTask, "led", 2048, nullptr, LED_TASK_PRIORITY, &ledTaskHandle, CONTROL_CORE);
+  setLed(pixels.Color(255, 0, 0));
 
   Wire.setPins(G25, G21);
   Wire.begin(I2C_ADDRESS);
@@ -264,14 +658,19 @@ void setup()
 #if DEBUG_BT_AUDIO
   Serial.begin(115200);
   Serial.println("Jackal bt");
+  esp_register_freertos_idle_hook_for_cpu(idleHookCore0, 0);
+  esp_register_freertos_idle_hook_for_cpu(idleHookCore1, 1);
 #endif
 
-  pixels.setPixelColor(0, pixels.Color(255, 255, 0));
-  pixels.show();
-  last = millis();
+  setLed(pixels.Color(255, 255, 0));
 
-  a2dp_sink.set_avrc_metadata_attribute_mask(ESP_AVRC_MD_ATTR_TITLE | ESP_AVRC_MD_ATTR_ARTIST);
+  a2dp_sink.set_avrc_metadata_attribute_mask(ESP_AVRC_MD_ATTR_TITLE | ESP_AVRC_MD_ATTR_ARTIST | ESP_AVRC_MD_ATTR_ALBUM |
+                                             ESP_AVRC_MD_ATTR_TRACK_NUM | ESP_AVRC_MD_ATTR_NUM_TRACKS |
+                                             ESP_AVRC_MD_ATTR_PLAYING_TIME);
   a2dp_sink.set_avrc_metadata_callback(avrc_metadata_callback);
+  // The main board interpolates the position between two notifications
+  a2dp_sink.set_avrc_rn_play_pos_callback(avrc_rn_play_pos_callback, PLAY_POS_INTERVAL);
+  a2dp_sink.set_avrc_rn_track_change_callback(avrc_rn_track_change_callback);
   // a2dp_sink.set_auto_reconnect(true);
 
   // Register the playback state callback
@@ -282,30 +681,45 @@ void setup()
 
   // Initialize connection state
   metadata.isConnected = false;
+  publishMutex = xSemaphoreCreateMutex();
+  publishStatus();
 
   // Register the connection state callback
   a2dp_sink.set_on_connection_state_changed(connection_state_changed);
 
+  // The sink only fills the ring, the I2S task plays it
+  audioStats.minFill = UINT32_MAX;
+  a2dp_sink.set_stream_reader(audioDataReceived, false);
+  a2dp_sink.set_sample_rate_callback(sampleRateChanged);
+  xTaskCreatePinnedToCore(i2sTask, "i2s", 4096, nullptr, I2S_TASK_PRIORITY, nullptr, AUDIO_CORE);
+
+  a2dp_sink.set_task_core(CONTROL_CORE);
+  a2dp_sink.set_task_priority(A2DP_TASK_PRIORITY);
   a2dp_sink.start("Jackal");
 }
 
 void loop()
 {
-  // Perform recovery if BT stack state change was detected
-  if (needsRecovery)
+  // Recovery after a BT stack state change (needsRecovery) is done by the
+  // I2S task, which owns the I2S stream
+
+#if DEBUG_BT_AUDIO
+  static unsigned long lastStats = 0;
+  if (millis() - lastStats > AUDIO_STATS_INTERVAL)
   {
-    LOG_DEBUG("Attempting recovery");
-    i2s.begin();
-    esp_a2d_media_ctrl(ESP_A2D_MEDIA_CTRL_CHECK_SRC_RDY);
-    needsRecovery = false;
+    lastStats = millis();
+    printAudioStats();
+    printTaskStats();
   }
+#endif
 
-  // LED handling
-  if (last != 0 && (millis() - last) > 1000)
+  if (metadata.isConnected)
   {
-    last = millis();
-    pixels.setPixelColor(0, pixels.Color(0, 0, 0));
-    pixels.show();
+    updatePeerName();
+  }
+  if (publishPending)
+  {
+    publishStatus();
   }
   delay(10);
 }
@@ -0,0 +1,109 @@
+// Non-blocking PN532 tag detection
+#include "NfcPoller.h"
+
+#define PN532_HOST_TO_PN532 0xD4
+#define PN532_PN532_TO_HOST 0xD5
+#define PN532_INLISTPASSIVETARGET 0x4A
+
+void NfcPoller::start() {
+  // Drop anything left from an aborted poll
+  while (serial_.available()) {
+    serial_.read();
+  }
+
+  // Normal information frame: 00 00 FF LEN LCS D4 4A 01 00 DCS 00
+  const uint8_t data[] = {PN532_HOST_TO_PN532, PN532_INLISTPASSIVETARGET, 0x01, 0x00}; // 1 target, 106 kbps type A
+  uint8_t sum = 0;
+  serial_.write((uint8_t)0x00);
+  serial_.write((uint8_t)0x00);
+  serial_.write((uint8_t)0xFF);
+  serial_.write((uint8_t)sizeof(data));
+  serial_.write((uint8_t)(~sizeof(data) + 1));
+  for (uint8_t b : data) {
+    serial_.write(b);
+    sum += b;
+  }
+  serial_.write((uint8_t)(~sum + 1));
+  serial_.write((uint8_t)0x00);
+
+  state_ = START_CODE;
+  previous_ = 0xFF;
+  sentAt_ = millis();
+  busy_ = true;
+}
+
+NfcPoller::Result NfcPoller::update() {
+  if (!busy_) {
+    return FAILED;
+  }
+  while (serial_.available()) {
+    Result result = parse_(serial_.read());
+    if (result != PENDING) {
+      return finish_(result);
+    }
+  }
+  if (millis() - sentAt_ > NFC_RESPONSE_TIMEOUT) {
+    return finish_(FAILED);
+  }
+  return PENDING;
+}
+
+NfcPoller::Result NfcPoller::finish_(Result result) {
+  if (result == FAILED) {
+    // An ACK frame from the host aborts the command, if the PN532 is still on it
+    const uint8_t ack[] = {0x00, 0x00, 0xFF, 0x00, 0xFF, 0x00};
+    serial_.write(ack, sizeof(ack));
+  }
+  busy_ = false;
+  return result;
+}
+
+NfcPoller::Result NfcPoller::parse_(uint8_t b) {
+  switch (state_) {
+  case START_CODE:
+    if (previous_ == 0x00 && b == 0xFF) {
+      state_ = LENGTH;
+    }
+    previous_ = b;
+    break;
+  case LENGTH:
+    length_ = b;
+    state_ = LENGTH_CHECKSUM;
+    break;
+  case LENGTH_CHECKSUM:
+    previous_ = b;
+    if (length_ == 0 && b == 0xFF) {
+      state_ = START_CODE; // The ACK of the command, the response follows
+    } else if ((uint8_t)(length_ + b) != 0 || length_ == 0 || length_ > NFC_FRAME_MAX_LENGTH) {
+      return FAILED;
+    } else {
+      received_ = 0;
+      sum_ = 0;
+      state_ = DATA;
+    }
+    break;
+  case DATA:
+    frame_[received_++] = b;
+    sum_ += b;
+    if (received_ == length_) {
+      state_ = DATA_CHECKSUM;
+    }
+    break;
+  case DATA_CHECKSUM:
+    state_ = START_CODE;
+    previous_ = b;
+    if ((uint8_t)(sum_ + b) != 0 || length_ < 3 || frame_[0] != PN532_PN532_TO_HOST ||
+        frame_[1] != PN532_INLISTPASSIVETARGET + 1) {
+      return FAILED; // Includes the error frame (7F) answering a bad command
+    }
+    // D5 4B NbTg [Tg SENS_RES(2) SEL_RES NFCIDLength NFCID...]
+    if (frame_[2] == 0) {
+      return NO_TAG;
+    }
+    if (length_ < 8 || frame_[7] == 0 || 8 + frame_[7] > length_) {
+      return FAILED;
+    }
+    return TAG;
+  }
+  return PENDING;
+}
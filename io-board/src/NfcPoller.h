@@ -0,0 +1,54 @@
+#pragma once
+
+#include <Arduino.h>
+#include <SoftwareSerial.h>
+
+#define NFC_RESPONSE_TIMEOUT 50 // ms, a poll takes ~10 ms with the activation retries set in initNFC()
+#define NFC_FRAME_MAX_LENGTH 32 // InListPassiveTarget response with a 7 byte UID and a short ATS
+
+// InListPassiveTarget (one ISO14443A target) over the PN532 HSU link, split
+// in two so the loop never waits for the reader: start() sends the command,
+// update() parses the ACK and the response from the bytes already received.
+class NfcPoller
+{
+  public:
+    enum Result
+    {
+      PENDING, // Nothing yet, call update() again
+      TAG,     // uid() and uidLength() are valid
+      NO_TAG,
+      FAILED   // Bad frame or no response within NFC_RESPONSE_TIMEOUT
+    };
+
+    NfcPoller(SoftwareSerial &serial) : serial_(serial) {}
+
+    void start();
+    Result update();
+    bool isBusy() const { return busy_; }
+
+    const uint8_t *uid() const { return &frame_[8]; }
+    uint8_t uidLength() const { return frame_[7]; }
+
+  private:
+    enum State
+    {
+      START_CODE,
+      LENGTH,
+      LENGTH_CHECKSUM,
+      DATA,
+      DATA_CHECKSUM
+    };
+
+    SoftwareSerial &serial_;
+    bool busy_ = false;
+    unsigned long sentAt_ = 0;
+    State state_ = START_CODE;
+    uint8_t previous_ = 0xFF;
+    uint8_t length_ = 0;
+    uint8_t received_ = 0;
+    uint8_t sum_ = 0;
+    uint8_t frame_[NFC_FRAME_MAX_LENGTH];
+
+    Result parse_(uint8_t b);
+    Result finish_(Result result);
+};
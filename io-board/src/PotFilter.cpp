@@ -0,0 +1,42 @@
+// Adaptive pot smoothing
+#include "PotFilter.h"
+#include <stdlib.h>
+
+PotFilter::PotFilter(uint16_t maxInput) : maxInput_(maxInput) {}
+
+bool PotFilter::update(uint16_t reading) {
+  int16_t target = (reading < maxInput_ ? reading : maxInput_) << 4;
+  if (filtered_ < 0) {
+    filtered_ = target;
+  } else {
+    int16_t delta = target - filtered_;
+    uint32_t distance = abs(delta);
+    // Quadratic in the distance: the noise of a still pot stays well below
+    // POT_FAST_DISTANCE and is strongly averaged
+    uint16_t alpha = 256;
+    if (distance < POT_FAST_DISTANCE) {
+      alpha = POT_ALPHA_MIN + distance * distance * (256 - POT_ALPHA_MIN) / ((uint32_t)POT_FAST_DISTANCE * POT_FAST_DISTANCE);
+    }
+    filtered_ += (int32_t)delta * alpha / 256;
+  }
+
+  // Output in 1/16 step
+  int16_t position = (uint32_t)filtered_ * 255 / maxInput_;
+  uint8_t output;
+  if (position < POT_DEAD_BAND) {
+    output = 0;
+  } else if (position > 255 * 16 - POT_DEAD_BAND) {
+    output = 255;
+  } else {
+    if (abs(position - output_ * 16) < 8 + POT_HYSTERESIS) {
+      return false;
+    }
+    output = (position + 8) >> 4;
+  }
+
+  if (output == output_) {
+    return false;
+  }
+  output_ = output;
+  return true;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <stdint.h>
+
+#define POT_ALPHA_MIN 8        // Smoothing of a still pot, in 1/256 (time constant of 32 samples)
+#define POT_FAST_DISTANCE 192  // Distance to the reading, in 1/16 counts, from which the filter follows it
+#define POT_HYSTERESIS 4       // Past the middle between two output steps, in 1/16 step
+#define POT_DEAD_BAND 24       // At both ends of the range, in 1/16 step
+
+// Smooths a pot reading into a stable 0-255 value.
+// The smoothing adapts to how far the reading is from the filtered value: a
+// still pot only sees its ADC noise and gets a slow average, a pot being
+// turned is followed within a sample or two. Hysteresis keeps the output from
+// toggling between two steps, and dead-bands pin the ends to 0 and 255.
+class PotFilter
+{
+  public:
+    // Readings above maxInput map to 255
+    PotFilter(uint16_t maxInput);
+
+    // Returns true when the output changed
+    bool update(uint16_t reading);
+    uint8_t value() const { return output_; }
+
+  private:
+    uint16_t maxInput_;
+    int16_t filtered_ = -1; // In 1/16 counts, -1 before the first reading
+    uint8_t output_ = 0;
+};
@@ -1,10 +1,11 @@
 #include <Arduino.h>
 #include <Wire.h>
-#include <movingAvg.h>
 #include <Bounce2.h>
 #include <SoftwareSerial.h>
 #include <PN532_SWHSU.h>
 #include <PN532.h>
+#include "PotFilter.h"
+#include "NfcPoller.h"
 
 // Disabling FM capacitor for now, it's not working great
 // and it creates a lot of noise.
@@ -35,11 +36,18 @@ Bounce2::Button orangeBtn = Bounce2::Button();
 Bounce2::Button bandSelectBtn = Bounce2::Button();
 Bounce2::Button inputSelectBtn = Bounce2::Button();
 
-// Moving Average Filters for Pots
-movingAvg volPot(20); // 20-sample moving average
-movingAvg tonePot(20);
-movingAvg tvPot(40);
-movingAvg brightnessPot(20);
+// Pot filters, with the reading of each pot's end stop
+PotFilter volPot(870);
+PotFilter tonePot(870);
+PotFilter tvPot(810);
+PotFilter brightnessPot(870);
+
+// Bits 3-6 of the button byte: pot value changed since the last request
+#define VOLUME_CHANGED (1 << 3)
+#define TONE_CHANGED (1 << 4)
+#define TUNING_CHANGED (1 << 5)
+#define BRIGHTNESS_CHANGED (1 << 6)
+volatile byte potsChanged = 0;
 
 // Control Button States
 enum ControlValue
@@ -63,18 +71,28 @@ volatile byte i2cRegister = 0xff;
 bool commandWasSent = true; // Start true so we don't send NONE initially
 SoftwareSerial nfcSerial(PN532_RX, PN532_TX);
 PN532_SWHSU pn532swhsu(nfcSerial);
-PN532 nfc(pn532swhsu);
+PN532 nfc(pn532swhsu); // Init only, the polls go through nfcPoller
+NfcPoller nfcPoller(nfcSerial);
 uint64_t lastNfcId = 0;
 uint8_t lastUidLength = 0;
 bool nfcInitialized = false;
+uint8_t nfcMisses = 0;   // Polls without the current tag
+uint8_t nfcFailures = 0; // Consecutive polls without a valid response
 
 // Delay between analog reads
 unsigned long lastPotRead = 0;
-const unsigned long POT_READ_INTERVAL = 20; // 20ms interval
+const unsigned long POT_READ_INTERVAL = 5; // 5ms interval
+unsigned long lastControlRead = 0;
+const unsigned long CONTROL_READ_INTERVAL = 20; // 20ms interval, lets the button ladder settle
 
-// Delay between NFC checks
+// Delay between NFC polls, shorter while a tag is present to notice its removal
 unsigned long lastNfcCheck = 0;
-const unsigned long NFC_CHECK_INTERVAL = 1000; // Check every 1000ms
+const unsigned long NFC_IDLE_INTERVAL = 250;
+const unsigned long NFC_PRESENT_INTERVAL = 100;
+const unsigned long NFC_INIT_INTERVAL = 1000; // Retry while the PN532 isn't found
+const uint8_t NFC_REMOVAL_MISSES = 3;         // Polls without the tag before it counts as removed
+const uint8_t NFC_MAX_FAILURES = 5;           // Failed polls in a row before the PN532 is initialized again
+const uint8_t NFC_ACTIVATION_RETRIES = 2;     // Bounds a poll without a tag to ~10ms (default: retry forever)
 
 void i2cReceive(int bytesReceived)
 {
@@ -94,24 +112,28 @@ void i2cReceive(int bytesReceived)
   }
 }
 
+#ifdef ENABLE_FM_CAPACITOR
 // Helper function to send mapped pot value
 static auto sendMappedValue = [](uint16_t value, uint16_t maxInput)
 {
   Wire.write(lowByte(map(min(value, maxInput), 0, maxInput, 0, 255)));
 };
+#endif
 
 void i2cRequest()
 {
   // Pack button states into a single byte
   byte pressedStates = (orangeBtn.isPressed() << 0) |
                        (bandSelectBtn.isPressed() << 1) |
-                       (inputSelectBtn.isPressed() << 2);
+                       (inputSelectBtn.isPressed() << 2) |
+                       potsChanged;
+  potsChanged = 0;
 
   Wire.write(pressedStates);
-  sendMappedValue(volPot.getAvg(), 870);
-  sendMappedValue(tonePot.getAvg(), 870);
-  sendMappedValue(tvPot.getAvg(), 810);
-  sendMappedValue(brightnessPot.getAvg(), 870);
+  Wire.write(volPot.value());
+  Wire.write(tonePot.value());
+  Wire.write(tvPot.value());
+  Wire.write(brightnessPot.value());
 #ifdef ENABLE_FM_CAPACITOR
   sendMappedValue(cap.readFMValue(), 1023);
 #else
@@ -173,6 +195,7 @@ void initNFC()
   else
   {
     nfc.SAMConfig();
+    nfc.setPassiveActivationRetries(NFC_ACTIVATION_RETRIES);
     nfcInitialized = true;
 #ifdef DEBUG
     Serial.println("NFC Ready");
@@ -207,12 +230,6 @@ void setup()
   inputSelectBtn.attach(PIN_INPUT_SELECT, INPUT_PULLUP);
   inputSelectBtn.setPressedState(LOW);
 
-  // Initialize moving averages
-  volPot.begin();
-  tonePot.begin();
-  tvPot.begin();
-  brightnessPot.begin();
-
   // Configure additional inputs
   pinMode(PIN_CONTROLS, INPUT);
   // pinMode(PIN_INPUT_SELECT, INPUT_PULLUP);
@@ -265,26 +282,50 @@ void readControlBtn()
   }
 }
 
+void setNfcId(uint64_t id)
+{
+  // Read by i2cRequest(), the 8 bytes aren't written atomically
+  noInterrupts();
+  lastNfcId = id;
+  interrupts();
+}
+
 void checkNFC()
 {
+  unsigned long currentMillis = millis();
   if (!nfcInitialized)
   {
+    if (currentMillis - lastNfcCheck >= NFC_INIT_INTERVAL)
+    {
+      lastNfcCheck = currentMillis;
 #ifdef DEBUG
-    Serial.println("NFC not initialized, initializing...");
+      Serial.println("NFC not initialized, initializing...");
 #endif
-    initNFC();
+      initNFC();
+    }
     return;
   }
 
-  uint8_t success;
-  uint8_t uid[] = {0, 0, 0, 0, 0, 0, 0};
-  uint8_t uidLength;
+  if (!nfcPoller.isBusy())
+  {
+    if (currentMillis - lastNfcCheck >= (lastNfcId ? NFC_PRESENT_INTERVAL : NFC_IDLE_INTERVAL))
+    {
+      lastNfcCheck = currentMillis;
+      nfcPoller.start();
+    }
+    return;
+  }
 
-  success = nfc.readPassiveTargetID(PN532_MIFARE_ISO14443A, uid, &uidLength, 90);
-  lastNfcId = 0; // Clear before setting, in case of failure we'll send 0x0000000000000000
+  NfcPoller::Result result = nfcPoller.update();
+  if (result == NfcPoller::PENDING)
+  {
+    return;
+  }
 
-  if (success)
+  if (result == NfcPoller::TAG)
   {
+    const uint8_t *uid = nfcPoller.uid();
+    uint8_t uidLength = nfcPoller.uidLength();
 #ifdef DEBUG
     Serial.print("Found tag! Raw bytes: ");
     for (uint8_t i = 0; i < uidLength; i++)
@@ -297,29 +338,56 @@ void checkNFC()
     Serial.println();
 #endif
     // Store the UID length and full ID
+    uint64_t id = 0;
     lastUidLength = uidLength;
     for (uint8_t i = 0; i < uidLength && i < 7; i++)
     {
-      lastNfcId = (lastNfcId << 8) | uid[i];
+      id = (id << 8) | uid[i];
     }
 
     // Left-align the UID in the 56-bit field (7 bytes)
     if (uidLength < 7)
     {
-      lastNfcId <<= (7 - uidLength) * 8;
+      id <<= (7 - uidLength) * 8;
     }
+    setNfcId(id);
+    nfcMisses = 0;
+    nfcFailures = 0;
 
 #ifdef DEBUG
     Serial.print("Packed lastNfcId: 0x");
     for (int i = 6; i >= 0; i--)
     {
-      uint8_t byte = (lastNfcId >> (i * 8)) & 0xFF;
+      uint8_t byte = (id >> (i * 8)) & 0xFF;
       if (byte < 0x10)
         Serial.print("0");
       Serial.print(byte, HEX);
     }
     Serial.println();
 #endif
+    return;
+  }
+
+  if (result == NfcPoller::NO_TAG)
+  {
+    nfcFailures = 0;
+  }
+  else if (++nfcFailures >= NFC_MAX_FAILURES)
+  {
+#ifdef DEBUG
+    Serial.println("NFC not responding, initializing again");
+#endif
+    nfcFailures = 0;
+    nfcInitialized = false;
+    setNfcId(0);
+    return;
+  }
+
+  // A single miss is often a bad read of a tag still there
+  if (lastNfcId && ++nfcMisses >= NFC_REMOVAL_MISSES)
+  {
+    nfcMisses = 0;
+    setNfcId(0);
   }
 }
 
@@ -346,17 +414,17 @@ void loop()
 
     // Add pot values to debug output
     Serial.print(" | Pots - Vol: ");
-    Serial.print(volPot.getAvg());
+    Serial.print(volPot.value());
     Serial.print(" Tone: ");
-    Serial.print(tonePot.getAvg());
+    Serial.print(tonePot.value());
     Serial.print(" TV: ");
-    Serial.print(tvPot.getAvg());
+    Serial.print(tvPot.value());
 #ifdef ENABLE_FM_CAPACITOR
     Serial.print(" FM: ");
     Serial.print(cap.readFMValue());
 #endif
     Serial.print(" Brightness: ");
-    Serial.println(brightnessPot.getAvg());
+    Serial.println(brightnessPot.value());
     debugCounter = 0;
   }
 #endif
@@ -364,16 +432,26 @@ void loop()
   unsigned long currentMillis = millis();
   if (currentMillis - lastPotRead >= POT_READ_INTERVAL) {
     lastPotRead = currentMillis;
-    
-    volPot.reading(analogRead(PIN_VOLUME_POT));
-    tvPot.reading(analogRead(PIN_TVTUNE_POT));
-    tonePot.reading(analogRead(PIN_TONE_POT));
-    brightnessPot.reading(analogRead(PIN_BRIGHTNESS_POT));
-    readControlBtn();
+
+    byte changed = 0;
+    if (volPot.update(analogRead(PIN_VOLUME_POT)))
+      changed |= VOLUME_CHANGED;
+    if (tvPot.update(analogRead(PIN_TVTUNE_POT)))
+      changed |= TUNING_CHANGED;
+    if (tonePot.update(analogRead(PIN_TONE_POT)))
+      changed |= TONE_CHANGED;
+    if (brightnessPot.update(analogRead(PIN_BRIGHTNESS_POT)))
+      changed |= BRIGHTNESS_CHANGED;
+    // i2cRequest() clears the flags
+    noInterrupts();
+    potsChanged |= changed;
+    interrupts();
   }
 
-  if (currentMillis - lastNfcCheck >= NFC_CHECK_INTERVAL) {
-    lastNfcCheck = currentMillis;
-    checkNFC();
+  if (currentMillis - lastControlRead >= CONTROL_READ_INTERVAL) {
+    lastControlRead = currentMillis;
+    readControlBtn();
   }
+
+  checkNFC();
 }
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <stdint.h>
+
+// The volume pot (end stop at 870 counts) as analogRead() returns it every
+// POT_READ_INTERVAL (5 ms), with the 1-2 counts of noise of the Nano's ADC
+
+// Volume pot left alone at about 45%, 2 s
+static const uint16_t STILL_TRACE[] = {
+  400, 401, 400, 400, 399, 400, 402, 401, 402, 401, 401, 401, 398, 402, 401, 401,
+  398, 398, 399, 400, 401, 400, 401, 399, 401, 401, 399, 403, 401, 402, 399, 399,
+  400, 400, 401, 401, 400, 399, 400, 402, 399, 401, 401, 398, 400, 402, 397, 400,
+  400, 399, 401, 400, 398, 402, 401, 402, 402, 401, 400, 398, 401, 399, 400, 398,
+  399, 400, 402, 397, 398, 401, 402, 401, 397, 397, 401, 399, 399, 402, 402, 401,
+  401, 401, 403, 401, 401, 401, 398, 402, 402, 401, 397, 399, 402, 398, 400, 402,
+  398, 403, 401, 400, 401, 401, 400, 402, 399, 400, 402, 400, 399, 402, 402, 400,
+  398, 400, 400, 400, 402, 399, 402, 398, 399, 401, 402, 402, 401, 401, 401, 401,
+  400, 401, 401, 400, 401, 401, 403, 401, 400, 400, 400, 402, 400, 401, 403, 396,
+  399, 401, 401, 401, 400, 401, 401, 400, 404, 401, 399, 400, 400, 400, 396, 400,
+  402, 399, 400, 402, 402, 403, 398, 400, 400, 401, 402, 396, 402, 398, 401, 398,
+  401, 402, 400, 401, 401, 401, 400, 403, 402, 400, 404, 399, 402, 400, 400, 401,
+  401, 401, 398, 398, 401, 399, 399, 398, 402, 401, 403, 399, 400, 399, 401, 403,
+  399, 403, 402, 400, 397, 402, 400, 399, 401, 401, 403, 399, 402, 403, 402, 400,
+  399, 402, 400, 400, 402, 400, 397, 400, 398, 402, 401, 399, 400, 402, 400, 402,
+  400, 402, 403, 403, 399, 402, 397, 399, 397, 402, 398, 400, 400, 400, 399, 401,
+  403, 400, 401, 402, 400, 398, 399, 402, 398, 399, 402, 401, 400, 402, 401, 399,
+  398, 399, 402, 399, 399, 399, 398, 400, 399, 401, 397, 401, 399, 397, 401, 400,
+  397, 399, 401, 400, 401, 401, 401, 401, 402, 401, 401, 397, 402, 402, 400, 400,
+  403, 398, 401, 404, 399, 401, 403, 400, 401, 402, 399, 400, 401, 402, 400, 400,
+  399, 400, 402, 400, 399, 399, 404, 402, 401, 396, 401, 401, 403, 401, 400, 401,
+  397, 402, 401, 399, 402, 403, 398, 399, 401, 401, 400, 399, 403, 402, 399, 398,
+  403, 402, 403, 402, 399, 401, 397, 399, 400, 401, 399, 400, 401, 401, 401, 401,
+  400, 401, 400, 399, 399, 400, 400, 401, 400, 401, 400, 398, 401, 402, 401, 400,
+  401, 399, 397, 400, 399, 401, 399, 396, 399, 403, 400, 398, 399, 401, 401, 401,
+};
+
+// Volume pot snapped from 300 to 600 counts, 0.5 s each side
+static const uint16_t STEP_TRACE[] = {
+  303, 301, 300, 301, 303, 302, 302, 299, 300, 301, 300, 302, 301, 302, 300, 304,
+  302, 300, 301, 304, 300, 302, 302, 300, 299, 301, 301, 302, 302, 300, 302, 301,
+  301, 300, 300, 301, 299, 299, 300, 298, 300, 297, 299, 301, 301, 300, 300, 298,
+  303, 301, 302, 299, 300, 298, 302, 302, 298, 300, 301, 298, 298, 299, 299, 298,
+  300, 301, 301, 301, 303, 302, 298, 300, 299, 299, 300, 300, 301, 298, 299, 300,
+  300, 300, 300, 299, 301, 301, 300, 299, 300, 296, 299, 300, 298, 301, 301, 298,
+  300, 300, 301, 301, 600, 599, 600, 600, 601, 601, 599, 598, 600, 599, 599, 600,
+  600, 600, 601, 600, 604, 600, 602, 600, 602, 597, 599, 601, 601, 604, 601, 602,
+  601, 602, 601, 600, 601, 599, 602, 599, 601, 603, 600, 600, 602, 600, 599, 601,
+  601, 601, 599, 603, 603, 600, 601, 600, 602, 599, 601, 600, 599, 601, 602, 600,
+  599, 602, 600, 601, 603, 602, 600, 604, 600, 601, 599, 600, 598, 603, 602, 598,
+  598, 598, 602, 600, 600, 600, 600, 599, 600, 598, 600, 601, 601, 600, 599, 601,
+  600, 603, 601, 600, 600, 599, 599, 600,
+};
+
+// Volume pot turned from its low to its high end stop over 3 s, then left there
+static const uint16_t SLOW_TURN_TRACE[] = {
+  0, 2, 4, 7, 5, 7, 13, 7, 11, 13, 15, 17, 17, 19, 20, 23,
+  20, 23, 26, 26, 27, 31, 31, 34, 36, 37, 38, 39, 38, 42, 44, 44,
+  46, 49, 48, 52, 55, 53, 55, 56, 60, 60, 62, 61, 64, 65, 64, 70,
+  71, 68, 74, 74, 76, 77, 76, 79, 83, 82, 83, 84, 85, 89, 92, 92,
+  93, 98, 95, 96, 99, 101, 100, 101, 105, 106, 105, 108, 109, 112, 113, 114,
+  115, 119, 121, 120, 123, 122, 125, 127, 130, 128, 130, 132, 131, 135, 135, 138,
+  138, 138, 142, 144, 144, 148, 147, 148, 152, 150, 153, 155, 158, 158, 160, 160,
+  163, 166, 164, 170, 167, 170, 171, 174, 172, 172, 178, 180, 181, 185, 183, 185,
+  187, 188, 191, 188, 191, 188, 196, 195, 199, 202, 200, 201, 202, 203, 205, 208,
+  209, 210, 211, 215, 215, 216, 218, 219, 219, 224, 224, 223, 228, 228, 227, 233,
+  233, 235, 235, 236, 235, 241, 241, 242, 244, 245, 248, 247, 249, 248, 252, 255,
+  257, 256, 258, 262, 261, 264, 266, 265, 269, 267, 270, 271, 273, 276, 279, 276,
+  278, 281, 280, 283, 285, 285, 288, 286, 291, 289, 292, 294, 295, 299, 299, 300,
+  302, 305, 305, 306, 309, 309, 308, 315, 317, 312, 316, 318, 320, 321, 321, 322,
+  325, 328, 326, 328, 331, 329, 333, 334, 337, 337, 338, 340, 342, 343, 345, 348,
+  350, 352, 350, 352, 350, 358, 356, 358, 360, 359, 363, 364, 363, 367, 370, 367,
+  372, 373, 375, 376, 379, 378, 381, 381, 384, 383, 386, 390, 389, 390, 390, 392,
+  395, 397, 398, 400, 400, 404, 403, 404, 407, 408, 408, 409, 411, 414, 415, 414,
+  418, 419, 419, 423, 423, 424, 427, 430, 428, 431, 431, 437, 434, 438, 437, 441,
+  444, 438, 443, 446, 446, 447, 453, 451, 450, 455, 453, 458, 457, 460, 463, 463,
+  462, 463, 469, 469, 469, 473, 473, 475, 472, 477, 480, 481, 483, 479, 485, 486,
+  491, 487, 490, 492, 494, 494, 498, 496, 499, 499, 502, 502, 502, 508, 508, 508,
+  511, 513, 512, 515, 517, 518, 519, 517, 524, 524, 525, 526, 528, 529, 529, 531,
+  533, 534, 535, 539, 537, 542, 541, 544, 547, 547, 547, 550, 551, 550, 553, 556,
+  556, 558, 561, 562, 564, 565, 565, 567, 568, 569, 571, 570, 574, 576, 576, 579,
+  581, 581, 586, 580, 585, 585, 590, 594, 588, 593, 595, 595, 598, 595, 602, 602,
+  603, 604, 607, 607, 609, 610, 609, 613, 615, 617, 616, 619, 622, 622, 625, 628,
+  625, 625, 631, 633, 634, 635, 634, 635, 639, 638, 638, 641, 648, 648, 646, 647,
+  650, 650, 654, 654, 654, 659, 657, 660, 661, 662, 665, 665, 664, 665, 668, 670,
+  673, 674, 677, 677, 677, 679, 678, 683, 685, 687, 687, 688, 692, 692, 694, 695,
+  696, 699, 698, 700, 701, 702, 707, 709, 708, 710, 712, 713, 715, 713, 715, 718,
+  721, 721, 721, 723, 724, 725, 730, 728, 731, 735, 735, 736, 736, 739, 742, 742,
+  744, 744, 746, 746, 749, 752, 749, 752, 754, 755, 756, 760, 763, 762, 763, 762,
+  768, 767, 768, 768, 771, 771, 774, 776, 777, 779, 779, 784, 782, 782, 786, 786,
+  787, 790, 792, 791, 794, 798, 799, 799, 801, 802, 803, 806, 806, 804, 809, 809,
+  813, 813, 815, 820, 816, 818, 819, 819, 821, 826, 826, 825, 827, 832, 831, 833,
+  836, 839, 841, 841, 841, 843, 847, 847, 846, 849, 850, 851, 852, 852, 855, 855,
+  860, 861, 859, 865, 866, 863, 870, 870, 873, 868, 871, 871, 870, 870, 872, 868,
+  868, 868, 869, 869, 871, 870, 870, 869, 869, 871, 871, 870, 870, 872, 869, 871,
+  872, 870, 871, 868, 872, 870, 868, 871, 869, 872, 869, 870, 870, 870, 870, 869,
+  871, 870, 870, 866, 872, 870, 867, 870, 871, 872, 868, 872, 870, 874, 870, 871,
+  869, 868, 872, 871,
+};
+
+// Volume pot at its high end stop, turned down to 0 in 100 ms, then left there
+static const uint16_t FAST_TURN_TRACE[] = {
+  871, 873, 870, 871, 870, 871, 871, 870, 870, 871, 872, 870, 873, 872, 871, 871,
+  873, 870, 870, 872, 871, 872, 871, 871, 870, 870, 872, 872, 871, 872, 871, 871,
+  871, 872, 872, 871, 871, 871, 872, 871, 869, 827, 782, 736, 696, 650, 610, 564,
+  521, 477, 434, 393, 349, 305, 261, 215, 173, 130, 86, 44, 1, 1, 2, 3,
+  1, 2, 0, 1, 4, 0, 2, 0, 1, 2, 2, 1, 2, 1, 2, 1,
+  2, 0, 1, 2, 3, 2, 1, 2, 2, 2, 3, 3, 0, 0, 0, 1,
+  2, 0, 2, 1, 1, 1, 0, 2, 2, 1, 1, 3, 1, 1, 2, 2,
+  1, 2, 2, 0, 1, 4, 1, 2,
+};
@@ -0,0 +1,113 @@
+#include <unity.h>
+#include <stdlib.h>
+#include "PotFilter.h"
+#include "adc_traces.h"
+
+// Run on the PC against the ADC traces in adc_traces.h:
+//   pio test -e native_test
+
+#define SAMPLES_PER_SECOND 200 // POT_READ_INTERVAL of 5 ms
+#define VOLUME_MAX_INPUT 870
+
+#define TRACE_LENGTH(trace) (sizeof(trace) / sizeof(trace[0]))
+
+// Output for a noiseless reading
+static int expected(uint16_t reading) {
+  return (reading > VOLUME_MAX_INPUT ? VOLUME_MAX_INPUT : reading) * 255L / VOLUME_MAX_INPUT;
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_still_pot_holds_its_value() {
+  PotFilter pot(VOLUME_MAX_INPUT);
+  pot.update(STILL_TRACE[0]);
+  uint8_t first = pot.value();
+
+  // 10 s of the same 2 s of noise
+  int changes = 0;
+  for (int repeat = 0; repeat < 5; repeat++) {
+    for (size_t i = 0; i < TRACE_LENGTH(STILL_TRACE); i++) {
+      changes += pot.update(STILL_TRACE[i]);
+      TEST_ASSERT_LESS_OR_EQUAL(1, abs(pot.value() - first));
+    }
+  }
+  // At most one change every 5 s
+  TEST_ASSERT_LESS_OR_EQUAL(2, changes);
+}
+
+void test_step_settles_within_two_samples() {
+  PotFilter pot(VOLUME_MAX_INPUT);
+  size_t i = 0;
+  for (; i < 100; i++) {
+    pot.update(STEP_TRACE[i]);
+  }
+  TEST_ASSERT_LESS_OR_EQUAL(1, abs(pot.value() - expected(300)));
+
+  int settled = -1;
+  int changesAfterSettling = 0;
+  for (; i < TRACE_LENGTH(STEP_TRACE); i++) {
+    bool changed = pot.update(STEP_TRACE[i]);
+    if (settled >= 0) {
+      changesAfterSettling += changed;
+    } else if (abs(pot.value() - expected(600)) <= 1) {
+      settled = i - 100 + 1;
+    }
+  }
+  TEST_ASSERT_GREATER_OR_EQUAL(1, settled);
+  TEST_ASSERT_LESS_OR_EQUAL(2, settled);
+  TEST_ASSERT_LESS_OR_EQUAL(1, changesAfterSettling);
+}
+
+void test_slow_turn_follows_without_going_back() {
+  PotFilter pot(VOLUME_MAX_INPUT);
+  pot.update(SLOW_TURN_TRACE[0]);
+  int previous = pot.value();
+  int maxLag = 0;
+  for (size_t i = 1; i < 600; i++) {
+    pot.update(SLOW_TURN_TRACE[i]);
+    TEST_ASSERT_GREATER_OR_EQUAL(previous, pot.value());
+    previous = pot.value();
+    int lag = expected(i * VOLUME_MAX_INPUT / 600) - pot.value();
+    if (lag > maxLag) {
+      maxLag = lag;
+    }
+  }
+  TEST_ASSERT_LESS_OR_EQUAL(4, maxLag);
+
+  // Held at the end stop, the dead-band pins the output to 255
+  for (size_t i = 600; i < TRACE_LENGTH(SLOW_TURN_TRACE); i++) {
+    pot.update(SLOW_TURN_TRACE[i]);
+    TEST_ASSERT_EQUAL_UINT8(255, pot.value());
+  }
+}
+
+void test_fast_turn_reaches_both_ends() {
+  PotFilter pot(VOLUME_MAX_INPUT);
+  size_t i = 0;
+  // Noise around the end stop, and above it, still reads as 255
+  for (; i < 40; i++) {
+    pot.update(FAST_TURN_TRACE[i]);
+    TEST_ASSERT_EQUAL_UINT8(255, pot.value());
+  }
+  // 100 ms down to 0, the output keeps up within a few steps
+  for (; i < 60; i++) {
+    pot.update(FAST_TURN_TRACE[i]);
+    TEST_ASSERT_LESS_OR_EQUAL(4, abs(pot.value() - expected(FAST_TURN_TRACE[i])));
+  }
+  // Within a sample of stopping, and from then on, the dead-band holds 0
+  pot.update(FAST_TURN_TRACE[i++]);
+  for (; i < TRACE_LENGTH(FAST_TURN_TRACE); i++) {
+    pot.update(FAST_TURN_TRACE[i]);
+    TEST_ASSERT_EQUAL_UINT8(0, pot.value());
+  }
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_still_pot_holds_its_value);
+  RUN_TEST(test_step_settles_within_two_samples);
+  RUN_TEST(test_slow_turn_follows_without_going_back);
+  RUN_TEST(test_fast_turn_reaches_both_ends);
+  return UNITY_END();
+}
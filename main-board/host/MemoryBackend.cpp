@@ -0,0 +1,79 @@
+#include "MemoryBackend.h"
+#include <stdio.h>
+
+void MemoryBackend::push(ILI9341_t3n &tft)
+{
+  width_ = tft.width();
+  height_ = tft.height();
+  memcpy(frame_, tft.getFrameBuffer(), width_ * height_ * sizeof(uint16_t));
+  pushCount_++;
+}
+
+uint32_t MemoryBackend::hash() const
+{
+  const uint8_t *bytes = (const uint8_t *)frame_;
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < width_ * height_ * sizeof(uint16_t); i++)
+  {
+    hash = (hash ^ bytes[i]) * 16777619u;
+  }
+  return hash;
+}
+
+// RGB565 to 8 bits per channel, distinct colors stay distinct
+static void toRGB(uint16_t pixel, uint8_t rgb[3])
+{
+  rgb[0] = (pixel >> 11) * 255 / 31;
+  rgb[1] = ((pixel >> 5) & 0x3F) * 255 / 63;
+  rgb[2] = (pixel & 0x1F) * 255 / 31;
+}
+
+bool MemoryBackend::writePPM(const char *path) const
+{
+  FILE *file = fopen(path, "wb");
+  if (!file)
+  {
+    perror(path);
+    return false;
+  }
+  fprintf(file, "P6\n%d %d\n255\n", width_, height_);
+  for (int i = 0; i < width_ * height_; i++)
+  {
+    uint8_t rgb[3];
+    toRGB(frame_[i], rgb);
+    fwrite(rgb, 1, sizeof(rgb), file);
+  }
+  fclose(file);
+  return true;
+}
+
+long MemoryBackend::comparePPM(const char *path) const
+{
+  FILE *file = fopen(path, "rb");
+  if (!file)
+  {
+    return -1;
+  }
+  int width, height, maxValue;
+  if (fscanf(file, "P6 %d %d %d", &width, &height, &maxValue) != 3 || fgetc(file) == EOF ||
+      width != width_ || height != height_ || maxValue != 255)
+  {
+    fclose(file);
+    return -1;
+  }
+  long differences = 0;
+  for (int i = 0; i < width_ * height_; i++)
+  {
+    uint8_t expected[3], rgb[3];
+    if (fread(expected, 1, sizeof(expected), file) != sizeof(expected))
+    {
+      fclose(file);
+      return -1;
+    }
+    toRGB(frame_[i], rgb);
+    if (memcmp(expected, rgb, sizeof(rgb)) != 0)
+      differences++;
+  }
+  fclose(file);
+  return differences;
+}
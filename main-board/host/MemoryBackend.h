@@ -0,0 +1,35 @@
+#pragma once
+
+#include "DisplayBackend.h"
+
+/* Display backend keeping a copy of the last frame pushed, for the host
+ * builds. The frame can be hashed, written as a PPM image and compared with
+ * one written earlier. */
+class MemoryBackend : public DisplayBackend
+{
+public:
+  void begin(ILI9341_t3n &tft) override {}
+  void push(ILI9341_t3n &tft) override;
+  bool pushAsync(ILI9341_t3n &tft) override
+  {
+    push(tft);
+    return true;
+  }
+
+  const uint16_t *getFrame() const { return frame_; }
+  int16_t width() const { return width_; }
+  int16_t height() const { return height_; }
+  uint32_t getPushCount() const { return pushCount_; }
+
+  // FNV-1a of the pixels
+  uint32_t hash() const;
+  bool writePPM(const char *path) const;
+  // Pixels that differ from a PPM written by writePPM(), -1 if it can't be read
+  long comparePPM(const char *path) const;
+
+private:
+  uint16_t frame_[ILI9341_TFTWIDTH * ILI9341_TFTHEIGHT] = {};
+  int16_t width_ = 0;
+  int16_t height_ = 0;
+  uint32_t pushCount_ = 0;
+};
@@ -0,0 +1,163 @@
+#include "Scenes.h"
+
+#include <TimeLib.h>
+#include <time.h>
+
+extern Display display;
+extern I2C i2c;
+extern FM radio;
+extern AudioSystem audioSystem;
+extern Recorder recorder;
+
+static const uint32_t SPLASH_FRAME_US = 16000;  // Display::update() cap
+static const uint32_t FFT_FRAME_US = 11610;     // One FFT1024 per 512 samples at 44.1 kHz
+static const uint16_t SPLASH_CAPTURES[] = {400, 2100, 2400, 3250, 3700, 5020}; // ms
+static const int FFT_WARMUP = FFT_HISTORY_SIZE * 2;
+static const char *const TITLE_NAMES[] = {"title_bluetooth", "title_radio", "title_sd_player", "title_sd_recorder",
+                                          "title_nfc"};
+
+const MetadataScene Scenes::METADATA[] = {
+    {"metadata_ascii", "Space Oddity", "David Bowie", 0, 0},
+    {"metadata_utf8", "Déjà vu – “Remix”", "Motörhead & Sigur Rós", 0, 0},
+    {"metadata_clamped", "A title far too long to fit on a single line of the display",
+     "An artist name that is also much wider than the screen", 0, 0},
+    {"metadata_progress", "Lullaby", "The Cure - Disintegration", 93000, 248000},
+};
+const int Scenes::METADATA_COUNT = sizeof(METADATA) / sizeof(METADATA[0]);
+
+uint64_t cpuNs()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+  return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+Scenes::Scenes()
+    : controllers{&bluetooth_, &radio_, &player_, &recorder_, &nfc_},
+      bluetooth_(display, i2c, audioSystem),
+      radio_(display, i2c, audioSystem, radio),
+      player_(display, i2c, audioSystem, recorder),
+      recorder_(display, i2c, audioSystem, recorder),
+      nfc_(display, i2c, audioSystem, recorder)
+{
+  Teensy3Clock.set(1717245240); // 2024-06-01 12:34:00
+  setTime(Teensy3Clock.get());
+  display.setBackend(screen);
+  display.init();
+}
+
+void Scenes::renderAll(const SceneCapture &capture)
+{
+  renderSplash(capture);
+  for (int i = 0; i < CONTROLLER_COUNT; i++)
+  {
+    setTime(Teensy3Clock.get()); // Same clock in every title
+    renderTitle(*controllers[i]);
+    display.updateAsync();
+    capture(TITLE_NAMES[i]);
+  }
+
+  fft_.init(&analyzer_);
+  radio_.setDisplayTheme();
+  const AudioModeTheme &theme = radio_.getTheme();
+  fft_.updatePalette(theme.fftFront, theme.fftBack, theme.fftMain);
+  display.clear();
+  for (uint8_t tuning : {128, 255})
+  {
+    for (int i = 0; i < FFT_WARMUP; i++)
+      renderFFT(tuning);
+    display.updateAsync();
+    capture("fft_" + std::to_string(tuning));
+  }
+
+  bluetooth_.setDisplayTheme();
+  for (const MetadataScene &scene : METADATA)
+  {
+    display.clear();
+    renderMetadata(scene);
+    display.updateAsync();
+    capture(scene.name);
+  }
+}
+
+std::vector<uint32_t> Scenes::renderSplash(const SceneCapture &capture)
+{
+  std::vector<uint32_t> cpuUs;
+  size_t next = 0;
+  display.drawSplash();
+  for (uint32_t ms = 0; ms <= 5800; ms += SPLASH_FRAME_US / 1000)
+  {
+    hostAdvanceMicros(SPLASH_FRAME_US);
+    uint64_t start = cpuNs();
+    display.update();
+    cpuUs.push_back((cpuNs() - start) / 1000);
+
+    if (capture && next < sizeof(SPLASH_CAPTURES) / sizeof(SPLASH_CAPTURES[0]) && ms >= SPLASH_CAPTURES[next])
+    {
+      char name[16];
+      snprintf(name, sizeof(name), "splash_%04u", SPLASH_CAPTURES[next++]);
+      display.updateAsync();
+      capture(name);
+    }
+  }
+  return cpuUs;
+}
+
+void Scenes::renderTitle(AudioModeController &controller)
+{
+  controller.setDisplayTheme();
+  display.clear();
+  display.drawModeTitle(controller.getMode());
+  display.updateClock();
+  switch (controller.getMode())
+  {
+  case MODE_BLUETOOTH:
+    display.drawBtIcon(true);
+    break;
+  case MODE_RADIO:
+    display.drawSignalBar(3, 5, true);
+    break;
+  case MODE_SD_RECORDER:
+    display.drawRecIcon(true);
+    break;
+  default:
+    break;
+  }
+}
+
+void Scenes::renderFFT(uint8_t tuning)
+{
+  hostAdvanceMicros(FFT_FRAME_US);
+  if (!fft_.available())
+    return;
+  display.clearMainArea();
+  display.tft.setClipRect(0, 40, 320, 140);
+  fft_.drawHistory(&display, tuning);
+  fft_.drawNewLevels(&display, tuning);
+  display.tft.setClipRect();
+}
+
+void Scenes::renderMetadata(const MetadataScene &scene)
+{
+  display.setMetadata(scene.line1, scene.line2);
+  display.drawProgressBar(scene.position, scene.duration);
+}
+
+bool readGolden(const char *path, std::vector<GoldenHash> &golden)
+{
+  FILE *file = fopen(path, "r");
+  if (!file)
+  {
+    perror(path);
+    return false;
+  }
+  char line[128], name[64];
+  unsigned int hash;
+  while (fgets(line, sizeof(line), file))
+  {
+    if (line[0] != '#' && sscanf(line, "%63s %x", name, &hash) == 2)
+      golden.push_back({name, hash});
+  }
+  fclose(file);
+  return true;
+}
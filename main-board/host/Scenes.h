@@ -0,0 +1,77 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "AudioModeControllerBluetooth.h"
+#include "AudioModeControllerNFCPlayer.h"
+#include "AudioModeControllerRadio.h"
+#include "AudioModeControllerSDPlayer.h"
+#include "AudioModeControllerSDRecorder.h"
+#include "FFT.h"
+#include "MemoryBackend.h"
+
+/* The fixed scenes of the golden frame check, rendered through Display into
+ * a MemoryBackend: splash frames, each mode title, the FFT ridge and
+ * metadata. host/render hashes and times them, test/test_render checks the
+ * hashes against host/golden.txt. */
+
+// Called once a frame is pushed, with the name of the scene it shows
+typedef std::function<void(const std::string &name)> SceneCapture;
+
+struct MetadataScene
+{
+  const char *name;
+  const char *line1;
+  const char *line2;
+  uint32_t position; // ms, no progress bar without a duration
+  uint32_t duration;
+};
+
+struct GoldenHash
+{
+  std::string name;
+  uint32_t hash;
+};
+
+class Scenes
+{
+public:
+  static const int CONTROLLER_COUNT = 5;
+  static const MetadataScene METADATA[];
+  static const int METADATA_COUNT;
+
+  // Sets the clock and puts the display on screen
+  Scenes();
+
+  // Every scene, in the order of the golden list
+  void renderAll(const SceneCapture &capture);
+
+  // The splash animation like setup(), one frame every 16 ms, capturing a few
+  // of them when capture is set. Returns the render time of each frame.
+  std::vector<uint32_t> renderSplash(const SceneCapture &capture);
+  void renderTitle(AudioModeController &controller);
+  // One frame of the spectrum, like frameStep(). The FFT is warmed up on the
+  // radio theme by renderAll().
+  void renderFFT(uint8_t tuning);
+  void renderMetadata(const MetadataScene &scene);
+
+  MemoryBackend screen;
+  AudioModeController *const controllers[CONTROLLER_COUNT];
+
+private:
+  AudioModeControllerBluetooth bluetooth_;
+  AudioModeControllerRadio radio_;
+  AudioModeControllerSDPlayer player_;
+  AudioModeControllerSDRecorder recorder_;
+  AudioModeControllerNFCPlayer nfc_;
+  AudioAnalyzeFFT1024 analyzer_;
+  FFT fft_;
+};
+
+// CPU time of the process
+uint64_t cpuNs();
+
+// Reads a list written by render --update, false if it can't be read
+bool readGolden(const char *path, std::vector<GoldenHash> &golden);
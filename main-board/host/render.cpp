@@ -0,0 +1,209 @@
+/* Renders the fixed scenes of Scenes.h on the host: splash frames, each mode
+ * title, the FFT ridge and metadata. Each frame is hashed, the hashes can be
+ * checked against a golden list and the frames written or compared as PPM
+ * images. Then each scene is rendered again to time it, see host/README.md. */
+
+#include <Arduino.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "Scenes.h"
+
+struct Options
+{
+  const char *goldenPath = nullptr;
+  const char *updatePath = nullptr;
+  const char *outDir = nullptr;
+  const char *diffDir = nullptr;
+  int repeat = 100;
+};
+
+struct Scene
+{
+  std::string name;
+  uint32_t hash;
+  long differences; // With --diff, -1 when there was nothing to compare to
+};
+
+struct Benchmark
+{
+  const char *name;
+  std::vector<uint32_t> cpuUs;
+};
+
+static Options options;
+static std::vector<Scene> scenes;
+static bool failed = false;
+
+static void usage()
+{
+  fprintf(stderr,
+          "usage: render [options]\n"
+          "  --golden FILE   fail unless the frames hash as listed in FILE\n"
+          "  --update FILE   write the frame hashes to FILE\n"
+          "  --out DIR       write the frames as PPM images to DIR\n"
+          "  --diff DIR      count the pixels that differ from the images in DIR\n"
+          "  --repeat N      renders of each scene timed (default 100)\n");
+}
+
+static bool parseOptions(int argc, char **argv)
+{
+  for (int i = 1; i < argc; i++)
+  {
+    const char *arg = argv[i];
+    bool hasValue = i + 1 < argc;
+    if (strcmp(arg, "--golden") == 0 && hasValue)
+      options.goldenPath = argv[++i];
+    else if (strcmp(arg, "--update") == 0 && hasValue)
+      options.updatePath = argv[++i];
+    else if (strcmp(arg, "--out") == 0 && hasValue)
+      options.outDir = argv[++i];
+    else if (strcmp(arg, "--diff") == 0 && hasValue)
+      options.diffDir = argv[++i];
+    else if (strcmp(arg, "--repeat") == 0 && hasValue)
+      options.repeat = max(1L, strtol(argv[++i], nullptr, 10));
+    else
+      return false;
+  }
+  return true;
+}
+
+// Records the frame pushed as a scene
+static void capture(MemoryBackend &screen, const std::string &name)
+{
+  Scene scene = {name, screen.hash(), -1};
+  std::string path = name + ".ppm";
+  if (options.outDir && !screen.writePPM((std::string(options.outDir) + "/" + path).c_str()))
+    failed = true;
+  if (options.diffDir)
+    scene.differences = screen.comparePPM((std::string(options.diffDir) + "/" + path).c_str());
+  scenes.push_back(scene);
+}
+
+// ------------------ Golden hashes --------------------- //
+
+// 0 when every listed frame matches, 1 on a mismatch, 2 if the list can't be read
+static int checkGolden(const char *path)
+{
+  std::vector<GoldenHash> golden;
+  if (!readGolden(path, golden))
+    return 2;
+
+  bool ok = true;
+  for (const GoldenHash &expected : golden)
+  {
+    auto scene = std::find_if(scenes.begin(), scenes.end(),
+                              [&](const Scene &scene) { return scene.name == expected.name; });
+    if (scene == scenes.end())
+    {
+      printf("FAIL: %s not rendered\n", expected.name.c_str());
+      ok = false;
+    }
+    else if (scene->hash != expected.hash)
+    {
+      printf("FAIL: %s hashes to %08x, expected %08x\n", expected.name.c_str(), scene->hash, expected.hash);
+      ok = false;
+    }
+  }
+  for (const Scene &scene : scenes)
+  {
+    if (std::none_of(golden.begin(), golden.end(), [&](const GoldenHash &expected) { return expected.name == scene.name; }))
+      printf("new scene: %s %08x\n", scene.name.c_str(), scene.hash);
+  }
+  return ok ? 0 : 1;
+}
+
+static bool writeGolden(const char *path)
+{
+  FILE *file = fopen(path, "w");
+  if (!file)
+  {
+    perror(path);
+    return false;
+  }
+  fprintf(file, "# Frame hashes of host/render, rewrite with: render --update %s\n", path);
+  for (const Scene &scene : scenes)
+    fprintf(file, "%s %08x\n", scene.name.c_str(), scene.hash);
+  fclose(file);
+  return true;
+}
+
+static void printBenchmark(const Benchmark &benchmark)
+{
+  std::vector<uint32_t> values = benchmark.cpuUs;
+  std::sort(values.begin(), values.end());
+  uint64_t total = 0;
+  for (uint32_t us : values)
+    total += us;
+  printf("  %-18s %6zu renders, cpu avg %5llu us, p50 %5u us, max %6u us\n", benchmark.name, values.size(),
+         (unsigned long long)(total / values.size()), values[(values.size() - 1) / 2], values.back());
+}
+
+int main(int argc, char **argv)
+{
+  if (!parseOptions(argc, argv))
+  {
+    usage();
+    return 2;
+  }
+
+  if (options.outDir)
+    mkdir(options.outDir, 0755);
+
+  static Scenes fixtures;
+  fixtures.renderAll([](const std::string &name) { capture(fixtures.screen, name); });
+
+  // Benchmarks
+  Benchmark splash = {"splash frame"}, titles = {"mode title"}, spectrum = {"fft frame"}, metadata = {"metadata"};
+  for (int run = 0; run < max(1, options.repeat / 100); run++)
+  {
+    std::vector<uint32_t> cpuUs = fixtures.renderSplash(nullptr);
+    splash.cpuUs.insert(splash.cpuUs.end(), cpuUs.begin(), cpuUs.end());
+  }
+  for (int run = 0; run < options.repeat; run++)
+  {
+    for (AudioModeController *controller : fixtures.controllers)
+    {
+      uint64_t start = cpuNs();
+      fixtures.renderTitle(*controller);
+      titles.cpuUs.push_back((cpuNs() - start) / 1000);
+    }
+    uint64_t start = cpuNs();
+    fixtures.renderFFT(128);
+    spectrum.cpuUs.push_back((cpuNs() - start) / 1000);
+    for (int i = 0; i < Scenes::METADATA_COUNT; i++)
+    {
+      start = cpuNs();
+      fixtures.renderMetadata(Scenes::METADATA[i]);
+      metadata.cpuUs.push_back((cpuNs() - start) / 1000);
+    }
+  }
+
+  printf("scenes:\n");
+  for (const Scene &scene : scenes)
+  {
+    printf("  %-18s %08x", scene.name.c_str(), scene.hash);
+    if (options.diffDir)
+    {
+      if (scene.differences < 0)
+        printf("  no image to compare");
+      else
+        printf("  %ld pixels differ", scene.differences);
+    }
+    printf("\n");
+  }
+  printf("render time:\n");
+  for (const Benchmark *benchmark : {&splash, &titles, &spectrum, &metadata})
+    printBenchmark(*benchmark);
+
+  if (options.updatePath && !writeGolden(options.updatePath))
+    return 2;
+  int golden = options.goldenPath ? checkGolden(options.goldenPath) : 0;
+  if (golden)
+    return golden;
+  if (options.diffDir && std::any_of(scenes.begin(), scenes.end(), [](const Scene &scene) { return scene.differences != 0; }))
+    return 1;
+  return failed ? 2 : 0;
+}
@@ -0,0 +1,321 @@
+/* Replays an IO trace (include/IOTrace.h) through the firmware built for the
+ * host: setup() then loop() on the virtual clock, with the recorded frames
+ * fed to the simulated IO board. Reports the CPU time of every displayed
+ * frame and hashes of the final frame and state, see host/README.md. */
+
+#include <Arduino.h>
+#include <SD.h>
+#include <time.h>
+#include <algorithm>
+#include <vector>
+
+#include "AudioModeController.h"
+#include "Display.h"
+#include "FM.h"
+#include "I2C.h"
+#include "I2CSimDevices.h"
+#include "IOTrace.h"
+#include "MemoryBackend.h"
+
+extern Display display;
+extern I2C i2c;
+extern AudioModeController *audioController;
+extern bool needsTimeSetup;
+
+static MemoryBackend screen; // Last frame pushed, the one hashed and dumped
+
+static const char *MODE_NAMES[] = {"time setup", "bluetooth", "radio", "sd player", "sd recorder", "nfc", "pong"};
+
+struct Options
+{
+  const char *tracePath = nullptr;
+  const char *sdRoot = nullptr;
+  const char *framesPath = nullptr;
+  const char *dumpPath = nullptr;
+  const char *expectFrame = nullptr;
+  const char *expectState = nullptr;
+  uint32_t rtc = 1717243200; // 2024-06-01 12:00:00
+  uint32_t stepUs = 1000;
+  uint32_t tailMs = 2000;
+  bool quickBoot = false;
+  bool serial = false;
+};
+
+struct FrameSample
+{
+  uint32_t ms;
+  AudioMode mode;
+  uint32_t cpuUs;
+};
+
+static void usage()
+{
+  fprintf(stderr,
+          "usage: replay [options] trace.csv\n"
+          "  --sd DIR              directory standing in for the SD card (default: no card)\n"
+          "  --rtc SECONDS         RTC at power on, unix time (default 1717243200)\n"
+          "  --quick-boot          boot as after a reset, without the splash\n"
+          "  --step US             virtual time between loop() calls (default 1000)\n"
+          "  --tail MS             run time after the last frame (default 2000)\n"
+          "  --frames FILE         write the CPU time of every frame as CSV\n"
+          "  --dump FILE           write the last frame as a PPM image\n"
+          "  --expect-frame HASH   fail unless the last frame hashes to HASH\n"
+          "  --expect-state HASH   fail unless the final state hashes to HASH\n"
+          "  --serial              print the firmware serial output on stderr\n");
+}
+
+static bool parseOptions(int argc, char **argv, Options &options)
+{
+  for (int i = 1; i < argc; i++)
+  {
+    const char *arg = argv[i];
+    bool hasValue = i + 1 < argc;
+    if (strcmp(arg, "--quick-boot") == 0)
+      options.quickBoot = true;
+    else if (strcmp(arg, "--serial") == 0)
+      options.serial = true;
+    else if (strcmp(arg, "--sd") == 0 && hasValue)
+      options.sdRoot = argv[++i];
+    else if (strcmp(arg, "--rtc") == 0 && hasValue)
+      options.rtc = strtoul(argv[++i], nullptr, 10);
+    else if (strcmp(arg, "--step") == 0 && hasValue)
+      options.stepUs = max(1UL, strtoul(argv[++i], nullptr, 10));
+    else if (strcmp(arg, "--tail") == 0 && hasValue)
+      options.tailMs = strtoul(argv[++i], nullptr, 10);
+    else if (strcmp(arg, "--frames") == 0 && hasValue)
+      options.framesPath = argv[++i];
+    else if (strcmp(arg, "--dump") == 0 && hasValue)
+      options.dumpPath = argv[++i];
+    else if (strcmp(arg, "--expect-frame") == 0 && hasValue)
+      options.expectFrame = argv[++i];
+    else if (strcmp(arg, "--expect-state") == 0 && hasValue)
+      options.expectState = argv[++i];
+    else if (arg[0] != '-' && !options.tracePath)
+      options.tracePath = arg;
+    else
+      return false;
+  }
+  return options.tracePath != nullptr;
+}
+
+static bool loadTrace(const char *path, std::vector<IOTraceFrame> &frames)
+{
+  FILE *file = fopen(path, "r");
+  if (!file)
+  {
+    perror(path);
+    return false;
+  }
+  char line[256];
+  IOTraceFrame frame;
+  while (fgets(line, sizeof(line), file))
+  {
+    // Header and other serial output are skipped
+    if (IOTrace::parse(line, frame))
+      frames.push_back(frame);
+  }
+  fclose(file);
+  return true;
+}
+
+static IOSimFrame toSimFrame(const IOTraceFrame &frame)
+{
+  IOSimFrame sim = {0, frame.buttons, frame.volume, frame.tone, frame.tuning, frame.brightness,
+                    frame.fmValue, frame.control};
+  memcpy(sim.nfcUid, frame.nfcUid, sizeof(sim.nfcUid));
+  return sim;
+}
+
+static uint64_t cpuNs()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+  return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+// FNV-1a
+static uint32_t hashBytes(const void *data, size_t size, uint32_t hash = 2166136261u)
+{
+  const uint8_t *bytes = (const uint8_t *)data;
+  for (size_t i = 0; i < size; i++)
+  {
+    hash = (hash ^ bytes[i]) * 16777619u;
+  }
+  return hash;
+}
+
+template <class T>
+static uint32_t hashValue(uint32_t hash, T value)
+{
+  return hashBytes(&value, sizeof(value), hash);
+}
+
+static uint32_t stateHash()
+{
+  const IOState &io = i2c.getIOState();
+  uint32_t hash = 2166136261u;
+  hash = hashValue(hash, (int32_t)audioController->getMode());
+  hash = hashValue(hash, (uint8_t)needsTimeSetup);
+  hash = hashValue(hash, io.buttonStates);
+  hash = hashValue(hash, io.volume);
+  hash = hashValue(hash, io.tone);
+  hash = hashValue(hash, io.tuning);
+  hash = hashValue(hash, io.brightness);
+  hash = hashValue(hash, io.fmValue);
+  hash = hashValue(hash, (int32_t)io.control);
+  hash = hashBytes(io.nfcUidString.c_str(), io.nfcUidString.length(), hash);
+  hash = hashValue(hash, SNVS_LPGPR0); // Frequency
+  hash = hashValue(hash, SNVS_LPGPR2); // Favourite
+  hash = hashValue(hash, SNVS_LPGPR3); // RDS correction
+  return hash;
+}
+
+static const char *modeName(AudioMode mode)
+{
+  return mode >= 0 && mode <= MODE_PONG ? MODE_NAMES[mode] : "unknown";
+}
+
+static uint32_t percentile(std::vector<uint32_t> values, int percent)
+{
+  if (values.empty())
+    return 0;
+  size_t index = (values.size() - 1) * percent / 100;
+  std::nth_element(values.begin(), values.begin() + index, values.end());
+  return values[index];
+}
+
+static void printFrameStats(const char *label, const std::vector<uint32_t> &cpuUs)
+{
+  uint64_t total = 0;
+  for (uint32_t us : cpuUs)
+    total += us;
+  printf("  %-12s %6zu frames, cpu avg %5llu us, p50 %5u us, p95 %5u us, max %6u us\n", label, cpuUs.size(),
+         cpuUs.empty() ? 0ULL : (unsigned long long)(total / cpuUs.size()), percentile(cpuUs, 50),
+         percentile(cpuUs, 95), cpuUs.empty() ? 0 : *std::max_element(cpuUs.begin(), cpuUs.end()));
+}
+
+int main(int argc, char **argv)
+{
+  Options options;
+  if (!parseOptions(argc, argv, options))
+  {
+    usage();
+    return 2;
+  }
+
+  std::vector<IOTraceFrame> trace;
+  if (!loadTrace(options.tracePath, trace))
+    return 2;
+  if (trace.empty())
+  {
+    fprintf(stderr, "%s: no IO frames\n", options.tracePath);
+    return 2;
+  }
+
+  Serial.hostEcho(options.serial);
+  SD.hostSetRoot(options.sdRoot);
+  Teensy3Clock.set(options.rtc);
+  SNVS_LPGPR1 = options.quickBoot ? options.rtc : 0; // Last alive time
+
+  // The first frame is what the IO board sends at boot
+  IOBoardSim &ioBoard = simulatedIOBoard();
+  ioBoard.setFrame(toSimFrame(trace[0]));
+
+  display.setBackend(screen);
+
+  uint64_t start = cpuNs();
+  setup();
+  uint64_t setupNs = cpuNs() - start;
+  uint32_t setupMs = millis();
+
+  // The recording started once the firmware was running, the other frames
+  // keep their spacing from the first one
+  uint32_t offset = millis() - trace[0].ms;
+  uint32_t endMs = trace.back().ms + offset + options.tailMs;
+
+  std::vector<FrameSample> frames;
+  size_t next = 1;
+  uint32_t pushes = display.getPushCount();
+  uint64_t frameNs = 0;
+  start = cpuNs();
+  while (millis() < endMs)
+  {
+    while (next < trace.size() && trace[next].ms + offset <= millis())
+    {
+      ioBoard.setFrame(toSimFrame(trace[next++]));
+    }
+
+    uint64_t loopStart = cpuNs();
+    loop();
+    frameNs += cpuNs() - loopStart;
+
+    // A frame is everything loop() did since the previous push
+    if (display.getPushCount() != pushes)
+    {
+      pushes = display.getPushCount();
+      frames.push_back({millis(), audioController->getMode(), (uint32_t)(frameNs / 1000)});
+      frameNs = 0;
+    }
+    hostAdvanceMicros(options.stepUs);
+  }
+  uint64_t loopNs = cpuNs() - start;
+
+  printf("trace: %s, %zu frames over %.1f s\n", options.tracePath, trace.size(),
+         (trace.back().ms - trace[0].ms) / 1000.0);
+  printf("setup: %.2f s virtual, %.1f ms cpu\n", setupMs / 1000.0, setupNs / 1e6);
+  printf("loop: %.2f s virtual, %.1f ms cpu\n", (millis() - setupMs) / 1000.0, loopNs / 1e6);
+
+  std::vector<uint32_t> all;
+  std::vector<uint32_t> byMode[MODE_PONG + 1];
+  for (const FrameSample &frame : frames)
+  {
+    all.push_back(frame.cpuUs);
+    if (frame.mode >= 0 && frame.mode <= MODE_PONG)
+      byMode[frame.mode].push_back(frame.cpuUs);
+  }
+  printFrameStats("all", all);
+  for (int mode = 0; mode <= MODE_PONG; mode++)
+  {
+    if (!byMode[mode].empty())
+      printFrameStats(MODE_NAMES[mode], byMode[mode]);
+  }
+
+  if (options.framesPath)
+  {
+    FILE *file = fopen(options.framesPath, "w");
+    if (!file)
+    {
+      perror(options.framesPath);
+      return 2;
+    }
+    fprintf(file, "frame,ms,mode,cpu_us\n");
+    for (size_t i = 0; i < frames.size(); i++)
+      fprintf(file, "%zu,%u,%d,%u\n", i, frames[i].ms, frames[i].mode, frames[i].cpuUs);
+    fclose(file);
+  }
+  if (options.dumpPath && !screen.writePPM(options.dumpPath))
+    return 2;
+
+  const IOState &io = i2c.getIOState();
+  printf("final: mode %s, buttons 0x%02X, volume %u, tone %u, tuning %u, brightness %u, uid %s, frequency %lu\n",
+         modeName(audioController->getMode()), io.buttonStates, io.volume, io.tone, io.tuning, io.brightness,
+         io.nfcUidString.c_str(), (unsigned long)SNVS_LPGPR0);
+
+  char frameHash[9], finalHash[9];
+  snprintf(frameHash, sizeof(frameHash), "%08x", screen.hash());
+  snprintf(finalHash, sizeof(finalHash), "%08x", stateHash());
+  printf("frame hash: %s\nstate hash: %s\n", frameHash, finalHash);
+
+  bool failed = false;
+  if (options.expectFrame && strcasecmp(options.expectFrame, frameHash) != 0)
+  {
+    printf("FAIL: frame hash %s, expected %s\n", frameHash, options.expectFrame);
+    failed = true;
+  }
+  if (options.expectState && strcasecmp(options.expectState, finalHash) != 0)
+  {
+    printf("FAIL: state hash %s, expected %s\n", finalHash, options.expectState);
+    failed = true;
+  }
+  return failed ? 1 : 0;
+}
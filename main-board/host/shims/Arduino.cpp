@@ -0,0 +1,254 @@
+#include "Arduino.h"
+#include <stdarg.h>
+#include <ctype.h>
+#include <algorithm>
+
+// ------------------ Virtual time --------------------- //
+
+static uint64_t nowUs = 0;
+static uint32_t yieldUs = 1000;
+
+uint64_t hostMicros() { return nowUs; }
+void hostAdvanceMicros(uint64_t us) { nowUs += us; }
+void hostSetYieldMicros(uint32_t us) { yieldUs = us; }
+
+uint32_t millis() { return nowUs / 1000; }
+uint32_t micros() { return nowUs; }
+void delay(uint32_t ms) { nowUs += ms * 1000ULL; }
+void delayMicroseconds(uint32_t us) { nowUs += us; }
+// Busy waits spin on yield(), it has to move the clock
+void yield() { nowUs += yieldUs; }
+
+// ------------------ Pins and registers --------------------- //
+
+static uint8_t pinStates[64];
+static int analogValues[64];
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+  if (pin < 64 && mode == INPUT_PULLUP)
+    pinStates[pin] = HIGH;
+}
+
+void digitalWrite(uint8_t pin, uint8_t value)
+{
+  if (pin < 64)
+    pinStates[pin] = value;
+}
+
+// Released lines read high, like the pulled up I2C pins
+uint8_t digitalRead(uint8_t pin) { return HIGH; }
+
+void analogWrite(uint8_t pin, int value)
+{
+  if (pin < 64)
+    analogValues[pin] = value;
+}
+
+int analogRead(uint8_t pin) { return 0; }
+int hostAnalogValue(uint8_t pin) { return pin < 64 ? analogValues[pin] : 0; }
+
+uint32_t SNVS_LPCR;
+uint32_t SNVS_LPGPR0;
+uint32_t SNVS_LPGPR1;
+uint32_t SNVS_LPGPR2;
+uint32_t SNVS_LPGPR3;
+
+Teensy3ClockClass Teensy3Clock;
+static uint32_t rtcSeconds = 0;
+static uint64_t rtcSetAtUs = 0;
+
+uint32_t Teensy3ClockClass::get() { return rtcSeconds + (nowUs - rtcSetAtUs) / 1000000; }
+
+void Teensy3ClockClass::set(uint32_t seconds)
+{
+  rtcSeconds = seconds;
+  rtcSetAtUs = nowUs;
+}
+
+// ------------------ Math --------------------- //
+
+static uint32_t randomState = 1;
+
+static uint32_t nextRandom()
+{
+  // xorshift32
+  randomState ^= randomState << 13;
+  randomState ^= randomState >> 17;
+  randomState ^= randomState << 5;
+  return randomState;
+}
+
+int32_t random(int32_t howBig) { return howBig > 0 ? nextRandom() % howBig : 0; }
+
+int32_t random(int32_t howSmall, int32_t howBig)
+{
+  if (howSmall >= howBig)
+    return howSmall;
+  return howSmall + random(howBig - howSmall);
+}
+
+void randomSeed(uint32_t seed) { randomState = seed ? seed : 1; }
+
+// ------------------ Print --------------------- //
+
+size_t Print::write(const uint8_t *buffer, size_t size)
+{
+  size_t written = 0;
+  while (size--)
+    written += write(*buffer++);
+  return written;
+}
+
+size_t Print::printNumber_(long long value, int base, bool isSigned)
+{
+  if (base == DEC)
+  {
+    char text[24];
+    snprintf(text, sizeof(text), isSigned ? "%lld" : "%llu", value);
+    return write(text);
+  }
+  // Like the core, other bases print the unsigned 32 bit value
+  char text[40];
+  char *p = &text[sizeof(text) - 1];
+  *p = '\0';
+  uint32_t number = (uint32_t)value;
+  do
+  {
+    uint8_t digit = number % base;
+    *--p = digit < 10 ? '0' + digit : 'A' + digit - 10;
+    number /= base;
+  } while (number);
+  return write(p);
+}
+
+size_t Print::print(double value, int digits)
+{
+  char text[48];
+  snprintf(text, sizeof(text), "%.*f", digits, value);
+  return write(text);
+}
+
+int Print::printf(const char *format, ...)
+{
+  char text[512];
+  va_list args;
+  va_start(args, format);
+  int length = vsnprintf(text, sizeof(text), format, args);
+  va_end(args);
+  write((const uint8_t *)text, std::min(length, (int)sizeof(text) - 1));
+  return length;
+}
+
+// ------------------ String --------------------- //
+
+String::String(float value, unsigned char decimals) : String((double)value, decimals) {}
+
+String::String(double value, unsigned char decimals)
+{
+  char text[48];
+  snprintf(text, sizeof(text), "%.*f", decimals, value);
+  text_ = text;
+}
+
+std::string String::format_(unsigned long long value, unsigned char base)
+{
+  std::string text;
+  do
+  {
+    uint8_t digit = value % base;
+    text.insert(text.begin(), digit < 10 ? '0' + digit : 'a' + digit - 10);
+    value /= base;
+  } while (value);
+  return text;
+}
+
+std::string String::format_(long long value, unsigned char base)
+{
+  if (base == 10 && value < 0)
+    return "-" + format_((unsigned long long)-value, base);
+  // Negative numbers in other bases are their 32 bit two's complement
+  return format_(base == 10 ? (unsigned long long)value : (unsigned long long)(uint32_t)value, base);
+}
+
+String String::substring(unsigned int from, unsigned int to) const
+{
+  if (from > to)
+    std::swap(from, to);
+  if (from >= text_.size())
+    return String();
+  return String(text_.substr(from, std::min((size_t)to, text_.size()) - from));
+}
+
+void String::toUpperCase()
+{
+  for (char &c : text_)
+    c = toupper(c);
+}
+
+void String::toLowerCase()
+{
+  for (char &c : text_)
+    c = tolower(c);
+}
+
+void String::trim()
+{
+  size_t begin = text_.find_first_not_of(" \t\r\n\v\f");
+  if (begin == std::string::npos)
+  {
+    text_.clear();
+    return;
+  }
+  size_t end = text_.find_last_not_of(" \t\r\n\v\f");
+  text_ = text_.substr(begin, end - begin + 1);
+}
+
+void String::replace(const String &from, const String &to)
+{
+  if (from.text_.empty())
+    return;
+  size_t position = 0;
+  while ((position = text_.find(from.text_, position)) != std::string::npos)
+  {
+    text_.replace(position, from.text_.size(), to.text_);
+    position += to.text_.size();
+  }
+}
+
+void String::remove(unsigned int index, unsigned int count)
+{
+  if (index < text_.size())
+    text_.erase(index, count);
+}
+
+// ------------------ Serial --------------------- //
+
+HostSerial Serial;
+
+size_t HostSerial::write(uint8_t c)
+{
+  if (echo_)
+    fputc(c, stderr);
+  return 1;
+}
+
+size_t HostSerial::write(const uint8_t *buffer, size_t size)
+{
+  if (echo_)
+    fwrite(buffer, 1, size, stderr);
+  return size;
+}
+
+void HostSerial::hostInput(const char *text) { input_ += text; }
+
+int HostSerial::available() { return input_.length() - inputIndex_; }
+
+int HostSerial::read()
+{
+  if (inputIndex_ >= input_.length())
+    return -1;
+  return (uint8_t)input_[inputIndex_++];
+}
+
+int HostSerial::peek() { return inputIndex_ < input_.length() ? (uint8_t)input_[inputIndex_] : -1; }
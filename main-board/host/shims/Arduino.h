@@ -0,0 +1,189 @@
+#pragma once
+
+/* Host build of the subset of the Teensy core used by the firmware, see
+ * host/README.md. Time is virtual: it only moves with delay(), yield() and
+ * hostAdvanceMicros(), so a replay gives the same result on every run. */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <utility>
+
+#include "WString.h"
+#include "Print.h"
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+// newlib on the Teensy has it, glibc only from 2.38
+#if defined(__GLIBC__) && (__GLIBC__ < 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ < 38))
+inline size_t strlcpy(char *destination, const char *source, size_t size)
+{
+  size_t length = strlen(source);
+  if (size > 0)
+  {
+    size_t copied = length < size - 1 ? length : size - 1;
+    memcpy(destination, source, copied);
+    destination[copied] = '\0';
+  }
+  return length;
+}
+#endif
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define OUTPUT_OPENDRAIN 4
+
+#define PROGMEM
+#define DMAMEM
+#define FLASHMEM
+#define F(string) (string)
+#define pgm_read_byte(address) (*(const uint8_t *)(address))
+#define pgm_read_word(address) (*(const uint16_t *)(address))
+
+#define F_CPU 600000000
+#define F_CPU_ACTUAL 600000000
+
+// ------------------ Virtual time --------------------- //
+
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+
+// Host only: moves the virtual clock, and sets how much a yield() takes
+void hostAdvanceMicros(uint64_t us);
+uint64_t hostMicros();
+void hostSetYieldMicros(uint32_t us);
+
+// Cycle counter, derived from the virtual clock
+#define ARM_DWT_CYCCNT ((uint32_t)(hostMicros() * (F_CPU_ACTUAL / 1000000)))
+
+class elapsedMillis
+{
+public:
+  elapsedMillis() : start_(millis()) {}
+  elapsedMillis(uint32_t value) : start_(millis() - value) {}
+  operator uint32_t() const { return millis() - start_; }
+  elapsedMillis &operator=(uint32_t value)
+  {
+    start_ = millis() - value;
+    return *this;
+  }
+
+private:
+  uint32_t start_;
+};
+
+class elapsedMicros
+{
+public:
+  elapsedMicros() : start_(micros()) {}
+  elapsedMicros(uint32_t value) : start_(micros() - value) {}
+  operator uint32_t() const { return micros() - start_; }
+  elapsedMicros &operator=(uint32_t value)
+  {
+    start_ = micros() - value;
+    return *this;
+  }
+
+private:
+  uint32_t start_;
+};
+
+// ------------------ Pins and registers --------------------- //
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+uint8_t digitalRead(uint8_t pin);
+void analogWrite(uint8_t pin, int value);
+int analogRead(uint8_t pin);
+// Host only: last analogWrite() value, for the state hash
+int hostAnalogValue(uint8_t pin);
+
+inline void __disable_irq() {}
+inline void __enable_irq() {}
+inline void interrupts() {}
+inline void noInterrupts() {}
+
+// SNVS low power registers, kept across resets on the device
+extern uint32_t SNVS_LPCR;
+extern uint32_t SNVS_LPGPR0;
+extern uint32_t SNVS_LPGPR1;
+extern uint32_t SNVS_LPGPR2;
+extern uint32_t SNVS_LPGPR3;
+
+// RTC, counts from the virtual clock
+class Teensy3ClockClass
+{
+public:
+  static uint32_t get();
+  static void set(uint32_t seconds);
+};
+extern Teensy3ClockClass Teensy3Clock;
+
+// ------------------ Math --------------------- //
+
+// Same as the core, seeded the same on every run
+int32_t random(int32_t howBig);
+int32_t random(int32_t howSmall, int32_t howBig);
+void randomSeed(uint32_t seed);
+
+template <class A, class B>
+constexpr auto min(A &&a, B &&b) -> decltype(a < b ? std::forward<A>(a) : std::forward<B>(b))
+{
+  return a < b ? std::forward<A>(a) : std::forward<B>(b);
+}
+
+template <class A, class B>
+constexpr auto max(A &&a, B &&b) -> decltype(a < b ? std::forward<A>(a) : std::forward<B>(b))
+{
+  return a >= b ? std::forward<A>(a) : std::forward<B>(b);
+}
+
+template <class T, class L, class H>
+constexpr auto constrain(T &&value, L &&low, H &&high) -> decltype(value < low ? low : (value > high ? high : value))
+{
+  return value < low ? low : (value > high ? high : value);
+}
+
+template <class T, class A, class B, class C, class D>
+T map(T x, A inMin, B inMax, C outMin, D outMax)
+{
+  return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+// ------------------ Serial --------------------- //
+
+// USB serial: output goes to stderr when enabled, input is fed by the host
+class HostSerial : public Stream
+{
+public:
+  void begin(uint32_t baud) {}
+  operator bool() const { return true; }
+  size_t write(uint8_t c) override;
+  size_t write(const uint8_t *buffer, size_t size) override;
+  int availableForWrite() override { return 4096; }
+  int available() override;
+  int read() override;
+  int peek() override;
+  void flush() {}
+
+  void hostEcho(bool enabled) { echo_ = enabled; }
+  void hostInput(const char *text);
+
+private:
+  bool echo_ = false;
+  String input_;
+  size_t inputIndex_ = 0;
+};
+extern HostSerial Serial;
+
+void setup();
+void loop();
@@ -0,0 +1,95 @@
+#include "Audio.h"
+#include <SD.h>
+
+const int16_t AudioWindowHanning1024[1] = {};
+
+static const uint32_t FFT_INTERVAL_US = 11610; // 512 samples at 44.1 kHz
+static const uint32_t PEAK_INTERVAL_US = 2902; // One block
+
+void AudioMemory(unsigned int blocks) {}
+float AudioProcessorUsage() { return 0; }
+float AudioProcessorUsageMax() { return 0; }
+void AudioProcessorUsageMaxReset() {}
+unsigned int AudioMemoryUsage() { return 0; }
+unsigned int AudioMemoryUsageMax() { return 0; }
+void AudioMemoryUsageMaxReset() {}
+
+// Integer hash, so that the levels are the same on every host
+static uint32_t mix(uint32_t a, uint32_t b)
+{
+  uint32_t h = a * 0x9E3779B1u ^ (b + 0x7F4A7C15u);
+  h ^= h >> 15;
+  h *= 0x2C1B3C6Du;
+  h ^= h >> 12;
+  return h;
+}
+
+bool AudioPlaySdWav::play(const char *filename)
+{
+  File file = SD.open(filename);
+  uint8_t header[44];
+  if (!file || file.read(header, sizeof(header)) != sizeof(header))
+  {
+    playing_ = false;
+    return false;
+  }
+  uint32_t byteRate = header[28] | header[29] << 8 | header[30] << 16 | (uint32_t)header[31] << 24;
+  uint64_t dataBytes = file.size() - sizeof(header);
+  lengthMs_ = byteRate ? dataBytes * 1000 / byteRate : 0;
+  startMs_ = millis();
+  playing_ = true;
+  return true;
+}
+
+bool AudioPlaySdWav::isPlaying()
+{
+  if (playing_ && millis() - startMs_ >= lengthMs_)
+    playing_ = false;
+  return playing_;
+}
+
+uint32_t AudioPlaySdWav::positionMillis()
+{
+  return isPlaying() ? millis() - startMs_ : 0;
+}
+
+int16_t *AudioRecordQueue::readBuffer()
+{
+  static int16_t silence[AUDIO_BLOCK_SAMPLES];
+  return silence;
+}
+
+bool AudioAnalyzePeak::available()
+{
+  return hostMicros() - lastRead_ >= PEAK_INTERVAL_US;
+}
+
+float AudioAnalyzePeak::read()
+{
+  lastRead_ = hostMicros();
+  return (mix(lastRead_ / PEAK_INTERVAL_US, 0) % 1000) / 1000.0f;
+}
+
+bool AudioAnalyzeFFT1024::available()
+{
+  if (hostMicros() - lastRead_ < FFT_INTERVAL_US)
+    return false;
+  lastRead_ = hostMicros();
+  frame_++;
+  return true;
+}
+
+float AudioAnalyzeFFT1024::read(unsigned int bin)
+{
+  // Falls off with the frequency, like music
+  uint32_t level = mix(frame_, bin) % 1000;
+  return level / 1000.0f / (1 + bin / 8.0f) * 0.2f;
+}
+
+float AudioAnalyzeFFT1024::read(unsigned int first, unsigned int last)
+{
+  float sum = 0;
+  for (unsigned int bin = first; bin <= last && bin < 512; bin++)
+    sum += read(bin);
+  return sum;
+}
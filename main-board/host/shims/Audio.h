@@ -0,0 +1,162 @@
+#pragma once
+
+#include <Arduino.h>
+
+/* Teensy Audio library stand-ins. Nothing is processed, the analyzers give a
+ * synthetic signal on the virtual clock so that the visualizers have
+ * something to draw, and the SD player keeps a WAV file "playing" for its
+ * length. */
+
+#define AUDIO_BLOCK_SAMPLES 128
+#define AUDIO_SAMPLE_RATE_EXACT 44100.0f
+#define AUDIO_INPUT_LINEIN 0
+#define AUDIO_INPUT_MIC 1
+
+extern const int16_t AudioWindowHanning1024[];
+
+class AudioStream
+{
+public:
+  virtual ~AudioStream() {}
+};
+
+class AudioConnection
+{
+public:
+  AudioConnection(AudioStream &source, AudioStream &destination) {}
+  AudioConnection(AudioStream &source, uint8_t sourceOutput, AudioStream &destination, uint8_t destinationInput) {}
+};
+
+void AudioMemory(unsigned int blocks);
+float AudioProcessorUsage();
+float AudioProcessorUsageMax();
+void AudioProcessorUsageMaxReset();
+unsigned int AudioMemoryUsage();
+unsigned int AudioMemoryUsageMax();
+void AudioMemoryUsageMaxReset();
+inline void AudioNoInterrupts() {}
+inline void AudioInterrupts() {}
+
+class AudioInputI2S : public AudioStream
+{
+};
+
+class AudioOutputI2S : public AudioStream
+{
+};
+
+class AudioMixer4 : public AudioStream
+{
+public:
+  void gain(unsigned int channel, float gain)
+  {
+    if (channel < 4)
+      gains_[channel] = gain;
+  }
+
+private:
+  float gains_[4] = {1, 1, 1, 1};
+};
+
+class AudioAmplifier : public AudioStream
+{
+public:
+  void gain(float gain) { gain_ = gain; }
+
+private:
+  float gain_ = 1;
+};
+
+class AudioFilterBiquad : public AudioStream
+{
+public:
+  void setLowpass(uint32_t stage, float frequency, float q = 0.7071) {}
+  void setHighpass(uint32_t stage, float frequency, float q = 0.7071) {}
+  void setLowShelf(uint32_t stage, float frequency, float gain, float slope = 1.0f) {}
+  void setHighShelf(uint32_t stage, float frequency, float gain, float slope = 1.0f) {}
+};
+
+class AudioEffectBitcrusher : public AudioStream
+{
+public:
+  void bits(uint8_t bits) { bits_ = bits; }
+  void sampleRate(float hz) { sampleRate_ = hz; }
+
+private:
+  uint8_t bits_ = 16;
+  float sampleRate_ = 44100;
+};
+
+class AudioControlSGTL5000
+{
+public:
+  bool enable() { return true; }
+  bool muteLineout() { return true; }
+  bool volume(float volume) { return true; }
+  bool inputSelect(int input) { return true; }
+  bool lineInLevel(uint8_t level) { return true; }
+  bool micGain(unsigned int dB) { return true; }
+  unsigned short adcHighPassFilterDisable() { return 0; }
+  unsigned short audioPostProcessorEnable() { return 0; }
+  unsigned short enhanceBassEnable() { return 0; }
+  unsigned short enhanceBassDisable() { return 0; }
+  void eqBands(float bass, float midBass, float midrange, float midTreble, float treble) {}
+};
+
+class AudioPlayMemory : public AudioStream
+{
+public:
+  void play(const unsigned int *data) {}
+  void stop() {}
+  bool isPlaying() { return false; }
+};
+
+class AudioPlaySdWav : public AudioStream
+{
+public:
+  bool play(const char *filename);
+  void stop() { playing_ = false; }
+  bool isPlaying();
+  uint32_t positionMillis();
+  uint32_t lengthMillis() { return lengthMs_; }
+
+private:
+  bool playing_ = false;
+  uint32_t startMs_ = 0;
+  uint32_t lengthMs_ = 0;
+};
+
+class AudioRecordQueue : public AudioStream
+{
+public:
+  void begin() {}
+  void end() {}
+  int available() { return 0; }
+  int16_t *readBuffer();
+  void freeBuffer() {}
+  void clear() {}
+};
+
+// Synthetic levels, refreshed at the rate of the real analyzers
+class AudioAnalyzePeak : public AudioStream
+{
+public:
+  bool available();
+  float read();
+
+private:
+  uint64_t lastRead_ = 0;
+};
+
+class AudioAnalyzeFFT1024 : public AudioStream
+{
+public:
+  void windowFunction(const int16_t *window) {}
+  bool available();
+  float read(unsigned int bin);
+  float read(unsigned int first, unsigned int last);
+
+private:
+  uint64_t lastRead_ = 0;
+  uint32_t frame_ = 0;
+};
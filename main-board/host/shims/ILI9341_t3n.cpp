@@ -0,0 +1,411 @@
+#include "ILI9341_t3n.h"
+#include <string>
+
+void ILI9341_t3n::setRotation(uint8_t rotation)
+{
+  bool landscape = rotation & 1;
+  width_ = landscape ? ILI9341_TFTHEIGHT : ILI9341_TFTWIDTH;
+  height_ = landscape ? ILI9341_TFTWIDTH : ILI9341_TFTHEIGHT;
+  cursorX_ = cursorY_ = 0;
+  setClipRect();
+}
+
+void ILI9341_t3n::setClipRect(int16_t x, int16_t y, int16_t w, int16_t h)
+{
+  clipX1_ = max(x, (int16_t)0);
+  clipY1_ = max(y, (int16_t)0);
+  clipX2_ = min(x + w, (int)width_);
+  clipY2_ = min(y + h, (int)height_);
+}
+
+void ILI9341_t3n::drawPixel(int16_t x, int16_t y, uint16_t color)
+{
+  if (x < clipX1_ || x >= clipX2_ || y < clipY1_ || y >= clipY2_)
+    return;
+  frameBuffer_[y * width_ + x] = color;
+}
+
+void ILI9341_t3n::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+  int x1 = max((int)x, (int)clipX1_);
+  int y1 = max((int)y, (int)clipY1_);
+  int x2 = min(x + w, (int)clipX2_);
+  int y2 = min(y + h, (int)clipY2_);
+  for (int row = y1; row < y2; row++)
+  {
+    uint16_t *pixel = &frameBuffer_[row * width_ + x1];
+    for (int column = x1; column < x2; column++)
+      *pixel++ = color;
+  }
+}
+
+void ILI9341_t3n::drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+  drawFastHLine(x, y, w, color);
+  drawFastHLine(x, y + h - 1, w, color);
+  drawFastVLine(x, y, h, color);
+  drawFastVLine(x + w - 1, y, h, color);
+}
+
+void ILI9341_t3n::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color)
+{
+  bool steep = abs(y1 - y0) > abs(x1 - x0);
+  if (steep)
+  {
+    std::swap(x0, y0);
+    std::swap(x1, y1);
+  }
+  if (x0 > x1)
+  {
+    std::swap(x0, x1);
+    std::swap(y0, y1);
+  }
+
+  int16_t dx = x1 - x0;
+  int16_t dy = abs(y1 - y0);
+  int16_t err = dx / 2;
+  int16_t yStep = y0 < y1 ? 1 : -1;
+  for (; x0 <= x1; x0++)
+  {
+    if (steep)
+      drawPixel(y0, x0, color);
+    else
+      drawPixel(x0, y0, color);
+    err -= dy;
+    if (err < 0)
+    {
+      y0 += yStep;
+      err += dx;
+    }
+  }
+}
+
+void ILI9341_t3n::fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color)
+{
+  // Sort by y
+  if (y0 > y1)
+  {
+    std::swap(y0, y1);
+    std::swap(x0, x1);
+  }
+  if (y1 > y2)
+  {
+    std::swap(y2, y1);
+    std::swap(x2, x1);
+  }
+  if (y0 > y1)
+  {
+    std::swap(y0, y1);
+    std::swap(x0, x1);
+  }
+
+  if (y0 == y2)
+  {
+    int16_t a = min(x0, min(x1, x2));
+    int16_t b = max(x0, max(x1, x2));
+    drawFastHLine(a, y0, b - a + 1, color);
+    return;
+  }
+
+  int16_t dx01 = x1 - x0, dy01 = y1 - y0;
+  int16_t dx02 = x2 - x0, dy02 = y2 - y0;
+  int16_t dx12 = x2 - x1, dy12 = y2 - y1;
+  int32_t sa = 0, sb = 0;
+
+  // Upper part, includes y1 unless the lower edge is flat
+  int16_t last = y1 == y2 ? y1 : y1 - 1;
+  int16_t y;
+  for (y = y0; y <= last; y++)
+  {
+    int16_t a = x0 + sa / dy01;
+    int16_t b = x0 + sb / dy02;
+    sa += dx01;
+    sb += dx02;
+    if (a > b)
+      std::swap(a, b);
+    drawFastHLine(a, y, b - a + 1, color);
+  }
+
+  sa = (int32_t)dx12 * (y - y1);
+  sb = (int32_t)dx02 * (y - y0);
+  for (; y <= y2; y++)
+  {
+    int16_t a = x1 + sa / dy12;
+    int16_t b = x0 + sb / dy02;
+    sa += dx12;
+    sb += dx02;
+    if (a > b)
+      std::swap(a, b);
+    drawFastHLine(a, y, b - a + 1, color);
+  }
+}
+
+void ILI9341_t3n::fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color)
+{
+  drawFastVLine(x0, y0 - r, 2 * r + 1, color);
+  fillCircleHelper_(x0, y0, r, 3, 0, color);
+}
+
+void ILI9341_t3n::fillCircleHelper_(int16_t x0, int16_t y0, int16_t r, uint8_t corners, int16_t delta, uint16_t color)
+{
+  int16_t f = 1 - r;
+  int16_t ddFx = 1;
+  int16_t ddFy = -2 * r;
+  int16_t x = 0;
+  int16_t y = r;
+
+  while (x < y)
+  {
+    if (f >= 0)
+    {
+      y--;
+      ddFy += 2;
+      f += ddFy;
+    }
+    x++;
+    ddFx += 2;
+    f += ddFx;
+
+    if (corners & 1)
+    {
+      drawFastVLine(x0 + x, y0 - y, 2 * y + 1 + delta, color);
+      drawFastVLine(x0 + y, y0 - x, 2 * x + 1 + delta, color);
+    }
+    if (corners & 2)
+    {
+      drawFastVLine(x0 - x, y0 - y, 2 * y + 1 + delta, color);
+      drawFastVLine(x0 - y, y0 - x, 2 * x + 1 + delta, color);
+    }
+  }
+}
+
+void ILI9341_t3n::drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint16_t color)
+{
+  int16_t byteWidth = (w + 7) / 8;
+  for (int16_t j = 0; j < h; j++)
+  {
+    for (int16_t i = 0; i < w; i++)
+    {
+      if (bitmap[j * byteWidth + i / 8] & (128 >> (i & 7)))
+        drawPixel(x + i, y + j, color);
+    }
+  }
+}
+
+// ------------------ Text --------------------- //
+
+size_t ILI9341_t3n::write(uint8_t c)
+{
+  if (font_)
+  {
+    if (c == '\n')
+    {
+      cursorY_ += font_->line_space;
+      cursorX_ = 0;
+    }
+    else if (c != '\r')
+    {
+      drawFontChar_(c);
+    }
+    return 1;
+  }
+
+  if (c == '\n')
+  {
+    cursorY_ += textSize_ * 8;
+    cursorX_ = 0;
+  }
+  else if (c != '\r')
+  {
+    if (wrap_ && cursorX_ > width_ - textSize_ * 6)
+    {
+      cursorY_ += textSize_ * 8;
+      cursorX_ = 0;
+    }
+    drawChar_(cursorX_, cursorY_, c);
+    cursorX_ += textSize_ * 6;
+  }
+  return 1;
+}
+
+size_t ILI9341_t3n::write(const uint8_t *buffer, size_t size)
+{
+  if (center_)
+  {
+    // Like the library, from the text bounds: the cursor moves by half the
+    // width and half the bottom of the glyphs
+    std::string text((const char *)buffer, size);
+    cursorX_ -= strPixelLen(text.c_str()) / 2;
+    cursorY_ -= textBottom_(buffer, size) / 2;
+    center_ = false;
+  }
+  return Print::write(buffer, size);
+}
+
+void ILI9341_t3n::drawChar_(int16_t x, int16_t y, unsigned char c)
+{
+  bool opaque = textBackground_ != textColor_;
+  for (int8_t column = 0; column < 6; column++)
+  {
+    // Stand-in glyph, 5 columns of 7 pixels
+    uint8_t line = 0;
+    if (column < 5 && c > ' ')
+    {
+      uint32_t h = (c * 5 + column) * 0x9E3779B1u;
+      line = ((h >> 16) & 0x7F) | (column == 0 || column == 4 ? 0x41 : 0);
+    }
+    for (int8_t row = 0; row < 8; row++, line >>= 1)
+    {
+      if ((line & 1) || opaque)
+      {
+        uint16_t color = (line & 1) ? textColor_ : textBackground_;
+        if (textSize_ == 1)
+          drawPixel(x + column, y + row, color);
+        else
+          fillRect(x + column * textSize_, y + row * textSize_, textSize_, textSize_, color);
+      }
+    }
+  }
+}
+
+static uint32_t fetchBit(const uint8_t *p, uint32_t index)
+{
+  return p[index >> 3] & (0x80 >> (index & 7));
+}
+
+static uint32_t fetchBitsUnsigned(const uint8_t *p, uint32_t index, uint32_t required)
+{
+  uint32_t value = 0;
+  for (uint32_t i = 0; i < required; i++)
+  {
+    value = (value << 1) | (fetchBit(p, index + i) ? 1 : 0);
+  }
+  return value;
+}
+
+static int32_t fetchBitsSigned(const uint8_t *p, uint32_t index, uint32_t required)
+{
+  uint32_t value = fetchBitsUnsigned(p, index, required);
+  if (required && (value & (1 << (required - 1))))
+  {
+    return (int32_t)value - (1 << required);
+  }
+  return value;
+}
+
+bool ILI9341_t3n::glyphOf_(unsigned int c, const uint8_t *&data) const
+{
+  uint32_t index;
+  if (c >= font_->index1_first && c <= font_->index1_last)
+  {
+    index = c - font_->index1_first;
+  }
+  else if (c >= font_->index2_first && c <= font_->index2_last)
+  {
+    index = c - font_->index2_first + font_->index1_last - font_->index1_first + 1;
+  }
+  else
+  {
+    return false;
+  }
+  data = font_->data + fetchBitsUnsigned(font_->index, index * font_->bits_index, font_->bits_index);
+  return fetchBitsUnsigned(data, 0, 3) == 0; // Encoding 0 is the only one
+}
+
+void ILI9341_t3n::drawFontChar_(unsigned int c)
+{
+  const uint8_t *data;
+  if (!glyphOf_(c, data))
+    return;
+
+  uint32_t bit = 3;
+  uint32_t width = fetchBitsUnsigned(data, bit, font_->bits_width);
+  bit += font_->bits_width;
+  uint32_t height = fetchBitsUnsigned(data, bit, font_->bits_height);
+  bit += font_->bits_height;
+  int32_t xOffset = fetchBitsSigned(data, bit, font_->bits_xoffset);
+  bit += font_->bits_xoffset;
+  int32_t yOffset = fetchBitsSigned(data, bit, font_->bits_yoffset);
+  bit += font_->bits_yoffset;
+  uint32_t delta = fetchBitsUnsigned(data, bit, font_->bits_delta);
+  bit += font_->bits_delta;
+
+  if (wrap_ && cursorX_ + (int)delta > width_)
+  {
+    cursorY_ += font_->line_space;
+    cursorX_ = 0;
+  }
+
+  if (textBackground_ != textColor_)
+  {
+    fillRect(cursorX_, cursorY_, delta, font_->line_space, textBackground_);
+  }
+
+  int32_t originX = cursorX_ + xOffset;
+  int32_t y = cursorY_ + font_->cap_height - height - yOffset;
+  int32_t lines = height;
+  while (lines > 0)
+  {
+    // A line is either drawn once, or repeated 2 to 9 times
+    uint32_t repeat = 1;
+    if (fetchBit(data, bit++))
+    {
+      repeat = fetchBitsUnsigned(data, bit, 3) + 2;
+      bit += 3;
+    }
+    for (uint32_t x = 0; x < width; x++)
+    {
+      if (fetchBit(data, bit + x))
+        fillRect(originX + x, y, 1, repeat, textColor_);
+    }
+    bit += width;
+    y += repeat;
+    lines -= repeat;
+  }
+  cursorX_ += delta;
+}
+
+int16_t ILI9341_t3n::textBottom_(const uint8_t *buffer, size_t size) const
+{
+  if (!font_)
+  {
+    return textSize_ * 8;
+  }
+  int16_t bottom = 0;
+  for (size_t i = 0; i < size; i++)
+  {
+    const uint8_t *data;
+    if (!glyphOf_(buffer[i], data))
+      continue;
+    uint32_t bit = 3 + font_->bits_width + font_->bits_height;
+    int32_t yOffset = fetchBitsSigned(data, bit + font_->bits_xoffset, font_->bits_yoffset);
+    bottom = max(bottom, (int16_t)(font_->cap_height - yOffset));
+  }
+  return bottom;
+}
+
+uint16_t ILI9341_t3n::strPixelLen(const char *text)
+{
+  if (!font_)
+  {
+    return strlen(text) * textSize_ * 6;
+  }
+
+  uint16_t length = 0;
+  uint16_t widest = 0;
+  for (; *text; text++)
+  {
+    if (*text == '\n')
+    {
+      widest = max(widest, length);
+      length = 0;
+      continue;
+    }
+    const uint8_t *data;
+    if (!glyphOf_((uint8_t)*text, data))
+      continue;
+    uint32_t bit = 3 + font_->bits_width + font_->bits_height + font_->bits_xoffset + font_->bits_yoffset;
+    length += fetchBitsUnsigned(data, bit, font_->bits_delta);
+  }
+  return max(widest, length);
+}
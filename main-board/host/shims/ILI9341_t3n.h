@@ -0,0 +1,135 @@
+#pragma once
+
+#include <Arduino.h>
+
+/* ILI9341_t3n drawing into its RGB565 frame buffer, without a panel.
+ * Primitives follow the library (Adafruit GFX algorithms, packed ILI9341_t3
+ * fonts), so frames can be compared between runs. The classic 5x7 font isn't
+ * bundled: each of its glyphs is replaced by a pattern unique to the
+ * character, with the same metrics. */
+
+#define ILI9341_TFTWIDTH 240
+#define ILI9341_TFTHEIGHT 320
+
+#define ILI9341_BLACK 0x0000
+#define ILI9341_NAVY 0x000F
+#define ILI9341_DARKGREEN 0x03E0
+#define ILI9341_DARKCYAN 0x03EF
+#define ILI9341_MAROON 0x7800
+#define ILI9341_PURPLE 0x780F
+#define ILI9341_OLIVE 0x7BE0
+#define ILI9341_LIGHTGREY 0xC618
+#define ILI9341_DARKGREY 0x7BEF
+#define ILI9341_BLUE 0x001F
+#define ILI9341_GREEN 0x07E0
+#define ILI9341_CYAN 0x07FF
+#define ILI9341_RED 0xF800
+#define ILI9341_MAGENTA 0xF81F
+#define ILI9341_YELLOW 0xFFE0
+#define ILI9341_WHITE 0xFFFF
+#define ILI9341_ORANGE 0xFD20
+#define ILI9341_GREENYELLOW 0xAFE5
+#define ILI9341_PINK 0xF81F
+
+typedef struct
+{
+  const unsigned char *index;
+  const unsigned char *unicode;
+  const unsigned char *data;
+  unsigned char version;
+  unsigned char reserved;
+  unsigned char index1_first;
+  unsigned char index1_last;
+  unsigned char index2_first;
+  unsigned char index2_last;
+  unsigned char bits_index;
+  unsigned char bits_width;
+  unsigned char bits_height;
+  unsigned char bits_xoffset;
+  unsigned char bits_yoffset;
+  unsigned char bits_delta;
+  unsigned char line_space;
+  unsigned char cap_height;
+} ILI9341_t3_font_t;
+
+class ILI9341_t3n : public Print
+{
+public:
+  ILI9341_t3n(uint8_t cs, uint8_t dc, uint8_t rst = 255, uint8_t mosi = 11, uint8_t sclk = 13, uint8_t miso = 12) {}
+
+  void begin() {}
+  void setRotation(uint8_t rotation);
+  void invertDisplay(bool invert) {}
+  int16_t width() const { return width_; }
+  int16_t height() const { return height_; }
+
+  // Frame buffer, always on: the panel is never written
+  void useFrameBuffer(bool enable) {}
+  void setFrameBuffer(uint16_t *buffer) { frameBuffer_ = buffer ? buffer : ownBuffer_; }
+  uint16_t *getFrameBuffer() { return frameBuffer_; }
+  void updateScreen() {}
+  bool updateScreenAsync(bool updateContinuously = false) { return true; }
+  bool asyncUpdateActive() const { return false; }
+
+  void setClipRect(int16_t x, int16_t y, int16_t w, int16_t h);
+  void setClipRect() { setClipRect(0, 0, width_, height_); }
+
+  void drawPixel(int16_t x, int16_t y, uint16_t color);
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) { fillRect(x, y, w, 1, color); }
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) { fillRect(x, y, 1, h, color); }
+  void fillScreen(uint16_t color) { fillRect(0, 0, width_, height_, color); }
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+  void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+  void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+  void fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color);
+  void fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color);
+  void drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint16_t color);
+
+  // autoCenter: the next text printed is centered on x, y
+  void setCursor(int16_t x, int16_t y, bool autoCenter = false)
+  {
+    cursorX_ = x;
+    cursorY_ = y;
+    center_ = autoCenter;
+  }
+  int16_t getCursorX() const { return cursorX_; }
+  int16_t getCursorY() const { return cursorY_; }
+  void setTextColor(uint16_t color) { textColor_ = textBackground_ = color; }
+  void setTextColor(uint16_t color, uint16_t background)
+  {
+    textColor_ = color;
+    textBackground_ = background;
+  }
+  void setTextSize(uint8_t size) { textSize_ = size ? size : 1; }
+  void setTextWrap(bool wrap) { wrap_ = wrap; }
+  void setFont(const ILI9341_t3_font_t &font) { font_ = &font; }
+  void setFontAdafruit() { font_ = nullptr; }
+  uint16_t strPixelLen(const char *text);
+
+  size_t write(uint8_t c) override;
+  size_t write(const uint8_t *buffer, size_t size) override;
+  using Print::write;
+
+private:
+  uint16_t ownBuffer_[ILI9341_TFTWIDTH * ILI9341_TFTHEIGHT] = {};
+  uint16_t *frameBuffer_ = ownBuffer_;
+  int16_t width_ = ILI9341_TFTWIDTH;
+  int16_t height_ = ILI9341_TFTHEIGHT;
+  int16_t clipX1_ = 0, clipY1_ = 0;
+  int16_t clipX2_ = ILI9341_TFTWIDTH, clipY2_ = ILI9341_TFTHEIGHT; // Exclusive
+
+  int16_t cursorX_ = 0;
+  int16_t cursorY_ = 0;
+  uint16_t textColor_ = ILI9341_WHITE;
+  uint16_t textBackground_ = ILI9341_WHITE;
+  uint8_t textSize_ = 1;
+  bool wrap_ = true;
+  bool center_ = false;
+  const ILI9341_t3_font_t *font_ = nullptr;
+
+  void drawChar_(int16_t x, int16_t y, unsigned char c);
+  void drawFontChar_(unsigned int c);
+  bool glyphOf_(unsigned int c, const uint8_t *&data) const;
+  int16_t textBottom_(const uint8_t *buffer, size_t size) const;
+  void fillCircleHelper_(int16_t x0, int16_t y0, int16_t r, uint8_t corners, int16_t delta, uint16_t color);
+};
@@ -0,0 +1,9 @@
+// Globals of the shimmed libraries
+#include <Wire.h>
+#include <SPI.h>
+#include <MTP_Teensy.h>
+
+TwoWire Wire;
+TwoWire Wire1;
+SPIClass SPI;
+MTP_class MTP;
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <Arduino.h>
+#include <SD.h>
+
+// USB MTP has no host counterpart, only the settings are kept
+class MTPStorage
+{
+public:
+  uint32_t get_DeltaDeviceCheckTimeMS() const { return deltaDeviceCheckTimeMS_; }
+  void set_DeltaDeviceCheckTimeMS(uint32_t ms) { deltaDeviceCheckTimeMS_ = ms; }
+
+private:
+  uint32_t deltaDeviceCheckTimeMS_ = 1000;
+};
+
+class MTP_class
+{
+public:
+  bool begin() { return true; }
+  void addFilesystem(SDClass &disk, const char *name) {}
+  void loop() {}
+  MTPStorage *storage() { return &storage_; }
+
+private:
+  MTPStorage storage_;
+};
+
+extern MTP_class MTP;
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include "WString.h"
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+class Print
+{
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t *buffer, size_t size);
+  size_t write(const char *text) { return write((const uint8_t *)text, strlen(text)); }
+  size_t write(const char *buffer, size_t size) { return write((const uint8_t *)buffer, size); }
+  virtual int availableForWrite() { return 0; }
+
+  size_t print(const char *text) { return write(text); }
+  size_t print(const String &text) { return write(text.c_str()); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(unsigned char value, int base = DEC) { return printNumber_(value, base, false); }
+  size_t print(int value, int base = DEC) { return printNumber_(value, base, true); }
+  size_t print(unsigned int value, int base = DEC) { return printNumber_(value, base, false); }
+  size_t print(long value, int base = DEC) { return printNumber_(value, base, true); }
+  size_t print(unsigned long value, int base = DEC) { return printNumber_(value, base, false); }
+  size_t print(double value, int digits = 2);
+
+  size_t println() { return write("\r\n"); }
+  template <class T>
+  size_t println(const T &value)
+  {
+    size_t written = print(value);
+    return written + println();
+  }
+  template <class T>
+  size_t println(const T &value, int format)
+  {
+    size_t written = print(value, format);
+    return written + println();
+  }
+
+  int printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+
+private:
+  size_t printNumber_(long long value, int base, bool isSigned);
+};
+
+class Stream : public Print
+{
+public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() = 0;
+};
@@ -0,0 +1,177 @@
+#include "SD.h"
+#include <dirent.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+struct File::State
+{
+  ~State()
+  {
+    if (fp)
+      fclose(fp);
+    if (dir)
+      closedir(dir);
+  }
+  std::string path;
+  std::string name;
+  FILE *fp = nullptr;
+  DIR *dir = nullptr;
+};
+
+static File::State *openState(const std::string &path, uint8_t mode)
+{
+  struct stat info;
+  bool exists = stat(path.c_str(), &info) == 0;
+  File::State *state = new File::State;
+  state->path = path;
+  size_t slash = path.find_last_of('/');
+  state->name = slash == std::string::npos ? path : path.substr(slash + 1);
+
+  if (exists && S_ISDIR(info.st_mode))
+  {
+    state->dir = opendir(path.c_str());
+  }
+  else if (mode == FILE_WRITE)
+  {
+    state->fp = fopen(path.c_str(), exists ? "r+b" : "w+b");
+    if (state->fp)
+      fseek(state->fp, 0, SEEK_END);
+  }
+  else if (exists)
+  {
+    state->fp = fopen(path.c_str(), "rb");
+  }
+
+  if (!state->fp && !state->dir)
+  {
+    delete state;
+    return nullptr;
+  }
+  return state;
+}
+
+size_t File::write(const uint8_t *buffer, size_t size)
+{
+  if (!state_ || !state_->fp)
+    return 0;
+  return fwrite(buffer, 1, size, state_->fp);
+}
+
+int File::available()
+{
+  if (!state_ || !state_->fp)
+    return 0;
+  return size() - position();
+}
+
+int File::read()
+{
+  uint8_t c;
+  return read(&c, 1) == 1 ? c : -1;
+}
+
+int File::read(void *buffer, size_t size)
+{
+  if (!state_ || !state_->fp)
+    return -1;
+  return fread(buffer, 1, size, state_->fp);
+}
+
+int File::peek()
+{
+  if (!state_ || !state_->fp)
+    return -1;
+  int c = fgetc(state_->fp);
+  if (c != EOF)
+    ungetc(c, state_->fp);
+  return c == EOF ? -1 : c;
+}
+
+bool File::seek(uint64_t position)
+{
+  return state_ && state_->fp && fseek(state_->fp, position, SEEK_SET) == 0;
+}
+
+uint64_t File::position() const
+{
+  return state_ && state_->fp ? ftell(state_->fp) : 0;
+}
+
+uint64_t File::size() const
+{
+  if (!state_ || !state_->fp)
+    return 0;
+  fflush(state_->fp);
+  struct stat info;
+  return fstat(fileno(state_->fp), &info) == 0 ? info.st_size : 0;
+}
+
+void File::flush()
+{
+  if (state_ && state_->fp)
+    fflush(state_->fp);
+}
+
+const char *File::name() const { return state_ ? state_->name.c_str() : ""; }
+
+bool File::isDirectory() const { return state_ && state_->dir; }
+
+File File::openNextFile(uint8_t mode)
+{
+  File next;
+  if (!isDirectory())
+    return next;
+  while (struct dirent *entry = readdir(state_->dir))
+  {
+    if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0)
+      continue;
+    next.state_.reset(openState(state_->path + "/" + entry->d_name, mode));
+    if (next)
+      break;
+  }
+  return next;
+}
+
+void File::rewindDirectory()
+{
+  if (isDirectory())
+    rewinddir(state_->dir);
+}
+
+SDClass SD;
+
+bool SDClass::begin(uint8_t csPin)
+{
+  struct stat info;
+  mounted_ = !root_.empty() && stat(root_.c_str(), &info) == 0 && S_ISDIR(info.st_mode);
+  return mounted_;
+}
+
+std::string SDClass::hostPath_(const char *path) const
+{
+  std::string relative = path;
+  while (!relative.empty() && relative.front() == '/')
+    relative.erase(0, 1);
+  while (relative.size() > 1 && relative.back() == '/')
+    relative.pop_back();
+  return relative.empty() ? root_ : root_ + "/" + relative;
+}
+
+bool SDClass::exists(const char *path)
+{
+  struct stat info;
+  return mounted_ && stat(hostPath_(path).c_str(), &info) == 0;
+}
+
+File SDClass::open(const char *path, uint8_t mode)
+{
+  File file;
+  if (mounted_)
+    file.state_.reset(openState(hostPath_(path), mode));
+  return file;
+}
+
+bool SDClass::remove(const char *path) { return mounted_ && unlink(hostPath_(path).c_str()) == 0; }
+bool SDClass::mkdir(const char *path) { return mounted_ && ::mkdir(hostPath_(path).c_str(), 0755) == 0; }
+bool SDClass::rmdir(const char *path) { return mounted_ && ::rmdir(hostPath_(path).c_str()) == 0; }
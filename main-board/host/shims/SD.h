@@ -0,0 +1,62 @@
+#pragma once
+
+#include <Arduino.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#define FILE_READ 0
+#define FILE_WRITE 1 // Appends, like O_RDWR | O_CREAT | O_AT_END
+
+// A file or directory in the host directory standing in for the card
+class File : public Stream
+{
+public:
+  File() {}
+  explicit operator bool() const { return state_ != nullptr; }
+
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t *buffer, size_t size) override;
+  using Print::write;
+  int available() override;
+  int read() override;
+  int read(void *buffer, size_t size);
+  int peek() override;
+  bool seek(uint64_t position);
+  uint64_t position() const;
+  uint64_t size() const;
+  void flush();
+  void close() { state_.reset(); }
+
+  const char *name() const;
+  bool isDirectory() const;
+  File openNextFile(uint8_t mode = FILE_READ);
+  void rewindDirectory();
+
+  struct State;
+
+private:
+  friend class SDClass;
+  std::shared_ptr<State> state_;
+};
+
+class SDClass
+{
+public:
+  // Fails unless the host gave a directory, see hostSetRoot()
+  bool begin(uint8_t csPin);
+  bool exists(const char *path);
+  File open(const char *path, uint8_t mode = FILE_READ);
+  bool remove(const char *path);
+  bool mkdir(const char *path);
+  bool rmdir(const char *path);
+
+  void hostSetRoot(const char *directory) { root_ = directory ? directory : ""; }
+
+private:
+  std::string root_;
+  bool mounted_ = false;
+  std::string hostPath_(const char *path) const;
+};
+
+extern SDClass SD;
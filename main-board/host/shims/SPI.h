@@ -0,0 +1,24 @@
+#pragma once
+
+#include <Arduino.h>
+
+#define MSBFIRST 1
+#define SPI_MODE0 0
+
+struct SPISettings
+{
+  SPISettings(uint32_t clock, uint8_t bitOrder, uint8_t dataMode) {}
+};
+
+class SPIClass
+{
+public:
+  void begin() {}
+  void setMOSI(uint8_t pin) {}
+  void setMISO(uint8_t pin) {}
+  void setSCK(uint8_t pin) {}
+  void beginTransaction(const SPISettings &settings) {}
+  void endTransaction() {}
+};
+
+extern SPIClass SPI;
@@ -0,0 +1,98 @@
+#include "TimeLib.h"
+
+static getExternalTime syncProvider = nullptr;
+static time_t setSeconds = 0;
+static uint32_t setAtMillis = 0;
+static timeStatus_t status = timeNotSet;
+
+time_t now()
+{
+  // Reads the provider every time, the library caches it for 5 minutes
+  if (syncProvider)
+  {
+    time_t t = syncProvider();
+    if (t)
+    {
+      setTime(t);
+    }
+  }
+  return setSeconds + (millis() - setAtMillis) / 1000;
+}
+
+void setTime(time_t t)
+{
+  setSeconds = t;
+  setAtMillis = millis();
+  status = timeSet;
+}
+
+void setTime(int hour, int minute, int second, int day, int month, int year)
+{
+  tmElements_t elements;
+  elements.Second = second;
+  elements.Minute = minute;
+  elements.Hour = hour;
+  elements.Day = day;
+  elements.Month = month;
+  elements.Year = year > 99 ? CalendarYrToTm(year) : year + 30; // Like the library, yy is from 2000
+  setTime(makeTime(elements));
+}
+
+void setSyncProvider(getExternalTime provider)
+{
+  syncProvider = provider;
+  now();
+}
+
+timeStatus_t timeStatus()
+{
+  now();
+  return status;
+}
+
+time_t makeTime(const tmElements_t &elements)
+{
+  struct tm t = {};
+  t.tm_sec = elements.Second;
+  t.tm_min = elements.Minute;
+  t.tm_hour = elements.Hour;
+  t.tm_mday = elements.Day;
+  t.tm_mon = elements.Month - 1;
+  t.tm_year = tmYearToCalendar(elements.Year) - 1900;
+  return timegm(&t);
+}
+
+void breakTime(time_t t, tmElements_t &elements)
+{
+  struct tm broken;
+  gmtime_r(&t, &broken);
+  elements.Second = broken.tm_sec;
+  elements.Minute = broken.tm_min;
+  elements.Hour = broken.tm_hour;
+  elements.Wday = broken.tm_wday + 1;
+  elements.Day = broken.tm_mday;
+  elements.Month = broken.tm_mon + 1;
+  elements.Year = CalendarYrToTm(broken.tm_year + 1900);
+}
+
+static tmElements_t elementsOf(time_t t)
+{
+  tmElements_t elements;
+  breakTime(t, elements);
+  return elements;
+}
+
+int hour() { return hour(now()); }
+int hour(time_t t) { return elementsOf(t).Hour; }
+int minute() { return minute(now()); }
+int minute(time_t t) { return elementsOf(t).Minute; }
+int second() { return second(now()); }
+int second(time_t t) { return elementsOf(t).Second; }
+int day() { return day(now()); }
+int day(time_t t) { return elementsOf(t).Day; }
+int weekday() { return weekday(now()); }
+int weekday(time_t t) { return elementsOf(t).Wday; }
+int month() { return month(now()); }
+int month(time_t t) { return elementsOf(t).Month; }
+int year() { return year(now()); }
+int year(time_t t) { return tmYearToCalendar(elementsOf(t).Year); }
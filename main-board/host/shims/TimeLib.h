@@ -0,0 +1,51 @@
+#pragma once
+
+#include <Arduino.h>
+#include <time.h>
+
+// Subset of the Time library, on the virtual clock
+enum timeStatus_t
+{
+  timeNotSet,
+  timeNeedsSync,
+  timeSet
+};
+
+struct tmElements_t
+{
+  uint8_t Second;
+  uint8_t Minute;
+  uint8_t Hour;
+  uint8_t Wday; // Sunday is day 1
+  uint8_t Day;
+  uint8_t Month;
+  uint8_t Year; // Offset from 1970
+};
+
+#define tmYearToCalendar(Y) ((Y) + 1970)
+#define CalendarYrToTm(Y) ((Y) - 1970)
+
+typedef time_t (*getExternalTime)();
+
+time_t now();
+void setTime(time_t t);
+void setTime(int hour, int minute, int second, int day, int month, int year);
+void setSyncProvider(getExternalTime provider);
+timeStatus_t timeStatus();
+time_t makeTime(const tmElements_t &elements);
+void breakTime(time_t t, tmElements_t &elements);
+
+int hour();
+int hour(time_t t);
+int minute();
+int minute(time_t t);
+int second();
+int second(time_t t);
+int day();
+int day(time_t t);
+int weekday();
+int weekday(time_t t);
+int month();
+int month(time_t t);
+int year();
+int year(time_t t);
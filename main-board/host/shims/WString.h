@@ -0,0 +1,118 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <string>
+
+// Arduino String on top of std::string
+class String
+{
+public:
+  String() {}
+  String(const char *text) : text_(text ? text : "") {}
+  String(const std::string &text) : text_(text) {}
+  explicit String(char c) : text_(1, c) {}
+  explicit String(unsigned char value, unsigned char base = 10) : text_(format_(value, base)) {}
+  explicit String(int value, unsigned char base = 10) : text_(format_(value, base)) {}
+  explicit String(unsigned int value, unsigned char base = 10) : text_(format_(value, base)) {}
+  explicit String(long value, unsigned char base = 10) : text_(format_(value, base)) {}
+  explicit String(unsigned long value, unsigned char base = 10) : text_(format_(value, base)) {}
+  explicit String(float value, unsigned char decimals = 2);
+  explicit String(double value, unsigned char decimals = 2);
+
+  const char *c_str() const { return text_.c_str(); }
+  unsigned int length() const { return text_.size(); }
+  bool reserve(unsigned int size)
+  {
+    text_.reserve(size);
+    return true;
+  }
+
+  char operator[](unsigned int index) const { return index < text_.size() ? text_[index] : 0; }
+  char &operator[](unsigned int index) { return text_[index]; }
+  char charAt(unsigned int index) const { return (*this)[index]; }
+  void setCharAt(unsigned int index, char c)
+  {
+    if (index < text_.size())
+      text_[index] = c;
+  }
+
+  String &operator+=(const String &other)
+  {
+    text_ += other.text_;
+    return *this;
+  }
+  String &operator+=(const char *other)
+  {
+    text_ += other;
+    return *this;
+  }
+  String &operator+=(char c)
+  {
+    text_ += c;
+    return *this;
+  }
+  String &operator+=(int value) { return *this += String(value); }
+  String &operator+=(unsigned int value) { return *this += String(value); }
+  String &operator+=(long value) { return *this += String(value); }
+  String &operator+=(unsigned long value) { return *this += String(value); }
+  bool concat(const String &other)
+  {
+    *this += other;
+    return true;
+  }
+
+  friend String operator+(const String &a, const String &b) { return String(a.text_ + b.text_); }
+  friend String operator+(const String &a, const char *b) { return String(a.text_ + b); }
+  friend String operator+(const char *a, const String &b) { return String(a + b.text_); }
+  friend String operator+(const String &a, char b) { return String(a.text_ + b); }
+  friend String operator+(const String &a, int b) { return a + String(b); }
+  friend String operator+(const String &a, unsigned int b) { return a + String(b); }
+  friend String operator+(const String &a, long b) { return a + String(b); }
+  friend String operator+(const String &a, unsigned long b) { return a + String(b); }
+
+  bool operator==(const String &other) const { return text_ == other.text_; }
+  bool operator==(const char *other) const { return text_ == other; }
+  bool operator!=(const String &other) const { return text_ != other.text_; }
+  bool operator!=(const char *other) const { return text_ != other; }
+  bool operator<(const String &other) const { return text_ < other.text_; }
+  bool equals(const String &other) const { return text_ == other.text_; }
+  bool equalsIgnoreCase(const String &other) const { return strcasecmp(c_str(), other.c_str()) == 0; }
+  int compareTo(const String &other) const { return text_.compare(other.text_); }
+  bool startsWith(const String &prefix) const { return text_.compare(0, prefix.text_.size(), prefix.text_) == 0; }
+  bool endsWith(const String &suffix) const
+  {
+    return text_.size() >= suffix.text_.size() &&
+           text_.compare(text_.size() - suffix.text_.size(), suffix.text_.size(), suffix.text_) == 0;
+  }
+
+  int indexOf(char c, unsigned int from = 0) const { return npos_(text_.find(c, from)); }
+  int indexOf(const String &other, unsigned int from = 0) const { return npos_(text_.find(other.text_, from)); }
+  int lastIndexOf(char c) const { return npos_(text_.rfind(c)); }
+  int lastIndexOf(const String &other) const { return npos_(text_.rfind(other.text_)); }
+  String substring(unsigned int from) const { return from < text_.size() ? String(text_.substr(from)) : String(); }
+  String substring(unsigned int from, unsigned int to) const;
+
+  void toUpperCase();
+  void toLowerCase();
+  void trim();
+  void replace(const String &from, const String &to);
+  void remove(unsigned int index) { remove(index, text_.size()); }
+  void remove(unsigned int index, unsigned int count);
+  long toInt() const { return strtol(c_str(), nullptr, 10); }
+  float toFloat() const { return strtof(c_str(), nullptr); }
+
+private:
+  std::string text_;
+
+  static std::string format_(unsigned long long value, unsigned char base);
+  static std::string format_(long long value, unsigned char base);
+  static std::string format_(int value, unsigned char base) { return format_((long long)value, base); }
+  static std::string format_(long value, unsigned char base) { return format_((long long)value, base); }
+  static std::string format_(unsigned char value, unsigned char base) { return format_((unsigned long long)value, base); }
+  static std::string format_(unsigned int value, unsigned char base) { return format_((unsigned long long)value, base); }
+  static std::string format_(unsigned long value, unsigned char base) { return format_((unsigned long long)value, base); }
+  static int npos_(size_t position) { return position == std::string::npos ? -1 : (int)position; }
+};
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Every host build uses the simulated bus (I2C_SIMULATED_BUS), the wire
+// itself never answers
+class TwoWire
+{
+public:
+  void begin() {}
+  void end() {}
+  void setClock(uint32_t frequency) {}
+  void setSDA(uint8_t pin) {}
+  void setSCL(uint8_t pin) {}
+  void beginTransmission(uint8_t address) {}
+  size_t write(uint8_t data) { return 1; }
+  uint8_t endTransmission(uint8_t sendStop = 1) { return 2; } // Address NACK
+  uint8_t requestFrom(uint8_t address, uint8_t quantity, uint8_t sendStop = 1) { return 0; }
+  int available() { return 0; }
+  int read() { return -1; }
+};
+
+extern TwoWire Wire;
+extern TwoWire Wire1;
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <Audio.h>
+
+// Resampling input of alex6679/teensy-4-async-inputs, nothing to resample here
+template <class TInput>
+class AsyncAudioInput : public AudioStream
+{
+public:
+  template <class... Args>
+  AsyncAudioInput(Args... args) {}
+};
@@ -0,0 +1,7 @@
+#pragma once
+
+#include <Audio.h>
+
+class AsyncAudioInputI2S2_16bitslave : public AudioStream
+{
+};
@@ -31,9 +31,9 @@ public:
   virtual void handleControl(ControlCommand cmd) = 0;
 
   // Virtual methods with default implementations
-  virtual void setMixerGains();
+  // Mixer gains, codec and bitcrusher from AUDIO_PROFILES
+  virtual void applyAudioProfile();
   virtual void updateOutputVolume();
-  virtual void configureCodec();
   virtual AudioAnalyzePeak *getPeak();
   virtual AudioModeTheme& getTheme() { return theme; }
   virtual void playBeep() { audio.getMemoryPlayer()->play(beep); }
@@ -31,8 +31,6 @@ public:
   void frameLoop() override;
   void handleOrangeButton(bool pressed) override;
   void handleControl(ControlCommand cmd) override;
-  void setMixerGains() override;
-  void configureCodec() override;
   void parseMetadataFromFilename(const char *filename, char *title, char *author);
 
   AudioMode getMode() override
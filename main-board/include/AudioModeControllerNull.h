@@ -14,5 +14,5 @@ public:
   void handleOrangeButton(bool pressed) override {}
   void handleControl(ControlCommand cmd) override {}
   void updateOutputVolume() override {}
-  void setMixerGains() override {}
+  void applyAudioProfile() override {}
 };
\ No newline at end of file
@@ -40,7 +40,6 @@ public:
   void handleOrangeButton(bool pressed) override;
   void handleControl(ControlCommand cmd) override {};
   void updateOutputVolume() override {};
-  void setMixerGains() override;
   AudioMode getMode() override { return MODE_PONG; }
   AudioAnalyzePeak *getPeak() override { return nullptr; }
 
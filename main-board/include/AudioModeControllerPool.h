@@ -0,0 +1,59 @@
+#pragma once
+
+#include <new>
+#include <utility>
+#include "AudioModeController.h"
+#include "AudioModeControllerBluetooth.h"
+#include "AudioModeControllerNFCPlayer.h"
+#include "AudioModeControllerPong.h"
+#include "AudioModeControllerRadio.h"
+#include "AudioModeControllerSDPlayer.h"
+#include "AudioModeControllerSDRecorder.h"
+#include "AudioModeControllerTimeSetup.h"
+
+namespace detail
+{
+  // A static member couldn't be called from SIZE, the class is incomplete there
+  constexpr size_t maxOf(size_t a, size_t b) { return a > b ? a : b; }
+}
+
+/* Statically allocated slot for the active mode controller.
+ * Only one controller is alive at a time, so every mode is built in the same
+ * storage with placement new: switching modes never touches the heap. */
+class AudioModeControllerPool
+{
+public:
+  ~AudioModeControllerPool() { release(); }
+
+  // Destroys the current controller and builds a T in its place
+  template <typename T, typename... Args>
+  T *create(Args &&...args)
+  {
+    static_assert(sizeof(T) <= SIZE, "Controller too big for the pool");
+    static_assert(alignof(T) <= ALIGNMENT, "Controller alignment not supported by the pool");
+    release();
+    T *controller = new (storage_) T(std::forward<Args>(args)...);
+    current_ = controller;
+    return controller;
+  }
+
+  void release()
+  {
+    if (current_ != nullptr)
+    {
+      current_->~AudioModeController();
+      current_ = nullptr;
+    }
+  }
+
+private:
+  static constexpr size_t SIZE =
+      detail::maxOf(detail::maxOf(detail::maxOf(sizeof(AudioModeControllerBluetooth), sizeof(AudioModeControllerNFCPlayer)),
+                                  detail::maxOf(sizeof(AudioModeControllerPong), sizeof(AudioModeControllerRadio))),
+                    detail::maxOf(detail::maxOf(sizeof(AudioModeControllerSDPlayer), sizeof(AudioModeControllerSDRecorder)),
+                                  sizeof(AudioModeControllerTimeSetup)));
+  static constexpr size_t ALIGNMENT = alignof(max_align_t);
+
+  alignas(ALIGNMENT) uint8_t storage_[SIZE];
+  AudioModeController *current_ = nullptr;
+};
@@ -10,6 +10,11 @@ private:
   elapsedMillis orangeButtonTimer;
   bool orangeButtonPressed = false;
   unsigned int freq;
+  uint16_t sweepFreq = 0; // Channel shown while seeking or scanning
+  static const uint8_t SCAN_MAX_VOLUME = 3; // Below this the band scan can run
+  static const bool SHOW_SIGNAL_BAR = true; // Signal bars and stereo indicator next to the mode title
+  uint8_t signalBars = 0xFF;                // Last drawn, 0xFF to redraw
+  bool signalStereo = false;
 
 public:
   AudioModeControllerRadio(Display &display, I2C &i2c, AudioSystem &audio, FM &radio)
@@ -38,5 +43,4 @@ public:
   void frameLoop() override;
   void handleOrangeButton(bool pressed) override;
   void handleControl(ControlCommand cmd) override;
-  void setMixerGains() override;
 };
\ No newline at end of file
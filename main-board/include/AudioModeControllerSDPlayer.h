@@ -36,6 +36,4 @@ public:
   void frameLoop() override;
   void handleOrangeButton(bool pressed) override;
   void handleControl(ControlCommand cmd) override;
-  void setMixerGains() override;
-  void configureCodec() override;
 };
\ No newline at end of file
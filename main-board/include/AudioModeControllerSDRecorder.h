@@ -34,8 +34,6 @@ public:
   void frameLoop() override;
   void handleOrangeButton(bool pressed) override;
   void handleControl(ControlCommand cmd) override;
-  void setMixerGains() override;
-  void configureCodec() override;
   // void updateOutputVolume() override;
   AudioAnalyzePeak *getPeak() override;
 };
@@ -1,11 +1,13 @@
 #pragma once
 
 #include "AudioModeController.h"
+#include "FM.h"
 
 class AudioModeControllerTimeSetup : public AudioModeController
 {
 public:
-  AudioModeControllerTimeSetup(Display &display, I2C &i2c, AudioSystem &audio) : AudioModeController(display, i2c, audio) {}
+  AudioModeControllerTimeSetup(Display &display, I2C &i2c, AudioSystem &audio, FM &radio)
+      : AudioModeController(display, i2c, audio), radio(radio) {}
 
   void enter() override;
   void exit() override;
@@ -17,6 +19,9 @@ public:
   bool isTimeSetComplete() { return timeSetComplete; }
 
 private:
+  FM &radio; // Muted, listened to for RDS clock time
+  bool timeFromRadio = false;
+
   enum SetupStage
   {
     YEAR,
@@ -36,4 +41,5 @@ private:
   const char *getStageInstructions();
   int getMaxValueForStage();
   int getMinValueForStage();
+  void updateRadioTime();
 };
\ No newline at end of file
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <stdint.h>
+#include "AudioMode.h"
+
+// Same values as AUDIO_INPUT_LINEIN / AUDIO_INPUT_MIC in control_sgtl5000.h
+#define AUDIO_PROFILE_LINEIN 0
+#define AUDIO_PROFILE_MIC 1
+
+/* Audio graph settings of a mode, applied by AudioSystem::applyProfile().
+ * The output amplifier isn't part of it, it follows the volume pot. */
+struct AudioProfile
+{
+  float monoGains[4];  // BT L, BT R, radio L, radio R
+  float mainGains[4];  // BT or radio, SD card L, SD card R, in memory audio
+  float fftGains[2];   // BT/SD/radio source, mic source
+  float codecVolume;
+  bool bassEnhance;
+  uint8_t input;       // AUDIO_PROFILE_LINEIN or AUDIO_PROFILE_MIC
+  uint8_t inputLevel;  // lineInLevel() or micGain() (dB), depending on input
+  uint8_t bits;        // Bitcrusher, the tone pot overrides it outside of Pong
+  uint16_t sampleRate;
+};
+
+// Indexed by AudioMode
+constexpr AudioProfile AUDIO_PROFILES[] = {
+    // MODE_TIME_SETUP, radio stays muted
+    {{0.0, 0.0, 0.0, 0.0}, {0.0, 0.0, 0.0, 0.4}, {1.0, 0.0}, 0.6, true, AUDIO_PROFILE_LINEIN, 8, 16, 44100},
+    // MODE_BLUETOOTH
+    {{0.9, 0.1, 0.0, 0.0}, {1.0, 0.0, 0.0, 0.6}, {1.0, 0.0}, 0.6, true, AUDIO_PROFILE_LINEIN, 8, 16, 44100},
+    // MODE_RADIO
+    {{0.0, 0.0, 0.5, 0.5}, {1.0, 0.0, 0.0, 0.5}, {1.0, 0.0}, 0.6, true, AUDIO_PROFILE_LINEIN, 8, 16, 44100},
+    // MODE_SD_PLAYBACK
+    {{0.0, 0.0, 0.0, 0.0}, {0.0, 0.5, 0.5, 0.3}, {1.0, 0.0}, 0.8, false, AUDIO_PROFILE_LINEIN, 8, 16, 44100},
+    // MODE_SD_RECORDER
+    {{0.0, 0.0, 0.0, 0.0}, {0.0, 0.0, 0.0, 0.4}, {0.0, 1.0}, 0.8, false, AUDIO_PROFILE_MIC, 20, 16, 44100},
+    // MODE_NFC_PLAYBACK
+    {{0.0, 0.0, 0.0, 0.0}, {0.0, 0.4, 0.4, 0.4}, {1.0, 0.0}, 0.65, true, AUDIO_PROFILE_LINEIN, 8, 16, 44100},
+    // MODE_PONG
+    {{0.0, 0.0, 0.0, 0.0}, {0.0, 0.0, 0.0, 0.4}, {1.0, 0.0}, 0.6, true, AUDIO_PROFILE_LINEIN, 8, 8, 11025},
+};
+
+static_assert(sizeof(AUDIO_PROFILES) / sizeof(AUDIO_PROFILES[0]) == MODE_PONG + 1,
+              "One audio profile per mode");
+
+constexpr const AudioProfile &audioProfileFor(AudioMode mode)
+{
+  return AUDIO_PROFILES[mode == MODE_UNKNOWN ? MODE_TIME_SETUP : mode];
+}
@@ -3,6 +3,7 @@
 #include <Audio.h>
 #include "async_input.h"
 #include "input_i2s2_16bit.h"
+#include "AudioProfiles.h"
 
 class AudioSystem {
 public:
@@ -11,6 +12,16 @@ public:
 
     void setBandValue(int band, float value);
     float getBandValue(int band) const;
+
+    // Applies a mode profile. Only what differs from the current state is
+    // written, mixer gains ramp to their new value over RAMP_BLOCKS blocks.
+    void applyProfile(const AudioProfile &profile);
+    void setOutputGain(float gain, bool ramp = true);
+    void setBitcrusher(uint8_t bits, uint16_t sampleRate);
+    // Steps the gain ramps, call from loop()
+    void update();
+    bool isRamping() const;
+
     // Getters for audio components
     AudioPlayMemory* getMemoryPlayer() { return &playMem1; }
     AudioPlaySdWav* getWavPlayer() { return &playSdWav1; }
@@ -19,17 +30,43 @@ public:
     AudioAnalyzePeak* getRecorderPeak() { return &recorderPeak; }
     AudioAnalyzeFFT1024* getFFT() { return &fft1024_1; }
     AudioControlSGTL5000* getCodec() { return &sgtl5000_1; }
-    AudioAmplifier* getOutputAmp() { return &outputAmp; }
-    AudioEffectBitcrusher* getBitcrusher() { return &bitcrusher1; }
-    AudioMixer4* getMainMixer() { return &mixerMain; }
-    AudioMixer4* getMonoDownmixer() { return &mixerMonoDownmix; }
-    AudioMixer4* getFFTInputMixer() { return &mixerFFTInput; }
     AsyncAudioInput<AsyncAudioInputI2S2_16bitslave>* getBluetoothInput() { return &i2sBluetoothSink; }
     AudioFilterBiquad* getBiquad1() { return &biquad1; }
     AudioFilterBiquad* getBiquad2() { return &biquad2; }
     AudioAmplifier* getRecorderAmp() { return &recorderAmp; }
 
 private:
+    // Ramped gains, in this order
+    static const uint8_t GAIN_MONO = 0;
+    static const uint8_t GAIN_MAIN = 4;
+    static const uint8_t GAIN_FFT = 8;
+    static const uint8_t GAIN_OUTPUT = 10;
+    static const uint8_t GAIN_COUNT = 11;
+    static const uint8_t RAMP_BLOCKS = 4;
+    // One audio block, 128 samples at 44.1kHz
+    static const uint32_t BLOCK_US = AUDIO_BLOCK_SAMPLES * 1000000ULL / 44100;
+
+    struct GainRamp
+    {
+        float current;
+        float target;
+        float step; // Per block
+    };
+
+    GainRamp gains_[GAIN_COUNT];
+    uint32_t lastRampUpdate_ = 0;
+
+    // Last values written to the codec, a negative value is unknown
+    float codecVolume_ = -1;
+    int8_t bassEnhance_ = -1;
+    int8_t input_ = -1;
+    uint8_t inputLevel_ = 0;
+    uint8_t bits_ = 0;
+    uint16_t sampleRate_ = 0;
+
+    void setGain_(uint8_t index, float gain, bool ramp);
+    void writeGain_(uint8_t index, float gain);
+
     // Audio components
     AudioPlayMemory playMem1;
     AudioInputI2S i2sLineInput;
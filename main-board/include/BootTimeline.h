@@ -0,0 +1,31 @@
+#pragma once
+
+#include <Arduino.h>
+
+/* Timestamps of the start-up phases, in ms since reset.
+ * Phase names must be string literals, only the pointer is kept. */
+class BootTimeline
+{
+public:
+  static const uint8_t MAX_PHASES = 20;
+
+  void mark(const char *phase) { markAt(phase, millis()); }
+  // For phases timed elsewhere
+  void markAt(const char *phase, unsigned long time);
+
+  uint8_t size() const { return count_; }
+  const char *nameAt(uint8_t index) const { return phases_[index].name; }
+  unsigned long timeAt(uint8_t index) const { return phases_[index].time; }
+
+  void print(Print &out) const;
+
+private:
+  struct Phase
+  {
+    const char *name;
+    unsigned long time;
+  };
+
+  Phase phases_[MAX_PHASES];
+  uint8_t count_ = 0;
+};
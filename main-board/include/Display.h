@@ -1,6 +1,9 @@
 #pragma once
 #include <ILI9341_t3n.h>
 #include "AudioMode.h"
+#include "DisplayBackend.h"
+
+class BootTimeline;
 
 #define TFT_RST 255
 #define TFT_DC 9 // Was 3 on the original build
@@ -23,6 +26,8 @@ public:
 
   ILI9341_t3n tft;
 
+  // Frames go to the panel unless another backend is set before init()
+  void setBackend(DisplayBackend &backend) { this->backend = &backend; }
   void init();
   void update();
   void updateAsync();
@@ -30,7 +35,12 @@ public:
   void drawModeTitle(AudioMode mode);
   void drawRecIcon(bool recording);
   void drawBtIcon(bool connected);
+  void drawSignalBar(uint8_t bars, uint8_t maxBars, bool stereo);
+  void drawProgressBar(uint32_t position, uint32_t duration); // Below the metadata, nothing if the duration is 0
   void debugText(char *msg);
+  void drawI2CStats(); // Debug overlay with the I2C bus counters
+  void drawBootTimeline(const BootTimeline &timeline); // Debug overlay with the start-up phases
+  void drawPerfHud(const char *line); // Strip above the title bar, "" clears it
   void clampAndPrint(const char *text, int maxWidth = 290);
   void setMetadata(const char *textBig, const char *textSmall);
   void drawSplash();
@@ -41,6 +51,8 @@ public:
   void setTemporaryMetadata(const char *line1, const char *line2, unsigned long duration);
   void clearTemporaryMetadata();
   bool hasTemporaryMetadata() const;
+  // Frame buffer pushes to the panel
+  uint32_t getPushCount() const { return pushCount; }
   void setTheme(AudioModeTheme theme)
   {
     this->theme = theme;
@@ -63,6 +75,8 @@ public:
   }
 
 private:
+  DisplayBackend *backend;
+
   void handleSplashScreen();
   void drawSplashPart(bool redParts, bool cyanParts);
   unsigned long splashStartTime;
@@ -74,6 +88,7 @@ private:
   int redBlinks = 0;
   int textBlinks = 0;
   bool needsUpdate = false;
+  uint32_t pushCount = 0;
   char tempMetadataLine1[32];
   char tempMetadataLine2[32];
   bool temporaryMetadataActive;
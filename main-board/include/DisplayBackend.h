@@ -0,0 +1,30 @@
+#pragma once
+#include <ILI9341_t3n.h>
+
+/* Where the frames drawn by Display go.
+ * Drawing always happens in the RGB565 frame buffer of Display::tft, a backend
+ * only brings up its output and pushes the finished frames to it. */
+class DisplayBackend
+{
+public:
+  virtual ~DisplayBackend() = default;
+
+  virtual void begin(ILI9341_t3n &tft) = 0;
+  // Returns once the frame is out
+  virtual void push(ILI9341_t3n &tft) = 0;
+  // Starts a push that completes in the background, false while the previous one runs
+  virtual bool pushAsync(ILI9341_t3n &tft) = 0;
+};
+
+// The ILI9341 IPS panel over SPI
+class PanelBackend : public DisplayBackend
+{
+public:
+  void begin(ILI9341_t3n &tft) override
+  {
+    tft.begin();
+    tft.invertDisplay(true); // True for IPS display
+  }
+  void push(ILI9341_t3n &tft) override { tft.updateScreen(); }
+  bool pushAsync(ILI9341_t3n &tft) override { return tft.updateScreenAsync(false); }
+};
@@ -4,39 +4,110 @@
 #include "../lib/RDA5807/src/RDA5807.h"
 #include "Log.h"
 #include "I2CTimer.h"
+#include "RDSDecoder.h"
+#include "RDSClockSync.h"
+#include "StationList.h"
+#include "SignalQuality.h"
 
 class FM {
 private:
     RDA5807 rx;
-    char* rdsTime;
-    char bufferStatioName[16];
-    char bufferRdsMsg[40];
-    char bufferRdsTime[20];
+    RDSDecoder rds;
+    RDSClockSync clockSync;
+    char bufferStationName[RDS_PS_LENGTH + 1];
+    char bufferRdsMsg[RDS_RT_LENGTH + 1];
     int currentFreq;
     char freq[10];
-    long stationNameElapsed;
-    long clear_fifo;
-    long polling_rds;
+    elapsedMillis frequencyCheckTimer;
+    static const unsigned long FREQUENCY_CHECK_INTERVAL = 400;
+
+    // Sampled from the status registers read for RDS, drives mono / soft blend
+    SignalQuality signal;
+    elapsedMillis signalTimer;
+    static const unsigned long SIGNAL_SAMPLE_INTERVAL = 250;
+    int8_t appliedBlend = -1; // SignalQuality::BlendMode set on the tuner, -1 until known
     bool initComplete = false;
     static const uint8_t INIT_STEPS = 12;  // 11 init functions + final frequency setting
+    elapsedMillis initTimer;
+    uint8_t initStep = 0;
+    bool initStarted = false;
+
+    // Warm start: after a quick boot the chip may still be powered and
+    // configured, it then only needs the last frequency back
+    static const uint8_t CHIP_ID = 0x58; // High byte of register 0x00
+    static const uint8_t VOLUME = 8;
+    static const uint8_t SEEK_THRESHOLD = 50;
+    bool quickBoot = false;
+    bool warmStarted = false;
+    unsigned long initStart = 0;
+    unsigned long timeToAudio = 0; // ms since boot when the first tune completed
     I2CTimer* i2cTimer;
     uint16_t candidateFrequency = 0;
     unsigned long lastFrequencyUpdate = 0;
     static const unsigned long FREQUENCY_DEBOUNCE_MS = 500;
 
+    // Tune / seek in progress, STC is polled from update() so the bus is
+    // only held for single register accesses
+    enum TuneState {
+        TUNE_IDLE = 0,
+        TUNE_WAIT = 1, // Tune started, waiting for STC
+        TUNE_SEEK = 2  // Seek started, READCHAN gives the progress
+    };
+    static const unsigned long TUNE_TIMEOUT = 5000; // A full band seek takes a few seconds
+    TuneState tuneState = TUNE_IDLE;
+    uint16_t tuneFrequency = 0; // Target, or channel reached so far while seeking
+    elapsedMillis tuneTimer;
+
+    // Background band scan, one channel at a time from update()
+    enum ScanState {
+        SCAN_OFF = 0,
+        SCAN_TUNE = 1,
+        SCAN_SETTLE = 2, // Waiting for RSSI to settle after the tune
+        SCAN_RDS = 3     // Station found, waiting for the PS name
+    };
+    static const uint16_t SCAN_START = 8760;
+    static const uint16_t SCAN_END = 10800;
+    static const uint16_t SCAN_STEP = 10;                 // 100 kHz
+    static const unsigned long SCAN_SETTLE_TIME = 60;     // ms
+    static const unsigned long SCAN_RDS_TIME = 1500;      // Enough for a few 0A groups
+    static const unsigned long SCAN_REFRESH = 1800000;    // Rescan after 30 min
+    static const uint8_t SCAN_MIN_RSSI = 20;
+    StationList stations;
+    ScanState scanState = SCAN_OFF;
+    uint16_t scanFrequency = SCAN_START;
+    FMStation scanStation;
+    SignalQuality scanSignal;
+    elapsedMillis scanTimer;
+    elapsedMillis sinceScan;
+    bool hasScanned = false;
+    bool stationsDirty = false; // Scan complete, list not written yet
+    bool scanSuspended = false; // Interrupted by a seek or tune, resumes at scanFrequency
+
+    bool warmStart();
+    void finishInit();
+    void startTune(uint16_t frequency);
+    void tuneUpdate();
+    void onTuneComplete();
     void checkRDS();
+    void decodeRdsGroup();
+    void sampleSignal();
+    void applyBlendMode(SignalQuality::BlendMode mode);
+    void scanUpdate();
+    void scanNext();
+    void suspendScan();
     void powerDown() { LOG_FM_MSG("Powering down"); rx.powerDown(); }
     void powerUp() { LOG_FM_MSG("Powering up"); rx.powerUp(); }
     void softReset() { LOG_FM_MSG("Performing soft reset"); rx.softReset(); }
     void setupRadio() { LOG_FM_MSG("Setting up radio"); rx.setup(); }
-    void initVolume() { LOG_FM_MSG("Setting volume"); rx.setVolume(8); }
+    void initVolume() { LOG_FM_MSG("Setting volume"); rx.setVolume(VOLUME); }
     void initBand() { LOG_FM_MSG("Setting band"); rx.setBand(RDA_FM_BAND_USA_EU); }
     void initMono() { LOG_FM_MSG("Setting mono"); rx.setMono(true); }
     void initBass() { LOG_FM_MSG("Setting bass"); rx.setBass(true); }
     void initRDS() { LOG_FM_MSG("Setting RDS"); rx.setRDS(true); }
     void initRdsFifo() { LOG_FM_MSG("Setting RDS FIFO"); rx.setRdsFifo(true); }
-    void initSeekThreshold() { LOG_FM_MSG("Setting seek threshold"); rx.setSeekThreshold(50); }
+    void initSeekThreshold() { LOG_FM_MSG("Setting seek threshold"); rx.setSeekThreshold(SEEK_THRESHOLD); }
     void updateRealFrequency();
+    void onRdsChanged();
 
 public:
     FM(I2CTimer* timer) : i2cTimer(timer) {}
@@ -46,18 +117,43 @@ public:
     bool newRDSMsg = false;
     bool newStationName = false;
 
+    // Call before init(), a quick boot tries the warm start first
+    void setQuickBoot(bool quick) { quickBoot = quick; }
     void init();
     void off();
     void on();
     void seek(bool up = true);
-    void waitSeekComplete(void);
     void resetRDSData();
     void setFrequency(int newFreq);
     char* getFrequencyString();
     void update();
+    // Writes the list of a completed band scan to the SD card. Call from the
+    // mode loop, the write is too slow to hold the I2C bus through
+    void saveStations();
     bool isInitialized() { return initComplete; }
+    bool isWarmStarted() { return warmStarted; }
+    // 0 until the first station is tuned
+    unsigned long getTimeToAudio() { return timeToAudio; }
+    const RDSDecoder& getRDS() const { return rds; }
+    const RDSClockSync& getClockSync() const { return clockSync; }
+    const SignalQuality& getSignal() const { return signal; }
+    bool hasValidFrequency() { return SNVS_LPGPR0 >= SCAN_START && SNVS_LPGPR0 <= SCAN_END; }
+    // For the RDS clock when there is no last station to go back to
+    bool tuneStrongestStation();
+
+    // Seek and setFrequency return right away, the sweep can be shown from
+    // getTuneFrequency() until isTuning() goes false
+    bool isTuning() { return tuneState != TUNE_IDLE; }
+    uint16_t getTuneFrequency() { return tuneFrequency; }
 
-    static void nullFunc() {}
+    // Scan the band while the radio isn't listened to, PREV / NEXT then jump
+    // between the stations found instead of running a hardware seek. A seek
+    // or tune suspends it, startScan() resumes it once the tune is complete
+    void startScan();
+    void stopScan();
+    bool isScanning() { return scanState != SCAN_OFF; }
+    uint16_t getScanFrequency() { return scanFrequency; }
+    const StationList& getStations() const { return stations; }
 };
 
 #endif // FM_H 
\ No newline at end of file
@@ -2,14 +2,32 @@
 
 #include <Arduino.h>
 #include "I2CTimer.h"
+#include "I2CEventQueue.h"
+#include "I2CSpeedController.h"
+#include "I2CWatchdog.h"
+#include "IOTrace.h"
 #include "AudioMode.h"
 
 #define IO_BOARD_I2C_ADDRESS 0x02
 #define BT_MODULE_I2C_ADDRESS 0x03
+#define FM_FULL_ACCESS_I2C_ADDRESS 0x10   // RDA5807 sequential access
+#define FM_DIRECT_ACCESS_I2C_ADDRESS 0x11 // RDA5807 random access
 #define SDA_PIN 17
 #define SCL_PIN 16
 
-#define MAX_BT_DATA_LENGTH 136 // Maximum length of data string
+// Bluetooth sink frames, see bluetooth-sink/README.md
+#define BT_STATUS_LENGTH 20 // Status, with the revision of each text field
+#define BT_FIELD_TEXT_LENGTH 32
+#define BT_FIELD_LENGTH (3 + BT_FIELD_TEXT_LENGTH) // One text field
+
+enum BTField
+{
+  BT_FIELD_TITLE,
+  BT_FIELD_ARTIST,
+  BT_FIELD_ALBUM,
+  BT_FIELD_DEVICE_NAME,
+  BT_FIELD_COUNT
+};
 #define BT_COMMAND_COOLDOWN 500
 
 // Add this struct at the top of the file, before the I2C class
@@ -17,6 +35,12 @@ struct Metadata
 {
   String title;
   String artist;
+  String album;
+  uint16_t trackNumber;
+  uint16_t trackCount;
+  uint32_t duration;          // ms, 0 when unknown
+  uint32_t position;          // ms, at positionTime
+  unsigned long positionTime; // millis() when position was valid
   bool isPlaying;
   bool updated;
   bool awaitingUpdate;
@@ -24,7 +48,16 @@ struct Metadata
   bool isConnected;
   String deviceName;
 
-  Metadata() : title(""), artist(""), isPlaying(false), updated(false), awaitingUpdate(false), lastCommandTime(0), isConnected(false), deviceName("disconnected") {}
+  Metadata() : title(""), artist(""), album(""), trackNumber(0), trackCount(0), duration(0), position(0), positionTime(0),
+               isPlaying(false), updated(false), awaitingUpdate(false), lastCommandTime(0), isConnected(false), deviceName("disconnected") {}
+
+  // The sink only reports the position every few seconds, it moves on
+  // locally while playing
+  uint32_t getPosition() const
+  {
+    uint32_t current = isPlaying ? position + (millis() - positionTime) : position;
+    return duration ? min(current, duration) : current;
+  }
 };
 
 #define COMMAND_TIMEOUT 3000 // 3 seconds timeout for command response
@@ -36,6 +69,27 @@ enum ControlCommand
   PLAY = 2,
   NEXT = 3
 };
+
+// Add these button definitions
+enum ButtonMask
+{
+  ORANGE_BTN = (1 << 0),
+  BAND_BTN = (1 << 1),
+  INPUT_BTN = (1 << 2)
+};
+#define BUTTONS_MASK (ORANGE_BTN | BAND_BTN | INPUT_BTN)
+
+// The other bits of the button byte: the IO board smooths the pots and flags
+// each value that changed since the previous poll
+enum PotChangedMask
+{
+  VOLUME_CHANGED = (1 << 3),
+  TONE_CHANGED = (1 << 4),
+  TUNING_CHANGED = (1 << 5),
+  BRIGHTNESS_CHANGED = (1 << 6)
+};
+#define POTS_CHANGED_MASK (VOLUME_CHANGED | TONE_CHANGED | TUNING_CHANGED | BRIGHTNESS_CHANGED)
+
 struct IOState
 {
   byte buttonStates;
@@ -44,23 +98,16 @@ struct IOState
   uint8_t tuning;
   uint8_t brightness;
   uint8_t fmValue;
+  byte potsChanged; // PotChangedMask, pots whose value changed since I2C::takePotsChanged()
   ControlCommand control;
   bool controlProcessed;
   String nfcUidString;
 
   IOState() : buttonStates(0), volume(0), tone(0), tuning(0),
-              brightness(0), fmValue(0), control(NONE),
+              brightness(0), fmValue(0), potsChanged(POTS_CHANGED_MASK), control(NONE),
               controlProcessed(false) {}
 };
 
-// Add these button definitions
-enum ButtonMask
-{
-  ORANGE_BTN = (1 << 0),
-  BAND_BTN = (1 << 1),
-  INPUT_BTN = (1 << 2)
-};
-
 class I2C
 {
 public:
@@ -69,16 +116,21 @@ public:
     static I2C instance;
     return instance;
   }
+  static const unsigned long STARTUP_TIME = 300; // Give devices time to initialize after init()
   void init(void);
+  bool isReady() const { return millis() - initTime_ >= STARTUP_TIME; }
   void loop(void);
   I2CTimer& getTimer() { return i2cTimer; }
   void btPlay();
   void btPause();
   void btPrevious();
   void btNext();
-  String requestDataFromBluetooth();
+  bool requestDataFromBluetooth();
   bool requestDataFromIO(bool isRetry);
   void queueBTCommand(char cmd);
+  // Runs the callbacks queued by the last transactions, must be called
+  // from loop() outside of any I2C operation
+  void dispatchEvents();
 
   // Add getter for metadata
   const Metadata &getMetadata() const { return metadata_; }
@@ -103,17 +155,43 @@ public:
   void setNfcTagCallback(NfcTagCallback cb) { nfcTagCallback_ = cb; }
 
   const IOState &getIOState() const { return ioState_; }
+  // Pots of mask (PotChangedMask) that changed since the last call, all of
+  // them before the first one
+  byte takePotsChanged(byte mask)
+  {
+    byte changed = ioState_.potsChanged & mask;
+    ioState_.potsChanged &= ~mask;
+    return changed;
+  }
+  // Recording of the frames received from the IO board
+  IOTrace &getIOTrace() { return ioTrace_; }
   void setCurrentMode(AudioMode mode) { currentMode_ = mode; }
+
+  const I2CEventQueue &getEventQueue() const { return eventQueue_; }
+  const I2CEventStats &getEventStats(I2CEventType type) const { return eventStats_[type]; }
+  void printStats(Print &out) const;
+  void resetStats();
 private:
   I2CTimer i2cTimer;
+  I2CSpeedController speed_;
+  I2CWatchdog watchdog_;
+  I2CEventQueue eventQueue_;
+  I2CEventStats eventStats_[EVENT_TYPE_COUNT];
+  void queueEvent_(I2CEventType type, uint8_t value, const char *uid = nullptr);
+  unsigned long initTime_ = 0;
   char pendingBTCommand_ = 0;
   Metadata metadata_; // Add metadata storage
   IOState ioState_;
+  IOTrace ioTrace_;
   ControlCallback controlCallback_ = nullptr;
   ButtonCallback orangeButtonCallback_ = nullptr;
   ButtonCallback bandButtonCallback_ = nullptr;
   ButtonCallback inputButtonCallback_ = nullptr;
-  void parseMetadata_(const String &data);
+  void parseBTStatus_(const uint8_t *frame);
+  bool requestBTField_(uint8_t field, bool &changed);
+  int16_t btFieldRevisions_[BT_FIELD_COUNT] = {-1, -1, -1, -1}; // Of the fields we have, -1 before the first read
+  int16_t btPositionRevision_ = -1;
+  String btDeviceName_; // Last read, deviceName says "disconnected" instead when not connected
   AudioMode currentMode_ = MODE_BLUETOOTH;
   uint8_t lastStableVolume = 0; // Last validated volume
   uint8_t pendingVolume = 0;    // Volume waiting for validation
@@ -121,5 +199,5 @@ private:
   NfcTagCallback nfcTagCallback_ = nullptr;
   elapsedMillis noTagTimer = 0;
   bool noTagTimerStarted = false;
-  const unsigned long NO_TAG_DEBOUNCE_TIME = 3500; // 3.5 seconds
+  const unsigned long NO_TAG_DEBOUNCE_TIME = 400; // The IO board already confirms a removal over 3 polls
 };
\ No newline at end of file
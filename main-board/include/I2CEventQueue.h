@@ -0,0 +1,92 @@
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+
+#define NFC_UID_STRING_LENGTH 15 // 7 UID bytes as hex + null terminator
+
+enum I2CEventType : uint8_t
+{
+  EVENT_ORANGE_BUTTON = 0,
+  EVENT_BAND_BUTTON,
+  EVENT_INPUT_BUTTON,
+  EVENT_CONTROL,
+  EVENT_NFC_TAG,
+  EVENT_TYPE_COUNT
+};
+
+struct I2CEvent
+{
+  I2CEventType type;
+  uint8_t value;                   // Button state or ControlCommand
+  char uid[NFC_UID_STRING_LENGTH]; // Only used by EVENT_NFC_TAG
+  uint32_t enqueuedAt;             // micros() when the event was queued
+};
+
+// Dispatch statistics, one entry per event type
+struct I2CEventStats
+{
+  uint32_t count = 0;
+  uint32_t totalLatencyUs = 0; // Time spent waiting in the queue
+  uint32_t maxLatencyUs = 0;
+  uint32_t maxHandlerUs = 0; // Time spent in the callback itself
+};
+
+/* Bounded lock-free single-producer / single-consumer queue.
+ * The I2C layer pushes events while it holds the bus, loop() pops them
+ * once the transaction is over. */
+class I2CEventQueue
+{
+public:
+  static const uint8_t CAPACITY = 16; // Must be a power of two
+
+  bool push(const I2CEvent &event)
+  {
+    uint8_t head = head_.load(std::memory_order_relaxed);
+    uint8_t tail = tail_.load(std::memory_order_acquire);
+    uint8_t depth = head - tail;
+    if (depth >= CAPACITY)
+    {
+      dropped_++;
+      return false;
+    }
+    events_[head & (CAPACITY - 1)] = event;
+    head_.store(head + 1, std::memory_order_release);
+    if (depth + 1 > highWaterMark_)
+    {
+      highWaterMark_ = depth + 1;
+    }
+    return true;
+  }
+
+  bool pop(I2CEvent &event)
+  {
+    uint8_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail == head_.load(std::memory_order_acquire))
+    {
+      return false;
+    }
+    event = events_[tail & (CAPACITY - 1)];
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  uint8_t size() const
+  {
+    return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+  }
+  uint8_t highWaterMark() const { return highWaterMark_; }
+  uint32_t dropped() const { return dropped_; }
+  void resetStats()
+  {
+    highWaterMark_ = size();
+    dropped_ = 0;
+  }
+
+private:
+  I2CEvent events_[CAPACITY];
+  std::atomic<uint8_t> head_{0}; // Next slot to write, owned by the producer
+  std::atomic<uint8_t> tail_{0}; // Next slot to read, owned by the consumer
+  uint8_t highWaterMark_ = 0;
+  uint32_t dropped_ = 0;
+};
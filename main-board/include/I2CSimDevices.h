@@ -0,0 +1,142 @@
+#pragma once
+
+#ifdef I2C_SIMULATED_BUS
+
+#include <Arduino.h>
+#include <I2CBus.h>
+
+// One step of the IO board script, the frame is held for `polls` requests
+struct IOSimFrame
+{
+  uint16_t polls;
+  uint8_t buttons;
+  uint8_t volume;
+  uint8_t tone;
+  uint8_t tuning;
+  uint8_t brightness;
+  uint8_t fmValue;
+  uint8_t control;
+  uint8_t nfcUid[7];
+};
+
+// Replays the frame sent by the io-board i2cRequest()
+class IOBoardSim : public I2CSimDevice
+{
+public:
+  IOBoardSim(const IOSimFrame *script, uint8_t length) : script_(script), length_(length) {}
+  void onReceive(uint8_t address, const uint8_t *data, uint8_t length) override {}
+  uint8_t onRequest(uint8_t address, uint8_t *buffer, uint8_t quantity) override;
+  // Answers with this frame from now on instead of the script, for replays
+  void setFrame(const IOSimFrame &frame)
+  {
+    live_ = frame;
+    isLive_ = true;
+  }
+
+private:
+  const IOSimFrame *script_;
+  uint8_t length_;
+  uint8_t step_ = 0;
+  uint16_t pollsInStep_ = 0;
+  IOSimFrame live_;
+  bool isLive_ = false;
+  uint8_t sentPots_[4] = {}; // Volume, tone, tuning, brightness, for the changed flags
+};
+
+struct BTSimTrack
+{
+  const char *title;
+  const char *artist;
+  const char *album;
+  uint32_t duration; // ms
+};
+
+// Answers the status and text field frames of the bluetooth-sink
+// i2cRequest(), with position notifications every few seconds while
+// playing, and reacts to the p / s / r / n / f commands
+class BluetoothSinkSim : public I2CSimDevice
+{
+public:
+  BluetoothSinkSim(const BTSimTrack *tracks, uint8_t length, const char *peerName)
+      : tracks_(tracks), length_(length), peerName_(peerName) {}
+  void onReceive(uint8_t address, const uint8_t *data, uint8_t length) override;
+  uint8_t onRequest(uint8_t address, uint8_t *buffer, uint8_t quantity) override;
+  void setConnected(bool connected);
+
+private:
+  static const unsigned long POSITION_INTERVAL = 5000; // Like PLAY_POS_INTERVAL on the sink
+
+  const BTSimTrack *tracks_;
+  uint8_t length_;
+  const char *peerName_;
+  uint8_t track_ = 0;
+  bool connected_ = true;
+  bool playing_ = false;
+  int8_t selectedField_ = -1;
+  uint8_t revisions_[4] = {}; // Of each text field, BT_FIELD_COUNT
+  uint32_t position_ = 0;      // ms, at positionTime_
+  unsigned long positionTime_ = 0;
+  uint32_t reportedPosition_ = 0;
+  uint8_t positionRevision_ = 0;
+  unsigned long lastReport_ = 0;
+  uint32_t positionNow_() const;
+  void changeTrack_(uint8_t track);
+  void notifyPosition_();
+};
+
+struct FMSimStation
+{
+  uint16_t frequency; // 10 kHz units, like FM::getFrequency()
+  uint8_t rssi;       // 0-127
+  bool stereo;
+  uint16_t pi;
+  const char *ps;       // 8 chars
+  const char *radioText; // Up to 64 chars
+};
+
+// RDA5807 register map on both the sequential (0x10) and random (0x11)
+// addresses, with timed tune / seek completion and a RDS 0A / 2A / 4A group
+// generator
+class RDA5807Sim : public I2CSimDevice
+{
+public:
+  RDA5807Sim(const FMSimStation *stations, uint8_t length) : stations_(stations), length_(length) { reset_(); }
+  void onReceive(uint8_t address, const uint8_t *data, uint8_t length) override;
+  uint8_t onRequest(uint8_t address, uint8_t *buffer, uint8_t quantity) override;
+
+private:
+  const FMSimStation *stations_;
+  uint8_t length_;
+  uint16_t registers_[16];
+  uint8_t pointer_ = 0; // Register used by the next direct access read
+  uint16_t channel_ = 0;
+  // Tune / seek in progress, completed after a delay like the real chip
+  bool tuning_ = false;
+  bool seekUp_ = true;
+  bool seekFailed_ = false;
+  uint16_t fromChannel_ = 0;
+  uint16_t targetChannel_ = 0;
+  uint16_t seekSteps_ = 0;
+  uint32_t tuneStart_ = 0;
+  uint32_t lastGroup_ = 0;
+  uint32_t lastClockMinute_ = 0;
+  uint8_t groupIndex_ = 0;
+
+  void reset_();
+  void writeRegister_(uint8_t reg, uint16_t value);
+  void tune_(uint16_t channel);
+  void seek_(bool up);
+  void progress_();
+  uint16_t channelCount_() const;
+  const FMSimStation *station_() const;
+  uint16_t frequency_(uint16_t channel) const;
+  void updateStatus_();
+  void nextRdsGroup_();
+};
+
+// Attaches the default models and fault profile to i2cBus
+void attachSimulatedDevices();
+// The model behind IO_BOARD_I2C_ADDRESS
+IOBoardSim &simulatedIOBoard();
+
+#endif // I2C_SIMULATED_BUS
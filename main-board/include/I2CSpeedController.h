@@ -0,0 +1,46 @@
+#pragma once
+
+#include <Arduino.h>
+#include <I2CBus.h>
+
+/* Picks the Wire1 clock from the error rate measured by i2cBus.
+ * Starts at the fastest speed, steps down when NACKs / short reads / timeouts
+ * exceed MAX_ERROR_PERCENT over a window, and probes back up once the bus has
+ * been clean for a while (with an increasing delay if the probe fails). */
+class I2CSpeedController
+{
+public:
+  // Teensy 4 only has three clock settings (100k, 400k, 1M), the Nano's TWI
+  // target and the BSS138 level shifter top out at fast mode
+  static const uint8_t SPEED_COUNT = 2;
+  static const uint32_t SPEEDS[SPEED_COUNT]; // Fastest first
+
+  static const unsigned long WINDOW = 2000;            // Evaluation period in ms
+  static const uint16_t MIN_TRANSACTIONS = 20;         // Ignore windows with less traffic
+  static const uint8_t MAX_ERROR_PERCENT = 5;
+  static const unsigned long PROBE_DELAY = 30000;      // Clean time before probing up
+  static const unsigned long MAX_PROBE_DELAY = 600000;
+
+  void begin();
+  // Must be called between transactions
+  void update();
+  uint32_t getClock() const { return SPEEDS[level_]; }
+  void printStatus(Print &out) const;
+
+private:
+  uint8_t level_ = 0; // Index in SPEEDS
+  bool probing_ = false;
+  unsigned long probeDelay_ = PROBE_DELAY;
+  elapsedMillis windowTimer_;
+  elapsedMillis cleanTimer_;
+  uint32_t stepDowns_ = 0;
+  uint32_t stepUps_ = 0;
+
+  // Counters at the start of the window, per i2cBus stats slot
+  uint32_t lastTransactions_[I2C_BUS_MAX_DEVICES] = {};
+  uint32_t lastErrors_[I2C_BUS_MAX_DEVICES] = {};
+  uint32_t lastBytes_[I2C_BUS_MAX_DEVICES] = {};
+  uint32_t throughput_[I2C_BUS_MAX_DEVICES] = {}; // Bytes per second over the last window
+
+  void setLevel_(uint8_t level);
+};
@@ -12,7 +12,8 @@ public:
     static const uint8_t MAX_RETRIES = 0;                 // 0 retries for now
     static const unsigned long TIMEOUT = 5000;            // Increased timeout if needed
     static const unsigned long WARMUP_PERIOD = 5000;      // Time to wait for IO measurements to stabilize
-    static const unsigned long RDS_POLL_INTERVAL = 403;   // RDS should be polled frequently
+    static const unsigned long RDS_POLL_INTERVAL = 40;    // Faster than the ~88 ms RDS group rate
+    static const unsigned long TUNE_POLL_INTERVAL = 10;   // STC checks while the FM chip tunes / seeks
 
     // Add priority levels
     enum BusOperation {
@@ -20,7 +21,8 @@ public:
         MANUAL = 1,
         RDS_POLL = 2,
         BT_STATUS = 3,
-        IO_POLL = 4
+        IO_POLL = 4,
+        TUNE_POLL = 5
     };
 
     I2CTimer();
@@ -29,6 +31,7 @@ public:
     bool shouldPollIO();
     bool shouldPollBluetooth();
     bool shouldPollRDS();
+    bool shouldPollTune();
     bool shouldRetry();
     bool hasTimeout();
     void resetTimeout();
@@ -37,6 +40,7 @@ public:
     void markIOPolled();
     void markBTPolled();
     void markRDSPolled();
+    void markTunePolled();
     void startRetrySequence();
     void markRetryComplete();
     bool isInRetrySequence() { return isRetrying; }
@@ -50,6 +54,7 @@ private:
     unsigned long lastIOPoll;
     unsigned long lastBTPoll;
     unsigned long lastRDSPoll;
+    unsigned long lastTunePoll;
     unsigned long lastResponse;
     unsigned long lastRetry;
     bool timeoutFlag;
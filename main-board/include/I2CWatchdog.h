@@ -0,0 +1,48 @@
+#pragma once
+
+#include <Arduino.h>
+
+/* Decides when to run i2cBus.recoverBus() from the outcome of each poll.
+ * After FAILURE_THRESHOLD consecutive failures (or a bus timeout) the bus is
+ * recovered, then the watchdog backs off before trying again, doubling the
+ * delay each time the bus stays dead. */
+class I2CWatchdog
+{
+public:
+  enum State
+  {
+    HEALTHY = 0,
+    FAILING = 1, // Failures seen, below the threshold
+    BACKOFF = 2  // Recovered, waiting before the next attempt
+  };
+
+  static const uint8_t FAILURE_THRESHOLD = 3;
+  static const unsigned long INITIAL_BACKOFF = 100; // ms
+  static const unsigned long MAX_BACKOFF = 5000;
+
+  void reportSuccess();
+  // Both return true when the bus has just been recovered
+  bool reportFailure(uint8_t address);
+  bool reportTimeout();
+
+  State getState() const { return state_; }
+  void printStatus(Print &out) const;
+
+private:
+  State state_ = HEALTHY;
+  uint8_t failures_ = 0;
+  unsigned long backoff_ = INITIAL_BACKOFF;
+  elapsedMillis sinceRecovery_;
+  unsigned long incidentStart_ = 0;
+  bool recoveredInIncident_ = false;
+
+  // Time from the first failure to the next successful transaction, for the
+  // incidents that needed a recovery
+  uint32_t recoveries_ = 0;
+  uint32_t failedRecoveries_ = 0; // SDA still low afterwards
+  uint32_t incidents_ = 0;
+  uint32_t totalRecoverMs_ = 0;
+  uint32_t maxRecoverMs_ = 0;
+
+  bool recover_(uint8_t address);
+};
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <Arduino.h>
+#include <SD.h>
+
+#define IO_TRACE_FOLDER "Traces"
+
+// IO board frame as received by I2C::requestDataFromIO(), pots are raw
+struct IOTraceFrame
+{
+  uint32_t ms; // millis() of the poll
+  uint8_t buttons;
+  uint8_t volume;
+  uint8_t tone;
+  uint8_t tuning;
+  uint8_t brightness;
+  uint8_t fmValue;
+  uint8_t control;
+  uint8_t nfcUid[7];
+};
+
+/* Recording of the IO board inputs, to be replayed by the host build (see
+ * host/README.md). record() keeps the frames that differ from the previous
+ * one in a ring, nothing is written from the I2C code. drain() writes them
+ * from a low priority task as CSV lines:
+ *   ms,buttons,volume,tone,tuning,brightness,fm,control,uid
+ * to Traces/ioNNN.csv on the SD card or to USB serial. */
+class IOTrace
+{
+public:
+  static const uint8_t CAPACITY = 32;               // Frames, a power of 2
+  static const uint8_t LINE_LENGTH = 56;            // Longest line, with the terminator
+  static const unsigned long FLUSH_INTERVAL = 1000; // ms, SD only
+
+  bool startSD();
+  void startSerial();
+  void stop();
+  bool isRecording() const { return out_ != nullptr; }
+  const char *getPath() const { return path_; }
+  uint32_t getDropped() const { return dropped_; }
+
+  void record(const IOTraceFrame &frame);
+  void drain();
+
+  // One CSV line, and back. parse() returns false on anything else, like the
+  // other output of a serial capture.
+  static void format(const IOTraceFrame &frame, char *line);
+  static bool parse(const char *line, IOTraceFrame &frame);
+
+private:
+  IOTraceFrame ring_[CAPACITY];
+  uint8_t head_ = 0;
+  uint8_t tail_ = 0;
+  IOTraceFrame last_;
+  bool hasLast_ = false;
+  uint32_t dropped_ = 0;
+
+  Print *out_ = nullptr;
+  File file_;
+  char path_[24] = "";
+  elapsedMillis flushTimer_;
+
+  void start_(Print *out);
+};
@@ -3,6 +3,11 @@
 
 // Set to 1 to enable logging, 0 to disable
 #define ENABLE_LOGGING 0
+// Set to 1 to record logs in the binary trace (Trace.h) instead of printing
+// them, decode the serial output with tools/trace_decode.py
+#define LOG_TO_TRACE 1
+
+#define TRACE_ENABLED (ENABLE_LOGGING && LOG_TO_TRACE)
 
 // Logging categories - can be individually enabled/disabled
 #define LOG_I2C        1
@@ -13,52 +18,66 @@
 #define LOG_FM         0
 
 #if ENABLE_LOGGING
-    #define LOG(msg) Serial.println(msg)
-    #define LOGF(...) Serial.printf(__VA_ARGS__)
+    #if LOG_TO_TRACE
+        #include "Trace.h"
+        #define LOG_WRITE(category, msg) trace.logf(Trace::category, "" msg)
+        #define LOG_WRITEF(category, ...) trace.logf(Trace::category, __VA_ARGS__)
+        #define TRACE_BEGIN(category, name) trace.begin(Trace::category, name)
+        #define TRACE_END(category, name) trace.end(Trace::category, name)
+    #else
+        #define LOG_WRITE(category, msg) Serial.println("" msg)
+        #define LOG_WRITEF(category, ...) Serial.printf(__VA_ARGS__)
+        #define TRACE_BEGIN(category, name)
+        #define TRACE_END(category, name)
+    #endif
+
+    // msg must be a string literal, LOGF for anything else
+    #define LOG(msg) LOG_WRITE(TRACE_MAIN, msg)
+    #define LOGF(...) LOG_WRITEF(TRACE_MAIN, __VA_ARGS__)
     
     #if LOG_I2C
-        #define LOG_I2C_MSG(msg) Serial.println(msg)
-        #define LOG_I2C_MSGF(...) Serial.printf(__VA_ARGS__)
+        #define LOG_I2C_MSG(msg) LOG_WRITE(TRACE_I2C, msg)
+        #define LOG_I2C_MSGF(...) LOG_WRITEF(TRACE_I2C, __VA_ARGS__)
     #else
         #define LOG_I2C_MSG(msg)
         #define LOG_I2C_MSGF(...)
     #endif
 
     #if LOG_BLUETOOTH
-        #define LOG_BT_MSG(msg) Serial.println(msg)
-        #define LOG_BT_MSGF(...) Serial.printf(__VA_ARGS__)
+        #define LOG_BT_MSG(msg) LOG_WRITE(TRACE_BT, msg)
+        #define LOG_BT_MSGF(...) LOG_WRITEF(TRACE_BT, __VA_ARGS__)
     #else
         #define LOG_BT_MSG(msg)
         #define LOG_BT_MSGF(...)
     #endif
 
     #if LOG_RECORDER
-        #define LOG_RECORDER_MSG(msg) Serial.println(msg)
-        #define LOG_RECORDER_MSGF(...) Serial.printf(__VA_ARGS__)
+        #define LOG_RECORDER_MSG(msg) LOG_WRITE(TRACE_RECORDER, msg)
+        #define LOG_RECORDER_MSGF(...) LOG_WRITEF(TRACE_RECORDER, __VA_ARGS__)
     #else
         #define LOG_RECORDER_MSG(msg)
         #define LOG_RECORDER_MSGF(...)
     #endif
 
     #if LOG_DISPLAY
-        #define LOG_DISPLAY_MSG(msg) Serial.println(msg)
-        #define LOG_DISPLAY_MSGF(...) Serial.printf(__VA_ARGS__)
+        #define LOG_DISPLAY_MSG(msg) LOG_WRITE(TRACE_DISPLAY, msg)
+        #define LOG_DISPLAY_MSGF(...) LOG_WRITEF(TRACE_DISPLAY, __VA_ARGS__)
     #else
         #define LOG_DISPLAY_MSG(msg)
         #define LOG_DISPLAY_MSGF(...)
     #endif
 
     #if LOG_AUDIO
-        #define LOG_AUDIO_MSG(msg) Serial.println(msg)
-        #define LOG_AUDIO_MSGF(...) Serial.printf(__VA_ARGS__)
+        #define LOG_AUDIO_MSG(msg) LOG_WRITE(TRACE_AUDIO, msg)
+        #define LOG_AUDIO_MSGF(...) LOG_WRITEF(TRACE_AUDIO, __VA_ARGS__)
     #else
         #define LOG_AUDIO_MSG(msg)
         #define LOG_AUDIO_MSGF(...)
     #endif
 
     #if LOG_FM
-        #define LOG_FM_MSG(msg) Serial.println(msg)
-        #define LOG_FM_MSGF(...) Serial.printf(__VA_ARGS__)
+        #define LOG_FM_MSG(msg) LOG_WRITE(TRACE_FM, msg)
+        #define LOG_FM_MSGF(...) LOG_WRITEF(TRACE_FM, __VA_ARGS__)
     #else
         #define LOG_FM_MSG(msg)
         #define LOG_FM_MSGF(...)
@@ -66,6 +85,8 @@
 #else
     #define LOG(msg)
     #define LOGF(...)
+    #define TRACE_BEGIN(category, name)
+    #define TRACE_END(category, name)
     #define LOG_I2C_MSG(msg)
     #define LOG_I2C_MSGF(...)
     #define LOG_BT_MSG(msg)
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Display.h"
+
+/* Performance strip over the top of the title bar, hidden by default: audio
+ * CPU %, audio blocks, frame render time, fps and the I2C error rate. Every
+ * push is the whole frame buffer, so the SPI traffic follows the fps. Values
+ * are sampled every REFRESH_INTERVAL, the strip is redrawn every frame from
+ * the cached line. That is one fixed rect and at most MAX_CHARS characters,
+ * so it costs the same on every frame. */
+class PerfHud
+{
+public:
+  static const unsigned long REFRESH_INTERVAL = 500; // ms
+  static const uint8_t MAX_CHARS = 53;               // 320 px of the 6 px built-in font, from x = 2
+
+  PerfHud(Display &display) : display_(display) {}
+
+  void toggle();
+  bool isVisible() const { return visible_; }
+  // Once per frame, renderUs is the time spent drawing it
+  void frameRendered(uint32_t renderUs);
+  // Fills the line with the latest values when due
+  const char *getLine();
+
+private:
+  Display &display_;
+  bool visible_ = false;
+  elapsedMillis refreshTimer_;
+  char line_[MAX_CHARS + 1] = "";
+
+  // Over the current window
+  uint32_t frames_ = 0;
+  uint32_t totalRenderUs_ = 0;
+  uint32_t maxRenderUs_ = 0;
+
+  // Counters at the start of the window
+  uint32_t lastPushes_ = 0;
+  uint32_t lastTransactions_ = 0;
+  uint32_t lastI2CErrors_ = 0;
+
+  void refresh_();
+};
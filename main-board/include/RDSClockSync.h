@@ -0,0 +1,39 @@
+#pragma once
+
+#include <Arduino.h>
+#include "RDSDecoder.h"
+
+/* Sets the RTC from RDS clock time (CT) groups.
+ * A CT group is only trusted once REQUIRED_GROUPS consecutive groups agree
+ * with each other and with the time elapsed between them. The RTC is then
+ * set to the local time of the station if it's off by MIN_CORRECTION or more,
+ * and the correction is kept in SNVS_LPGPR3 (RTC minus radio, in seconds). */
+class RDSClockSync
+{
+public:
+  static const uint8_t REQUIRED_GROUPS = 3;
+  static const uint32_t MAX_MISMATCH = 60;               // CT has a one minute resolution, in s
+  static const uint32_t MIN_CORRECTION = 2;              // s
+  static const unsigned long SYNC_INTERVAL = 3600000;    // Once an hour at most
+
+  // Returns true when the RTC has just been synced
+  bool feed(const RDSClockTime &time);
+  void reset() { consistentGroups_ = 0; }
+
+  bool hasSynced() const { return syncs_ > 0; }
+  int32_t getLastCorrection() const { return lastCorrection_; }
+  int32_t getDriftPpm() const { return driftPpm_; }
+
+private:
+  uint8_t consistentGroups_ = 0;
+  uint32_t lastTime_ = 0; // Local time of the last CT group
+  int8_t lastOffset_ = 0;
+  unsigned long lastReceived_ = 0;
+
+  uint32_t syncs_ = 0;
+  unsigned long lastSync_ = 0;
+  int32_t lastCorrection_ = 0;
+  int32_t driftPpm_ = 0;
+
+  void sync_(uint32_t radioTime);
+};
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <stdint.h>
+
+// Blocks that could not be corrected by the tuner, for RDSDecoder::decode()
+#define RDS_ERROR_A 0x01
+#define RDS_ERROR_B 0x02
+#define RDS_ERROR_C 0x04
+#define RDS_ERROR_D 0x08
+
+#define RDS_PS_LENGTH 8
+#define RDS_RT_LENGTH 64
+
+// Clock time and date from a 4A group, always UTC
+struct RDSClockTime
+{
+  uint32_t mjd; // Modified Julian Day
+  uint8_t hour;
+  uint8_t minute;
+  int8_t offset; // Local time offset in half hours
+
+  // Seconds since 1970-01-01 00:00 UTC
+  uint32_t unixTime() const { return (mjd - 40587UL) * 86400UL + hour * 3600UL + minute * 60UL; }
+};
+
+/* Streaming decoder for the raw A-D blocks of RDS groups.
+ * Doesn't touch any hardware so it can be fed from the tuner, the simulated
+ * bus or a recorded group stream. PS and RadioText are assembled per segment
+ * address and only published once every segment has been received, so a
+ * half updated name is never shown. */
+class RDSDecoder
+{
+public:
+  void reset();
+  // errors is a combination of RDS_ERROR_x flags
+  void decode(uint16_t blockA, uint16_t blockB, uint16_t blockC, uint16_t blockD, uint8_t errors = 0);
+
+  uint16_t getPI() const { return pi_; }
+  uint8_t getPTY() const { return pty_; }
+  bool hasTrafficProgram() const { return tp_; }
+  const char *getProgramService() const { return ps_; }
+  const char *getRadioText() const { return rt_; }
+
+  // Return true once after each change
+  bool takeProgramServiceChanged();
+  bool takeRadioTextChanged();
+  bool takeClockTime(RDSClockTime &time);
+
+  uint32_t getGroupCount() const { return groups_; }
+  uint32_t getErrorCount() const { return droppedGroups_; }
+
+private:
+  uint16_t pi_ = 0;
+  uint8_t pty_ = 0;
+  bool tp_ = false;
+  uint32_t groups_ = 0;
+  uint32_t droppedGroups_ = 0;
+
+  // Segments being assembled, published to ps_ / rt_ when complete
+  char psBuffer_[RDS_PS_LENGTH + 1] = {};
+  uint8_t psSegments_ = 0; // One bit per received segment
+  char ps_[RDS_PS_LENGTH + 1] = {};
+  bool psChanged_ = false;
+
+  char rtBuffer_[RDS_RT_LENGTH + 1] = {};
+  uint16_t rtSegments_ = 0;
+  uint8_t rtLength_ = RDS_RT_LENGTH; // Shortened by the 0x0D end marker
+  int8_t rtFlag_ = -1;               // Text A/B flag, -1 until the first 2A / 2B group
+  char rt_[RDS_RT_LENGTH + 1] = {};
+  bool rtChanged_ = false;
+
+  RDSClockTime clockTime_ = {};
+  bool clockTimeValid_ = false;
+
+  void decodeProgramService_(uint16_t blockB, uint16_t blockD);
+  void decodeRadioText_(uint16_t blockB, uint16_t blockC, uint16_t blockD, bool versionB, uint8_t errors);
+  void decodeClockTime_(uint16_t blockB, uint16_t blockC, uint16_t blockD);
+  void clearRadioText_();
+  static void publish_(char *target, const char *source, uint8_t length, bool &changed);
+};
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <Arduino.h>
+
+/* Cooperative scheduler for loop().
+ * A task is a plain function, released every period (0 = on every pass). It
+ * either completes or returns TASK_YIELD to be resumed on the next pass, once
+ * the other ready tasks had their turn. A completion later than the deadline
+ * (from the release) counts as an overrun. Each pass runs the ready tasks in
+ * the order they were added, so add them by priority.
+ * Task names must be string literals, only the pointer is kept. */
+class Scheduler
+{
+public:
+  enum TaskResult
+  {
+    TASK_DONE,
+    TASK_YIELD
+  };
+  typedef TaskResult (*TaskFunction)();
+
+  static const uint8_t MAX_TASKS = 8;
+
+  // deadlineUs 0: no deadline. budgetUs: how long a slice may run before
+  // shouldYield() is true, 0 for no budget.
+  bool addTask(const char *name, TaskFunction function, uint32_t periodUs,
+               uint32_t deadlineUs = 0, uint32_t budgetUs = 0);
+  // Runs every ready task once
+  void run();
+  // For the running task, true once its slice has used its budget
+  bool shouldYield() const;
+
+  void resetStats();
+  void print(Print &out) const;
+
+  uint8_t size() const { return count_; }
+  const char *nameAt(uint8_t index) const { return tasks_[index].name; }
+  uint32_t overrunsAt(uint8_t index) const { return tasks_[index].overruns; }
+  uint32_t maxResponseAt(uint8_t index) const { return tasks_[index].maxResponseUs; }
+
+private:
+  struct Task
+  {
+    const char *name;
+    TaskFunction function;
+    uint32_t periodUs;
+    uint32_t deadlineUs;
+    uint32_t budgetUs;
+    uint32_t nextReleaseUs;
+    uint32_t releasedUs; // Release of the current run
+    bool yielded;
+
+    uint32_t runs;
+    uint32_t slices;
+    uint64_t totalUs;
+    uint32_t maxSliceUs;
+    uint32_t maxResponseUs; // Release to completion
+    uint32_t overruns;
+    uint32_t skipped; // Releases missed, more than a period late
+  };
+
+  Task tasks_[MAX_TASKS];
+  uint8_t count_ = 0;
+  int8_t current_ = -1;
+  uint32_t sliceStartUs_ = 0;
+  uint32_t statsStartUs_ = 0;
+
+  void complete_(Task &task, uint32_t endUs);
+};
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <stdint.h>
+
+/* Short rolling history of the reception of the tuned station: RSSI, stereo
+ * pilot and RDS block errors. Doesn't touch any hardware, FM feeds it from the
+ * status registers it already reads for RDS. It picks the stereo blend with
+ * some hysteresis and scores stations for the band scan. */
+class SignalQuality
+{
+public:
+  enum BlendMode
+  {
+    BLEND_MONO = 0,  // Weak, mono forced
+    BLEND_SOFT = 1,  // Stereo, the tuner blends to mono as noise rises
+    BLEND_STEREO = 2 // Strong, plain stereo
+  };
+
+  static const uint8_t HISTORY_LENGTH = 16;
+  static const uint8_t MIN_SAMPLES = 4;      // Before the blend can change
+  static const uint8_t SOFT_BLEND_RSSI = 30; // Stereo above this
+  static const uint8_t STEREO_RSSI = 45;     // No soft blend above this
+  static const uint8_t HYSTERESIS = 4;
+  static const uint8_t SCORE_MIN_RSSI = 20;  // Scores 0 below this
+  static const uint8_t SCORE_MAX_RSSI = 55;
+  static const uint8_t BARS = 5;
+  static const uint8_t BAR_MIN_RSSI = 15;
+  static const uint8_t BAR_STEP = 8;
+
+  // Clears the history, the blend is kept until there are enough new samples
+  void reset();
+  void addSample(uint8_t rssi, bool stereo);
+  // errorBlocks is the number of uncorrectable blocks in the group,
+  // counted in the next sample
+  void addRdsGroup(uint8_t errorBlocks);
+
+  uint8_t getSampleCount() const { return count_; }
+  uint8_t getRssi() const; // Average
+  uint8_t getStereoPercent() const;
+  bool hasRds() const;
+  uint8_t getRdsErrorPercent() const;
+
+  // 0-100, from RSSI, stereo pilot and RDS errors
+  uint8_t getScore() const;
+  // 0-BARS, from RSSI
+  uint8_t getBars() const;
+  BlendMode getBlendMode() const { return blendMode_; }
+
+private:
+  struct Sample
+  {
+    uint8_t rssi;
+    bool stereo;
+    uint8_t rdsBlocks;
+    uint8_t rdsErrors;
+  };
+
+  Sample history_[HISTORY_LENGTH];
+  uint8_t head_ = 0;
+  uint8_t count_ = 0;
+  // RDS groups since the last sample
+  uint8_t rdsBlocks_ = 0;
+  uint8_t rdsErrors_ = 0;
+  BlendMode blendMode_ = BLEND_MONO;
+
+  void updateBlendMode_();
+};
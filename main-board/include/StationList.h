@@ -0,0 +1,51 @@
+#pragma once
+
+#include <Arduino.h>
+#include "RDSDecoder.h"
+
+#define STATION_LIST_FOLDER "Radio"
+#define STATION_LIST_PATH "Radio/stations.txt"
+
+struct FMStation
+{
+  uint16_t frequency; // 10 kHz units
+  uint8_t rssi;
+  bool stereo;
+  uint16_t pi; // 0 when RDS didn't lock
+  uint8_t quality; // SignalQuality score, 0-100
+  char ps[RDS_PS_LENGTH + 1];
+};
+
+/* Stations found by the FM band scan, sorted by frequency.
+ * Saved on the SD card as one "frequency,rssi,stereo,PI,quality,PS" line per
+ * station (STATION_LINE_FORMAT in StationList.cpp). */
+class StationList
+{
+public:
+  static const uint8_t MAX_STATIONS = 48;
+  // A strong station also shows up on the channels next to it
+  static const uint16_t NEIGHBOUR_SPACING = 20; // 200 kHz
+  // Without RDS to tell, a neighbour this much weaker is taken for its shoulder
+  static const uint8_t SHOULDER_RSSI_DROP = 6;
+
+  bool load(const char *path = STATION_LIST_PATH);
+  bool save(const char *path = STATION_LIST_PATH) const;
+
+  void clear() { count_ = 0; }
+  void update(const FMStation &station);
+  void remove(uint16_t frequency);
+  // Next station above (or below) frequency, wrapping around the band
+  const FMStation *next(uint16_t frequency, bool up) const;
+  const FMStation *find(uint16_t frequency) const;
+
+  uint8_t size() const { return count_; }
+  const FMStation &at(uint8_t index) const { return stations_[index]; }
+
+private:
+  FMStation stations_[MAX_STATIONS];
+  uint8_t count_ = 0;
+
+  int8_t indexOf_(uint16_t frequency) const;
+  void insert_(const FMStation &station);
+  void removeAt_(uint8_t index);
+};
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <Arduino.h>
+#include <type_traits>
+
+/* Binary trace log, the backend of the Log.h macros when LOG_TO_TRACE is set.
+ * A record is 32 bytes: the address of the format string (decoded on the host
+ * from the firmware ELF), a cycle counter timestamp and the raw arguments.
+ * Recording copies the record in a ring buffer, nothing is formatted or sent
+ * on the device. drain() writes whole records to USB serial from a low
+ * priority task, tools/trace_decode.py turns them back into text or a Chrome
+ * trace. Formats must be string literals, the LOG macros only take a literal
+ * (anything else goes through LOGF). String arguments are copied and
+ * cut to what fits in the record, and integers are sent as 32 bits unless
+ * they are 64 bits wide. */
+class Trace
+{
+public:
+  enum Category
+  {
+    TRACE_MAIN = 0,
+    TRACE_I2C,
+    TRACE_BT,
+    TRACE_RECORDER,
+    TRACE_DISPLAY,
+    TRACE_AUDIO,
+    TRACE_FM,
+    TRACE_SCHED,
+    TRACE_CATEGORIES
+  };
+
+  enum Type
+  {
+    TYPE_MESSAGE = 0,
+    TYPE_BEGIN, // Start of a span, the format is its name
+    TYPE_END,
+    TYPE_SYNC // millis(), F_CPU_ACTUAL and the dropped count, to unwrap the cycle counter
+  };
+
+  static const uint8_t MAGIC = 0xA5;
+  static const uint8_t PAYLOAD_SIZE = 20;
+  static const uint16_t CAPACITY = 256;         // Records, a power of 2
+  static const unsigned long SYNC_INTERVAL = 1000; // ms, well under a counter wrap
+
+  struct Record
+  {
+    uint8_t magic;
+    uint8_t info; // Category << 4 | type
+    uint8_t length; // Payload bytes used
+    uint8_t checksum; // Sum of every other byte
+    uint32_t cycles;
+    uint32_t format;
+    uint8_t payload[PAYLOAD_SIZE];
+  };
+  static_assert(sizeof(Record) == 32, "Trace records are 32 bytes");
+
+  bool isEnabled(uint8_t category) const { return mask_ & (1 << category); }
+  uint32_t getMask() const { return mask_; }
+  void setMask(uint32_t mask) { mask_ = mask; }
+  void toggle(uint8_t category) { mask_ ^= (1 << category); }
+
+  template <class... Args>
+  void logf(uint8_t category, const char *format, const Args &...args)
+  {
+    if (!isEnabled(category))
+    {
+      return;
+    }
+    Record record;
+    start_(record, category, TYPE_MESSAGE, format);
+    int unused[] = {0, (put_(record, args), 0)...};
+    (void)unused;
+    commit_(record);
+  }
+
+  void begin(uint8_t category, const char *name);
+  void end(uint8_t category, const char *name);
+
+  // Writes as many records as the output takes without blocking
+  void drain(Print &out);
+  uint32_t getDropped() const { return dropped_; }
+
+private:
+  Record ring_[CAPACITY];
+  volatile uint16_t head_ = 0;
+  volatile uint16_t tail_ = 0;
+  uint32_t mask_ = 0xFFFFFFFF;
+  uint32_t dropped_ = 0;
+  unsigned long lastSync_ = 0;
+
+  static void start_(Record &record, uint8_t category, uint8_t type, const char *format);
+  void commit_(Record &record);
+  void sync_();
+
+  static void putBytes_(Record &record, const void *data, uint8_t size);
+  static void put_(Record &record, const char *value);
+  static void put_(Record &record, double value)
+  {
+    float single = value;
+    putBytes_(record, &single, sizeof(single));
+  }
+  template <class T>
+  static typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value>::type
+  put_(Record &record, T value)
+  {
+    if (sizeof(T) == 8)
+    {
+      uint64_t wide = value;
+      putBytes_(record, &wide, sizeof(wide));
+    }
+    else
+    {
+      uint32_t narrow = value;
+      putBytes_(record, &narrow, sizeof(narrow));
+    }
+  }
+};
+
+extern Trace trace;
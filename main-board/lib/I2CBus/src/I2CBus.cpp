@@ -0,0 +1,350 @@
+#include "I2CBus.h"
+
+const uint32_t I2CBus::LATENCY_BUCKET_LIMITS[I2C_LATENCY_BUCKETS - 1] = {250, 500, 1000, 2000, 5000, 10000, 20000};
+
+I2CBus i2cBus(Wire1);
+
+I2CBus::I2CBus(TwoWire &wire) : wire_(wire)
+{
+  stats_[0].name = "bus";
+}
+
+void I2CBus::setClock(uint32_t frequency)
+{
+  clock_ = frequency;
+  wire_.setClock(frequency);
+}
+
+void I2CBus::beginTransmission(uint8_t address)
+{
+  txAddress_ = address;
+  txBytes_ = 0;
+  txActive_ = true;
+  txStart_ = micros();
+#ifdef I2C_SIMULATED_BUS
+  simTxDevice_ = simDevices_[address & 0x7F];
+  if (simTxDevice_)
+  {
+    return;
+  }
+#endif
+  wire_.beginTransmission(address);
+}
+
+size_t I2CBus::write(uint8_t data)
+{
+#ifdef I2C_SIMULATED_BUS
+  if (simTxDevice_)
+  {
+    if (txBytes_ >= I2C_SIM_BUFFER_SIZE)
+    {
+      return 0;
+    }
+    simTx_[txBytes_++] = data;
+    return 1;
+  }
+#endif
+  size_t written = wire_.write(data);
+  txBytes_ += written;
+  return written;
+}
+
+uint8_t I2CBus::endTransmission(bool sendStop)
+{
+#ifdef I2C_SIMULATED_BUS
+  if (!txActive_ && simReading_)
+  {
+    return 0;
+  }
+  uint8_t error = 0;
+  if (simSdaHeld_ && txActive_)
+  {
+    // Nothing gets through while a target holds SDA
+    error = I2C_ERROR_OTHER;
+    simTxDevice_ = nullptr;
+  }
+  else if (simTxDevice_ && txActive_)
+  {
+    simTxDevice_->transactions++;
+    delayMicroseconds(simTxDevice_->faults.stretchUs);
+    if (simFault_(simTxDevice_, simTxDevice_->faults.nackEvery))
+    {
+      error = I2C_ERROR_ADDRESS_NACK;
+    }
+    else
+    {
+      simTxDevice_->onReceive(txAddress_, simTx_, txBytes_);
+    }
+    simHoldSda_(simTxDevice_);
+    simTxDevice_ = nullptr;
+  }
+  else
+  {
+    error = wire_.endTransmission(sendStop);
+  }
+#else
+  uint8_t error = wire_.endTransmission(sendStop);
+#endif
+  if (!txActive_)
+  {
+    // Stray call after a read (the RDA5807 library does this), nothing to record
+    return error;
+  }
+  txActive_ = false;
+
+  I2CDeviceStats &stats = statsFor_(txAddress_);
+  recordTransaction_(stats, micros() - txStart_, error == 0 ? txBytes_ : 0);
+  if (error == I2C_ERROR_ADDRESS_NACK || error == I2C_ERROR_DATA_NACK)
+  {
+    stats.nacks++;
+  }
+  else if (error != 0)
+  {
+    stats.timeouts++;
+  }
+  return error;
+}
+
+uint8_t I2CBus::requestFrom(uint8_t address, uint8_t quantity, bool sendStop)
+{
+  uint32_t start = micros();
+#ifdef I2C_SIMULATED_BUS
+  uint8_t received = 0;
+  I2CSimDevice *device = simDevices_[address & 0x7F];
+  simReading_ = device != nullptr || simSdaHeld_;
+  if (simSdaHeld_)
+  {
+    simRxLength_ = 0;
+    simRxIndex_ = 0;
+  }
+  else if (device)
+  {
+    device->transactions++;
+    delayMicroseconds(device->faults.stretchUs);
+    if (!simFault_(device, device->faults.nackEvery))
+    {
+      received = device->onRequest(address, simRx_, min(quantity, (uint8_t)I2C_SIM_BUFFER_SIZE));
+      if (simFault_(device, device->faults.shortReadEvery))
+      {
+        received /= 2;
+      }
+    }
+    simRxLength_ = received;
+    simRxIndex_ = 0;
+    simHoldSda_(device);
+  }
+  else
+  {
+    received = wire_.requestFrom(address, quantity, (uint8_t)sendStop);
+  }
+#else
+  uint8_t received = wire_.requestFrom(address, quantity, (uint8_t)sendStop);
+#endif
+
+  I2CDeviceStats &stats = statsFor_(address);
+  recordTransaction_(stats, micros() - start, received);
+  if (received == 0)
+  {
+    stats.nacks++;
+  }
+  else if (received < quantity)
+  {
+    stats.shortReads++;
+  }
+  return received;
+}
+
+#ifdef I2C_SIMULATED_BUS
+int I2CBus::available()
+{
+  return simReading_ ? simRxLength_ - simRxIndex_ : wire_.available();
+}
+
+int I2CBus::read()
+{
+  if (!simReading_)
+  {
+    return wire_.read();
+  }
+  return simRxIndex_ < simRxLength_ ? simRx_[simRxIndex_++] : -1;
+}
+
+void I2CBus::attachSimDevice(uint8_t address, I2CSimDevice *device)
+{
+  simDevices_[address & 0x7F] = device;
+}
+
+bool I2CBus::simFault_(I2CSimDevice *device, uint16_t every)
+{
+  return every != 0 && device->transactions % every == 0;
+}
+
+void I2CBus::simHoldSda_(I2CSimDevice *device)
+{
+  if (simFault_(device, device->faults.holdSdaEvery))
+  {
+    simSdaHeld_ = device->faults.holdSdaClocks;
+  }
+}
+#endif
+
+bool I2CBus::recoverBus(uint8_t address)
+{
+  wire_.end();
+
+  // Drive SCL by hand (open drain, the pull-ups give the high level)
+  pinMode(sdaPin_, INPUT_PULLUP);
+  pinMode(sclPin_, OUTPUT_OPENDRAIN);
+  digitalWrite(sclPin_, HIGH);
+  delayMicroseconds(I2C_RECOVERY_HALF_PERIOD_US);
+
+  // A target stuck in the middle of a byte releases SDA after at most 9 clocks
+  for (uint8_t i = 0; i < I2C_RECOVERY_CLOCKS && !sdaHigh_(); i++)
+  {
+    digitalWrite(sclPin_, LOW);
+    delayMicroseconds(I2C_RECOVERY_HALF_PERIOD_US);
+    digitalWrite(sclPin_, HIGH);
+    delayMicroseconds(I2C_RECOVERY_HALF_PERIOD_US);
+#ifdef I2C_SIMULATED_BUS
+    if (simSdaHeld_)
+    {
+      simSdaHeld_--;
+    }
+#endif
+  }
+
+  // STOP: SDA rising while SCL is high
+  pinMode(sdaPin_, OUTPUT_OPENDRAIN);
+  digitalWrite(sdaPin_, LOW);
+  delayMicroseconds(I2C_RECOVERY_HALF_PERIOD_US);
+  digitalWrite(sdaPin_, HIGH);
+  delayMicroseconds(I2C_RECOVERY_HALF_PERIOD_US);
+  pinMode(sdaPin_, INPUT_PULLUP);
+  bool released = sdaHigh_();
+
+  // Give the pins back to the peripheral
+  wire_.setSDA(sdaPin_);
+  wire_.setSCL(sclPin_);
+  begin();
+  statsFor_(address).busResets++;
+  return released;
+}
+
+bool I2CBus::sdaHigh_()
+{
+#ifdef I2C_SIMULATED_BUS
+  if (simSdaHeld_)
+  {
+    return false;
+  }
+#endif
+  return digitalRead(sdaPin_) == HIGH;
+}
+
+void I2CBus::resetBus(uint8_t address)
+{
+  wire_.begin();
+  wire_.setClock(clock_);
+  statsFor_(address).busResets++;
+}
+
+void I2CBus::registerDevice(uint8_t address, const char *name)
+{
+  statsFor_(address).name = name;
+}
+
+void I2CBus::recordTimeout(uint8_t address)
+{
+  statsFor_(address).timeouts++;
+}
+
+const I2CDeviceStats *I2CBus::getStats(uint8_t address) const
+{
+  for (uint8_t i = 0; i < deviceCount_; i++)
+  {
+    if (stats_[i].address == address)
+    {
+      return &stats_[i];
+    }
+  }
+  return nullptr;
+}
+
+void I2CBus::resetStats()
+{
+  for (uint8_t i = 0; i < deviceCount_; i++)
+  {
+    I2CDeviceStats cleared;
+    cleared.address = stats_[i].address;
+    cleared.name = stats_[i].name;
+    stats_[i] = cleared;
+  }
+}
+
+void I2CBus::printStats(Print &out) const
+{
+  out.printf("I2C bus @ %lu Hz\n", (unsigned long)clock_);
+  out.println("addr name   trans  nack short tmout reset   bytes avg_us max_us");
+  for (uint8_t i = 0; i < deviceCount_; i++)
+  {
+    const I2CDeviceStats &stats = stats_[i];
+    uint32_t average = stats.transactions ? stats.totalLatencyUs / stats.transactions : 0;
+    out.printf("0x%02X %-5s %6lu %5lu %5lu %5lu %5lu %7lu %6lu %6lu\n",
+               stats.address, stats.name ? stats.name : "?",
+               (unsigned long)stats.transactions, (unsigned long)stats.nacks,
+               (unsigned long)stats.shortReads, (unsigned long)stats.timeouts,
+               (unsigned long)stats.busResets, (unsigned long)stats.bytes,
+               (unsigned long)average, (unsigned long)stats.maxLatencyUs);
+    if (stats.transactions == 0)
+    {
+      continue;
+    }
+    out.print("     latency:");
+    for (uint8_t bucket = 0; bucket < I2C_LATENCY_BUCKETS; bucket++)
+    {
+      if (bucket < I2C_LATENCY_BUCKETS - 1)
+      {
+        out.printf(" <%lu:%lu", (unsigned long)LATENCY_BUCKET_LIMITS[bucket],
+                   (unsigned long)stats.latencyHistogram[bucket]);
+      }
+      else
+      {
+        out.printf(" >=%lu:%lu\n", (unsigned long)LATENCY_BUCKET_LIMITS[bucket - 1],
+                   (unsigned long)stats.latencyHistogram[bucket]);
+      }
+    }
+  }
+}
+
+I2CDeviceStats &I2CBus::statsFor_(uint8_t address)
+{
+  for (uint8_t i = 0; i < deviceCount_; i++)
+  {
+    if (stats_[i].address == address)
+    {
+      return stats_[i];
+    }
+  }
+  if (deviceCount_ >= I2C_BUS_MAX_DEVICES)
+  {
+    return stats_[0]; // Table full, charge it to the bus
+  }
+  I2CDeviceStats &stats = stats_[deviceCount_++];
+  stats.address = address;
+  return stats;
+}
+
+void I2CBus::recordTransaction_(I2CDeviceStats &stats, uint32_t latencyUs, uint8_t bytes)
+{
+  stats.transactions++;
+  stats.bytes += bytes;
+  stats.totalLatencyUs += latencyUs;
+  stats.maxLatencyUs = max(stats.maxLatencyUs, latencyUs);
+
+  uint8_t bucket = 0;
+  while (bucket < I2C_LATENCY_BUCKETS - 1 && latencyUs >= LATENCY_BUCKET_LIMITS[bucket])
+  {
+    bucket++;
+  }
+  stats.latencyHistogram[bucket]++;
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <Arduino.h>
+#include <Wire.h>
+
+#define I2C_BUS_MAX_DEVICES 8
+#define I2C_LATENCY_BUCKETS 8
+
+#define I2C_RECOVERY_CLOCKS 9
+#define I2C_RECOVERY_HALF_PERIOD_US 5 // 100 kHz
+
+// Wire error codes (see TwoWire::endTransmission)
+#define I2C_ERROR_ADDRESS_NACK 2
+#define I2C_ERROR_DATA_NACK 3
+#define I2C_ERROR_OTHER 4
+
+struct I2CDeviceStats
+{
+  uint8_t address = 0; // 0 is used for bus wide events
+  const char *name = nullptr;
+  uint32_t transactions = 0;
+  uint32_t nacks = 0;
+  uint32_t shortReads = 0;
+  uint32_t timeouts = 0;
+  uint32_t busResets = 0;
+  uint32_t bytes = 0;
+  uint32_t totalLatencyUs = 0;
+  uint32_t maxLatencyUs = 0;
+  uint32_t latencyHistogram[I2C_LATENCY_BUCKETS] = {};
+};
+
+#ifdef I2C_SIMULATED_BUS
+#define I2C_SIM_BUFFER_SIZE 64 // Largest transfer is the 35 bytes BT text field
+
+// Fault injection for a simulated device, periods are in transactions
+struct I2CSimFaults
+{
+  uint16_t nackEvery = 0;      // NACK one transaction out of N, 0 = never
+  uint16_t shortReadEvery = 0; // Truncate one read out of N, 0 = never
+  uint16_t stretchUs = 0;      // Clock stretching added to every transaction
+  uint16_t holdSdaEvery = 0;   // Hold SDA low after one transaction out of N
+  uint8_t holdSdaClocks = 3;   // SCL pulses needed to release it
+};
+
+/* Device model answering in place of a real target when the firmware is
+ * built with I2C_SIMULATED_BUS (see the teensy40_sim environment). */
+class I2CSimDevice
+{
+public:
+  virtual ~I2CSimDevice() {}
+  // Bytes written by the controller in one transaction
+  virtual void onReceive(uint8_t address, const uint8_t *data, uint8_t length) = 0;
+  // Bytes requested by the controller, returns how many were provided
+  virtual uint8_t onRequest(uint8_t address, uint8_t *buffer, uint8_t quantity) = 0;
+
+  I2CSimFaults faults;
+  uint32_t transactions = 0;
+};
+#endif
+
+/* Thin wrapper around a TwoWire instance that keeps per-address counters.
+ * It mirrors the subset of the Wire API used by the firmware so that call
+ * sites only need to swap Wire1 for i2cBus. */
+class I2CBus
+{
+public:
+  // Upper bound (us) of each latency histogram bucket, the last one is open
+  static const uint32_t LATENCY_BUCKET_LIMITS[I2C_LATENCY_BUCKETS - 1];
+
+  I2CBus(TwoWire &wire);
+
+  void setSDA(uint8_t pin)
+  {
+    sdaPin_ = pin;
+    wire_.setSDA(pin);
+  }
+  void setSCL(uint8_t pin)
+  {
+    sclPin_ = pin;
+    wire_.setSCL(pin);
+  }
+  void begin()
+  {
+    wire_.begin();
+    wire_.setClock(clock_); // Wire resets to 100 kHz
+  }
+  void end() { wire_.end(); }
+  void setClock(uint32_t frequency);
+  uint32_t getClock() const { return clock_; }
+
+  void beginTransmission(uint8_t address);
+  void beginTransmission(int address) { beginTransmission((uint8_t)address); }
+  size_t write(uint8_t data);
+  uint8_t endTransmission(bool sendStop = true);
+  uint8_t requestFrom(uint8_t address, uint8_t quantity, bool sendStop = true);
+  uint8_t requestFrom(int address, int quantity) { return requestFrom((uint8_t)address, (uint8_t)quantity); }
+#ifdef I2C_SIMULATED_BUS
+  int available();
+  int read();
+#else
+  int available() { return wire_.available(); }
+  int read() { return wire_.read(); }
+#endif
+
+  // Re-initializes the peripheral and charges the reset to the given device
+  void resetBus(uint8_t address = 0);
+  // Frees a target holding SDA low: clocks SCL up to 9 times as GPIO, sends a
+  // STOP and re-initializes the peripheral. Returns false if SDA is still low.
+  bool recoverBus(uint8_t address = 0);
+
+  // Telemetry
+  void registerDevice(uint8_t address, const char *name);
+  void recordTimeout(uint8_t address = 0);
+  const I2CDeviceStats *getStats(uint8_t address) const;
+  const I2CDeviceStats &getStatsAt(uint8_t index) const { return stats_[index]; }
+  uint8_t getDeviceCount() const { return deviceCount_; }
+  void resetStats();
+  void printStats(Print &out) const;
+
+#ifdef I2C_SIMULATED_BUS
+  // Routes every transaction to this address to the model instead of the wire
+  void attachSimDevice(uint8_t address, I2CSimDevice *device);
+#endif
+
+private:
+  TwoWire &wire_;
+  uint32_t clock_ = 100000;
+  uint8_t sdaPin_ = 17; // Wire1 defaults
+  uint8_t sclPin_ = 16;
+  I2CDeviceStats stats_[I2C_BUS_MAX_DEVICES];
+  uint8_t deviceCount_ = 1; // Slot 0 is the bus itself
+
+  // Pending write transaction
+  uint8_t txAddress_ = 0;
+  uint8_t txBytes_ = 0;
+  bool txActive_ = false;
+  uint32_t txStart_ = 0;
+
+#ifdef I2C_SIMULATED_BUS
+  I2CSimDevice *simDevices_[128] = {};
+  I2CSimDevice *simTxDevice_ = nullptr;
+  uint8_t simTx_[I2C_SIM_BUFFER_SIZE];
+  uint8_t simRx_[I2C_SIM_BUFFER_SIZE];
+  uint8_t simRxLength_ = 0;
+  uint8_t simRxIndex_ = 0;
+  bool simReading_ = false;
+  uint8_t simSdaHeld_ = 0; // Remaining SCL pulses before a stuck SDA is released
+  bool simFault_(I2CSimDevice *device, uint16_t every);
+  void simHoldSda_(I2CSimDevice *device);
+#endif
+
+  bool sdaHigh_();
+  I2CDeviceStats &statsFor_(uint8_t address);
+  void recordTransaction_(I2CDeviceStats &stats, uint32_t latencyUs, uint8_t bytes);
+};
+
+extern I2CBus i2cBus;
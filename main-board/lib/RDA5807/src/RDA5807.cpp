@@ -81,14 +81,14 @@ void RDA5807::getStatusRegisters()
     word16_to_bytes aux;
     int i;
 
-    Wire1.requestFrom(this->deviceAddressFullAccess, 12); // This call starts reading from 0x0A register
+    i2cBus.requestFrom(this->deviceAddressFullAccess, 12); // This call starts reading from 0x0A register
     for (i = 0; i < 6; i++)
     {
-        aux.refined.highByte = Wire1.read();
-        aux.refined.lowByte = Wire1.read();
+        aux.refined.highByte = i2cBus.read();
+        aux.refined.lowByte = i2cBus.read();
         shadowStatusRegisters[i] = aux.raw;
     }
-    Wire1.endTransmission();
+    i2cBus.endTransmission();
 }
 
 /**
@@ -103,13 +103,13 @@ word16_to_bytes RDA5807::getDirectRegister(uint8_t reg)
 {
 
     word16_to_bytes aux;
-    Wire1.beginTransmission(this->deviceAddressDirectAccess);
-    Wire1.write(reg);
-    Wire1.endTransmission(false);
-    Wire1.requestFrom(this->deviceAddressDirectAccess, 2);
-    aux.refined.highByte = Wire1.read();
-    aux.refined.lowByte = Wire1.read();
-    Wire1.endTransmission();
+    i2cBus.beginTransmission(this->deviceAddressDirectAccess);
+    i2cBus.write(reg);
+    i2cBus.endTransmission(false);
+    i2cBus.requestFrom(this->deviceAddressDirectAccess, 2);
+    aux.refined.highByte = i2cBus.read();
+    aux.refined.lowByte = i2cBus.read();
+    i2cBus.endTransmission();
 
     return aux;
 }
@@ -128,14 +128,14 @@ void *RDA5807::getStatus(uint8_t reg)
     if (reg < 0x0A || reg > 0x0F)
         return NULL; // Maybe not necessary.
 
-    Wire1.beginTransmission(this->deviceAddressDirectAccess);
-    Wire1.write(reg);
-    Wire1.endTransmission(false);
-    Wire1.requestFrom(this->deviceAddressDirectAccess, 2); // reading 0x0A register
+    i2cBus.beginTransmission(this->deviceAddressDirectAccess);
+    i2cBus.write(reg);
+    i2cBus.endTransmission(false);
+    i2cBus.requestFrom(this->deviceAddressDirectAccess, 2); // reading 0x0A register
     delayMicroseconds(250);
-    aux.refined.highByte = Wire1.read();
-    aux.refined.lowByte = Wire1.read();
-    Wire1.endTransmission(true);
+    aux.refined.highByte = i2cBus.read();
+    aux.refined.lowByte = i2cBus.read();
+    i2cBus.endTransmission(true);
     shadowStatusRegisters[reg - 0x0A] = aux.raw;
 
     return &shadowStatusRegisters[reg - 0x0A];
@@ -156,12 +156,12 @@ void RDA5807::setRegister(uint8_t reg, uint16_t value)
     word16_to_bytes aux;
     if (reg > 8)
         return; // Maybe not necessary.
-    Wire1.beginTransmission(this->deviceAddressDirectAccess);
-    Wire1.write(reg);
+    i2cBus.beginTransmission(this->deviceAddressDirectAccess);
+    i2cBus.write(reg);
     aux.raw = value;
-    Wire1.write(aux.refined.highByte);
-    Wire1.write(aux.refined.lowByte);
-    Wire1.endTransmission();
+    i2cBus.write(aux.refined.highByte);
+    i2cBus.write(aux.refined.lowByte);
+    i2cBus.endTransmission();
     shadowRegisters[reg] = aux.raw; // Updates the shadowRegisters element
     delayMicroseconds(3000);        // Check
 }
@@ -276,7 +276,7 @@ void RDA5807::setup(uint8_t clock_frequency, uint8_t oscillator_type, uint8_t rl
     this->clockFrequency = clock_frequency;
     this->rlckNoCalibrate = rlck_no_calibrate;
 
-    Wire1.begin();
+    i2cBus.begin();
 
     delay(10);
     powerUp();
@@ -577,6 +577,116 @@ void RDA5807::seek(uint8_t seek_mode, uint8_t direction, void (*showFunc)())
     setFrequency(getRealFrequency()); // Fixes station found.
 }
 
+/**
+ * @ingroup GA03
+ * @brief Starts tuning a frequency and returns without waiting for the end of the tune
+ * @details Call isTuneComplete until it returns true. Useful when the I2C bus is shared and can't be held for the whole tune.
+ * @param frequency  frequency in 10 kHz units (e.g. 10390 for 103.9 MHz)
+ * @see setFrequency, isTuneComplete
+ */
+void RDA5807::startTune(uint16_t frequency)
+{
+    uint16_t channel = (frequency - this->startBand[currentFMBand]) / (this->fmSpace[this->currentFMSpace]);
+    reg03->refined.CHAN = channel;
+    reg03->refined.TUNE = 1;
+    reg03->refined.BAND = this->currentFMBand;
+    reg03->refined.SPACE = this->currentFMSpace;
+    reg03->refined.DIRECT_MODE = 0;
+    setRegister(REG03, reg03->raw);
+    this->currentFrequency = frequency;
+}
+
+/**
+ * @ingroup GA03
+ * @brief Starts a seek and returns without waiting for the end of the seek
+ * @details Call isTuneComplete until it returns true, getReadFrequency then gives the channel reached so far. Call finishSeek once complete.
+ * @param seek_mode  Seek Mode; 0 = Wrap at the upper or lower band limit and continue seeking (default); 1 = Stop seeking at the upper or lower band limit.
+ * @param direction  Seek Direction; 0 = Seek down (default); 1 = Seek up.
+ * @see seek, isTuneComplete, finishSeek
+ */
+void RDA5807::startSeek(uint8_t seek_mode, uint8_t direction)
+{
+    reg02->refined.SEEK = 1;
+    reg02->refined.SKMODE = seek_mode;
+    reg02->refined.SEEKUP = direction;
+    setRegister(REG02, reg02->raw);
+}
+
+/**
+ * @ingroup GA03
+ * @brief Checks the STC (Seek/Tune Complete) bit
+ * @details Reads the 0x0A register once, see waitAndFinishTune for the blocking version.
+ * @return true when the last tune or seek is complete
+ * @see startTune, startSeek, getReadFrequency
+ */
+bool RDA5807::isTuneComplete()
+{
+    getStatus(REG0A);
+    return reg0a->refined.STC;
+}
+
+/**
+ * @ingroup GA03
+ * @brief Ends a seek started by startSeek
+ * @details The chip clears the SEEK bit by itself, this keeps the shadow register in sync so the next write to 0x02 doesn't start another seek.
+ * @details Like seek, you should then tune the frequency found (startTune) so the 0x03 register follows.
+ * @return uint16_t frequency found, in 10 kHz units
+ * @see startSeek
+ */
+uint16_t RDA5807::finishSeek()
+{
+    reg02->refined.SEEK = 0;
+    this->currentFrequency = getReadFrequency();
+    return this->currentFrequency;
+}
+
+/**
+ * @ingroup GA03
+ * @brief Reads the configuration registers (0x02 to 0x07) back into the shadow registers
+ * @details Useful when the MCU restarts while the receiver stays powered: the shadow registers, band, space and volume then follow the device without a new setup.
+ * @details Self clearing bits (soft reset, seek and tune) are cleared so the next write doesn't trigger them again.
+ * @see restoreTune
+ */
+void RDA5807::loadRegisters()
+{
+    for (uint8_t reg = REG02; reg <= REG07; reg++)
+        shadowRegisters[reg] = getDirectRegister(reg).raw;
+
+    reg02->refined.SOFT_RESET = 0;
+    reg02->refined.SEEK = 0;
+    reg03->refined.TUNE = 0;
+    this->currentFMBand = reg03->refined.BAND;
+    this->currentFMSpace = reg03->refined.SPACE;
+    this->currentVolume = reg05->refined.VOLUME;
+}
+
+/**
+ * @ingroup GA03
+ * @brief Writes the 0x02 to 0x05 shadow registers and starts tuning a frequency in a single sequential write
+ * @details Sequential writes (full access address) always start at the 0x02 register. Like startTune, call isTuneComplete until it returns true.
+ * @param frequency  frequency in 10 kHz units (e.g. 10390 for 103.9 MHz)
+ * @see loadRegisters, startTune, isTuneComplete
+ */
+void RDA5807::restoreTune(uint16_t frequency)
+{
+    word16_to_bytes aux;
+    uint16_t channel = (frequency - this->startBand[currentFMBand]) / (this->fmSpace[this->currentFMSpace]);
+    reg03->refined.CHAN = channel;
+    reg03->refined.TUNE = 1;
+    reg03->refined.DIRECT_MODE = 0;
+
+    i2cBus.beginTransmission(this->deviceAddressFullAccess);
+    for (uint8_t reg = REG02; reg <= REG05; reg++)
+    {
+        aux.raw = shadowRegisters[reg];
+        i2cBus.write(aux.refined.highByte);
+        i2cBus.write(aux.refined.lowByte);
+    }
+    i2cBus.endTransmission();
+    reg03->refined.TUNE = 0;
+    this->currentFrequency = frequency;
+}
+
 /**
  * @ingroup GA03
  * @brief Sets RSSI Seek Threshold
@@ -1362,13 +1472,13 @@ void RDA5807::convertToChar(uint16_t value, char *strValue, uint8_t len, uint8_t
  */
 int RDA5807::checkI2C(uint8_t *addressArray)
 {
-    Wire1.begin();
+    i2cBus.begin();
     int error, address;
     int idx = 0;
     for (address = 1; address < 127; address++)
     {
-        Wire1.beginTransmission(address);
-        error = Wire1.endTransmission();
+        i2cBus.beginTransmission(address);
+        error = i2cBus.endTransmission();
         if (error == 0)
         {
             addressArray[idx] = address;
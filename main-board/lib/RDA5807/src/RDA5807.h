@@ -25,6 +25,7 @@
 
 #include <Arduino.h>
 #include <Wire.h>
+#include <I2CBus.h>
 
 #define MAX_DELAY_AFTER_OSCILLATOR 100 // Max delay after the crystal oscilator becomes active
 
@@ -731,6 +732,52 @@ public:
     void setChannel(uint16_t channel);
     void seek(uint8_t seek_mode, uint8_t direction);
     void seek(uint8_t seek_mode, uint8_t direction, void (*showFunc)());
+    void startTune(uint16_t frequency);
+    void startSeek(uint8_t seek_mode, uint8_t direction);
+    bool isTuneComplete();
+    uint16_t finishSeek();
+    void loadRegisters();
+    void restoreTune(uint16_t frequency);
+
+    /**
+     * @ingroup GA03
+     * @brief Returns true if the 0x02 register has the receiver enabled, unmuted and with a normal audio output
+     * @details Reflects the shadow register, call loadRegisters first to check the device itself.
+     * @see loadRegisters
+     */
+    inline bool isPoweredUp() { return reg02->refined.ENABLE && reg02->refined.DMUTE && reg02->refined.DHIZ; };
+
+    /**
+     * @ingroup GA03
+     * @brief Returns the RSSI seek threshold
+     * @see setSeekThreshold
+     */
+    inline uint8_t getSeekThreshold() { return reg05->refined.SEEKTH; };
+
+    /**
+     * @ingroup GA03
+     * @brief Gets the frequency of the channel in the last 0x0A register read
+     * @details Unlike getRealFrequency, doesn't read the register again. Shows the seek progress when called after isTuneComplete.
+     * @see isTuneComplete, getRealFrequency
+     * @return uint16_t frequency in 10 kHz units
+     */
+    inline uint16_t getReadFrequency() { return reg0a->refined.READCHAN * fmSpace[currentFMSpace] + startBand[currentFMBand]; };
+
+    /**
+     * @ingroup GA03
+     * @brief Gets the RSSI in the last 0x0B register read
+     * @details Unlike getRssi, doesn't read the register again. getRdsReady reads all the status registers.
+     * @see getRssi, getRdsReady
+     */
+    inline uint8_t getReadRssi() { return reg0b->refined.RSSI; };
+
+    /**
+     * @ingroup GA03
+     * @brief Gets the stereo indicator in the last 0x0A register read
+     * @details Unlike isStereo, doesn't read the register again.
+     * @see isStereo, getRdsReady
+     */
+    inline bool isReadStereo() { return reg0a->refined.ST; };
     void setSeekThreshold(uint8_t value);
 
     void setBand(uint8_t band = 0);
@@ -850,11 +897,23 @@ public:
     void setVolumeDown();
 
     void setFmDeemphasis(uint8_t de);
+    /**
+     * @ingroup GA07
+     * @brief Gets the de-emphasis
+     * @return 0 = 75 μs; 1 = 50 μs
+     */
+    inline uint8_t getFmDeemphasis() { return reg04->refined.DE; };
 
     //******** RDS methods
     void setRDS(bool value);
     void setRBDS(bool value);
     void setRdsFifo(bool value);
+    /**
+     * @ingroup GA04
+     * @brief Returns true if both RDS and the RDS fifo mode are enabled
+     * @see setRDS, setRdsFifo
+     */
+    inline bool isRdsFifoEnabled() { return reg02->refined.RDS_EN && reg04->refined.RDS_FIFO_EN; };
     void clearRdsFifo(bool value = 1);
     void clearRdsBuffer();
 
@@ -965,6 +1024,22 @@ public:
         return reg0b->refined.BLERB;
     }
 
+    /**
+     * @ingroup GA04
+     * @brief Gets the raw RDS blocks of the current group
+     * @details You must call getRdsReady before calling this function
+     * @details Avoids the extra I2C reads of the getRdsText functions when the group is decoded by the caller
+     * @see getRdsReady, getErrorBlockA, getErrorBlockB
+     * @param blocks array of 4 words receiving blocks A, B, C and D (registers 0cH to 0fH)
+     */
+    inline void getRdsBlocks(uint16_t *blocks)
+    {
+        blocks[0] = reg0c->RDSA;
+        blocks[1] = reg0d->RDSB;
+        blocks[2] = reg0e->RDSC;
+        blocks[3] = reg0f->RDSD;
+    }
+
     /**
      * @ingroup GA04
      * @brief Returns true when the RDS system has valid information
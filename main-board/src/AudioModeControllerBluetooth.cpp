@@ -2,8 +2,7 @@
 
 void AudioModeControllerBluetooth::enter()
 {
-  setMixerGains();
-  configureCodec();
+  applyAudioProfile();
   updateOutputVolume();
   setDisplayTheme();
   i2c.setCurrentMode(MODE_BLUETOOTH);
@@ -20,13 +19,18 @@ void AudioModeControllerBluetooth::loop()
 
 void AudioModeControllerBluetooth::frameLoop()
 {
-  display.drawBtIcon(i2c.getMetadata().isConnected);
+  const Metadata &metadata = i2c.getMetadata();
+  display.drawBtIcon(metadata.isConnected);
 
-  if (i2c.getMetadata().isPlaying && !display.hasTemporaryMetadata())
+  if (metadata.isPlaying && !display.hasTemporaryMetadata())
   {
-    display.setMetadata(
-        (char *)i2c.getMetadata().title.c_str(),
-        (char *)i2c.getMetadata().artist.c_str());
+    String line2 = metadata.album.length() ? metadata.artist + " - " + metadata.album : metadata.artist;
+    display.setMetadata(metadata.title.c_str(), line2.c_str());
+    if (!isEqMode)
+    {
+      // Interpolated between the position reports of the sink
+      display.drawProgressBar(metadata.getPosition(), metadata.duration);
+    }
   }
 
   if (isEqMode)
@@ -95,29 +99,3 @@ void AudioModeControllerBluetooth::handleControl(ControlCommand cmd)
     break;
   }
 }
-
-void AudioModeControllerBluetooth::setMixerGains()
-{
-  auto *mono = audio.getMonoDownmixer();
-  auto *main = audio.getMainMixer();
-  auto *fftInput = audio.getFFTInputMixer();
-
-  mono->gain(0, 0.9); // BT audio L
-  mono->gain(1, 0.1); // BT audio R
-  mono->gain(2, 0.0); // Radio audio L
-  mono->gain(3, 0.0); // Radio audio R
-  main->gain(0, 1.0); // BT audio
-  main->gain(1, 0.0); // SD card audio L
-  main->gain(2, 0.0); // SD card audio R
-  main->gain(3, 0.6); // In memory audio
-
-  fftInput->gain(0, 1.0); // BT/SD/Radio source
-  fftInput->gain(1, 0.0); // Mic source
-}
-
-void AudioModeControllerBluetooth::configureCodec()
-{
-  auto *codec = audio.getCodec();
-  codec->volume(0.6);
-  codec->enhanceBassEnable();
-}
\ No newline at end of file
@@ -3,8 +3,7 @@
 void AudioModeControllerNFCPlayer::enter()
 {
   updateOutputVolume();
-  setMixerGains();
-  configureCodec();
+  applyAudioProfile();
   setDisplayTheme();
   i2c.setCurrentMode(MODE_NFC_PLAYBACK);
   currentFolder = i2c.getIOState().nfcUidString.c_str();
@@ -127,24 +126,3 @@ void AudioModeControllerNFCPlayer::handleControl(ControlCommand cmd)
     break;
   }
 }
-
-void AudioModeControllerNFCPlayer::setMixerGains()
-{
-  auto *main = audio.getMainMixer();
-  auto *fftInput = audio.getFFTInputMixer();
-
-  main->gain(0, 0.0); // BT or radio audio
-  main->gain(1, 0.4); // SD card audio L
-  main->gain(2, 0.4); // SD card audio R
-  main->gain(3, 0.4); // In memory audio
-
-  fftInput->gain(0, 1.0); // BT/SD/Radio source
-  fftInput->gain(1, 0.0); // Mic source
-}
-
-void AudioModeControllerNFCPlayer::configureCodec()
-{
-  auto *codec = audio.getCodec();
-  codec->volume(0.65);
-  codec->enhanceBassEnable();
-}
\ No newline at end of file
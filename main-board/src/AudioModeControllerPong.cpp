@@ -7,9 +7,8 @@
 void AudioModeControllerPong::enter()
 {
   LOG("Entering Pong mode");
-  audio.getOutputAmp()->gain(0.1);
-  audio.getBitcrusher()->bits(8);
-  audio.getBitcrusher()->sampleRate(11025);
+  applyAudioProfile();
+  audio.setOutputGain(0.1);
   i2c.getTimer().setFastIO(true);
   resetBall();
 }
@@ -20,15 +19,6 @@ void AudioModeControllerPong::exit()
   i2c.getTimer().setFastIO(false);
 }
 
-void AudioModeControllerPong::setMixerGains()
-{
-  auto *main = audio.getMainMixer();
-  main->gain(0, 0.0); // BT or radio audio
-  main->gain(1, 0.0); // SD card audio L
-  main->gain(2, 0.0); // SD card audio R
-  main->gain(3, 0.4); // In memory audio
-}
-
 void AudioModeControllerPong::handleOrangeButton(bool pressed)
 {
   if (pressed)
@@ -2,11 +2,11 @@
 
 void AudioModeControllerRadio::enter()
 {
-  setMixerGains();
-  configureCodec();
+  applyAudioProfile();
   updateOutputVolume();
   setDisplayTheme();
   i2c.setCurrentMode(MODE_RADIO);
+  signalBars = 0xFF;
   if (!radio.isInitialized())
   {
     radio.init();
@@ -15,6 +15,7 @@ void AudioModeControllerRadio::enter()
 
 void AudioModeControllerRadio::exit()
 {
+  radio.stopScan();
 }
 
 void AudioModeControllerRadio::loop()
@@ -25,17 +26,63 @@ void AudioModeControllerRadio::loop()
   }
   else
   {
+    // Scan the band while nobody is listening, the tuner hops between channels
+    if (isMuted || i2c.getIOState().volume < SCAN_MAX_VOLUME)
+    {
+      radio.startScan();
+    }
+    else
+    {
+      radio.stopScan();
+    }
     radio.update();
+    radio.saveStations();
   }
 }
 
 void AudioModeControllerRadio::frameLoop()
 {
-  if (radio.newRDSMsg || radio.newStationName || SNVS_LPGPR0 != freq)
+  // Show the channels swept by a seek or the band scan
+  uint16_t newSweepFreq = 0;
+  const char *sweepLabel = "Seeking";
+  if (radio.isScanning())
+  {
+    newSweepFreq = radio.getScanFrequency();
+    sweepLabel = "Scanning";
+  }
+  else if (radio.isTuning())
   {
+    newSweepFreq = radio.getTuneFrequency();
+  }
+
+  if (radio.newRDSMsg || radio.newStationName || SNVS_LPGPR0 != freq || newSweepFreq != sweepFreq)
+  {
+    sweepFreq = newSweepFreq;
     char freqDisplay[30];
-    sprintf(freqDisplay, "%s Mhz %s", radio.getFrequencyString(), radio.stationName != nullptr ? radio.stationName : (char *)"");
+    if (sweepFreq)
+    {
+      sprintf(freqDisplay, "%s %u.%u Mhz", sweepLabel, sweepFreq / 100, (sweepFreq % 100) / 10);
+    }
+    else
+    {
+      sprintf(freqDisplay, "%s Mhz %s", radio.getFrequencyString(), radio.stationName != nullptr ? radio.stationName : (char *)"");
+    }
     display.setMetadata(isMuted ? (char *)"Muted (Play to unmute)" : (radio.rdsMsg != nullptr ? radio.rdsMsg : (char *)""), freqDisplay);
+    radio.newRDSMsg = false;
+    radio.newStationName = false;
+  }
+
+  if (SHOW_SIGNAL_BAR && !radio.isScanning())
+  {
+    const SignalQuality &signal = radio.getSignal();
+    uint8_t bars = signal.getBars();
+    bool stereo = signal.getStereoPercent() > 50;
+    if (bars != signalBars || stereo != signalStereo)
+    {
+      signalBars = bars;
+      signalStereo = stereo;
+      display.drawSignalBar(bars, SignalQuality::BARS, stereo);
+    }
   }
 
   // Check for favorite save
@@ -67,7 +114,6 @@ void AudioModeControllerRadio::handleOrangeButton(bool pressed)
       {
         radio.resetRDSData();
         radio.setFrequency(savedFreq);
-        radio.waitSeekComplete();
         char freqStr[12];
         sprintf(freqStr, "%s Mhz", radio.getFrequencyString());
         display.setTemporaryMetadata(freqStr, "Favorite loaded", 3000);
@@ -102,21 +148,3 @@ void AudioModeControllerRadio::handleControl(ControlCommand cmd)
     break;
   }
 }
-
-void AudioModeControllerRadio::setMixerGains()
-{
-  auto *mono = audio.getMonoDownmixer();
-  auto *main = audio.getMainMixer();
-  auto *fftInput = audio.getFFTInputMixer();
-  mono->gain(0, 0.0); // BT audio L
-  mono->gain(1, 0.0); // BT audio R
-  mono->gain(2, 0.5); // Radio audio L
-  mono->gain(3, 0.5); // Radio audio R
-  main->gain(0, 1.0); // Radio audio
-  main->gain(1, 0.0); // SD card audio L
-  main->gain(2, 0.0); // SD card audio R
-  main->gain(3, 0.5); // In memory audio
-
-  fftInput->gain(0, 1.0); // BT/SD/Radio source
-  fftInput->gain(1, 0.0); // Mic source
-}
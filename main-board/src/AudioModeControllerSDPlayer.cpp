@@ -3,8 +3,7 @@
 void AudioModeControllerSDPlayer::enter()
 {
   updateOutputVolume();
-  setMixerGains();
-  configureCodec();
+  applyAudioProfile();
   setDisplayTheme();
   i2c.setCurrentMode(MODE_SD_PLAYBACK);
   recorder.setReverseAlphabeticalOrder(true);
@@ -100,24 +99,3 @@ void AudioModeControllerSDPlayer::handleControl(ControlCommand cmd)
     break;
   }
 }
-
-void AudioModeControllerSDPlayer::setMixerGains()
-{
-  auto *main = audio.getMainMixer();
-  auto *fftInput = audio.getFFTInputMixer();
-
-  main->gain(0, 0.0); // BT or radio audio
-  main->gain(1, 0.5); // SD card audio L
-  main->gain(2, 0.5); // SD card audio R
-  main->gain(3, 0.3); // In memory audio
-
-  fftInput->gain(0, 1.0); // BT/SD/Radio source
-  fftInput->gain(1, 0.0); // Mic source
-}
-
-void AudioModeControllerSDPlayer::configureCodec()
-{
-  auto *codec = audio.getCodec();
-  codec->volume(0.8);
-  codec->enhanceBassDisable(); // Disable bass enhancement for SD playback
-}
\ No newline at end of file
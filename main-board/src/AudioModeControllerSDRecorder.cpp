@@ -2,8 +2,7 @@
 
 void AudioModeControllerSDRecorder::enter()
 {
-  setMixerGains();
-  configureCodec();
+  applyAudioProfile();
   setDisplayTheme();
   i2c.setCurrentMode(MODE_SD_RECORDER);
   updateOutputVolume(); // This will mute output in recorder mode
@@ -61,33 +60,10 @@ void AudioModeControllerSDRecorder::handleControl(ControlCommand cmd)
   // All controls are handled through the orange button
 }
 
-void AudioModeControllerSDRecorder::setMixerGains()
-{
-  auto *main = audio.getMainMixer();
-  auto *fftInput = audio.getFFTInputMixer();
-
-  main->gain(0, 0.0); // BT or radio audio
-  main->gain(1, 0.0); // SD card audio L
-  main->gain(2, 0.0); // SD card audio R
-  main->gain(3, 0.4); // In memory audio
-
-  fftInput->gain(0, 0.0); // BT/SD/Radio source
-  fftInput->gain(1, 1.0); // Mic source
-}
-
-void AudioModeControllerSDRecorder::configureCodec()
-{
-  auto *codec = audio.getCodec();
-  codec->volume(0.8);
-  codec->inputSelect(AUDIO_INPUT_MIC);
-  codec->micGain(20);
-  codec->enhanceBassDisable();
-}
-
 // void AudioModeControllerSDRecorder::updateOutputVolume()
 // {
 //   // Always mute output in recorder mode to prevent feedback
-//   audio.getOutputAmp()->gain(0);
+//   audio.setOutputGain(0, false);
 // }
 
 AudioAnalyzePeak *AudioModeControllerSDRecorder::getPeak()
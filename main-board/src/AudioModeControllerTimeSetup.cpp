@@ -4,6 +4,7 @@
 
 void AudioModeControllerTimeSetup::enter()
 {
+  applyAudioProfile(); // Radio stays muted
   display.clear();
   display.update();
 }
@@ -14,13 +15,43 @@ void AudioModeControllerTimeSetup::exit()
 
 void AudioModeControllerTimeSetup::loop()
 {
+  if (!radio.isInitialized())
+  {
+    radio.init();
+    return;
+  }
+  updateRadioTime();
+}
+
+void AudioModeControllerTimeSetup::updateRadioTime()
+{
+  // The last station is lost with the coin cell, find one with RDS
+  if (!radio.hasValidFrequency() && !radio.isTuning() && !radio.isScanning() && !radio.tuneStrongestStation())
+  {
+    radio.startScan();
+  }
+  radio.update();
+  radio.saveStations();
+
+  if (!timeSetComplete && radio.getClockSync().hasSynced())
+  {
+    time_t t = now();
+    tempYear = year(t);
+    tempMonth = month(t);
+    tempDay = day(t);
+    tempHours = hour(t);
+    tempMinutes = minute(t);
+    timeSetComplete = true;
+    timeFromRadio = true;
+    playBeep();
+  }
 }
 
 const char *AudioModeControllerTimeSetup::getStageInstructions()
 {
   if (timeSetComplete)
   {
-    return "Time set complete";
+    return timeFromRadio ? "Time set from radio" : "Time set complete";
   }
   switch (currentStage)
   {
@@ -182,6 +213,8 @@ void AudioModeControllerTimeSetup::frameLoop()
       display.tft.print("Press ORANGE BUTTON");
       display.tft.setCursor(20, 200);
       display.tft.print("to confirm");
+      display.tft.setCursor(20, 220);
+      display.tft.print("or wait for the radio clock");
     }
   }
 }
@@ -195,6 +228,10 @@ void AudioModeControllerTimeSetup::handleOrangeButton(bool pressed)
     }
     return; // Only handle button release
   }
+  if (timeSetComplete)
+  {
+    return;
+  }
 
   switch (currentStage)
   {
@@ -34,10 +34,13 @@ void AudioSystem::init()
   AudioMemory(160);
 
   // Set initial mixer gains to 0 to prevent audio bleed during boot
-  mixerMain.gain(0, 0.0); // BT+Radio audio
-  mixerMain.gain(1, 0.0); // SD card audio L
-  mixerMain.gain(2, 0.0); // SD card audio R
-  mixerMain.gain(3, 1.0); // Boot sound only
+  for (uint8_t i = 0; i < GAIN_COUNT; i++)
+  {
+    setGain_(i, 0.0, false);
+  }
+  setGain_(GAIN_MAIN + 3, 1.0, false); // Boot sound only
+  setGain_(GAIN_FFT, 1.0, false);      // BT/SD/Radio source
+  setGain_(GAIN_OUTPUT, 1.0, false);
 
   recorderAmp.gain(3.0);
 
@@ -45,6 +48,7 @@ void AudioSystem::init()
   sgtl5000_1.enable();
   sgtl5000_1.muteLineout();
   sgtl5000_1.volume(0.4);
+  codecVolume_ = 0.4;
   sgtl5000_1.adcHighPassFilterDisable();
   sgtl5000_1.audioPostProcessorEnable();
   sgtl5000_1.eqBands(bandValues[0],
@@ -61,8 +65,136 @@ void AudioSystem::init()
   biquad2.setLowShelf(1, 100, -4, 0.9);
 
   // Configure bitcrusher
-  bitcrusher1.bits(16);
-  bitcrusher1.sampleRate(44100);
+  setBitcrusher(16, 44100);
+}
+
+void AudioSystem::applyProfile(const AudioProfile &profile)
+{
+  for (uint8_t i = 0; i < 4; i++)
+  {
+    setGain_(GAIN_MONO + i, profile.monoGains[i], true);
+    setGain_(GAIN_MAIN + i, profile.mainGains[i], true);
+  }
+  for (uint8_t i = 0; i < 2; i++)
+  {
+    setGain_(GAIN_FFT + i, profile.fftGains[i], true);
+  }
+
+  // Each of these is an I2C transaction with the codec
+  if (profile.codecVolume != codecVolume_)
+  {
+    sgtl5000_1.volume(profile.codecVolume);
+    codecVolume_ = profile.codecVolume;
+  }
+  if (profile.bassEnhance != bassEnhance_)
+  {
+    if (profile.bassEnhance)
+      sgtl5000_1.enhanceBassEnable();
+    else
+      sgtl5000_1.enhanceBassDisable();
+    bassEnhance_ = profile.bassEnhance;
+  }
+  // Selecting the input resets its level
+  if (profile.input != input_ || profile.inputLevel != inputLevel_)
+  {
+    if (profile.input != input_)
+    {
+      sgtl5000_1.inputSelect(profile.input == AUDIO_PROFILE_MIC ? AUDIO_INPUT_MIC : AUDIO_INPUT_LINEIN);
+      input_ = profile.input;
+    }
+    if (profile.input == AUDIO_PROFILE_MIC)
+      sgtl5000_1.micGain(profile.inputLevel);
+    else
+      sgtl5000_1.lineInLevel(profile.inputLevel);
+    inputLevel_ = profile.inputLevel;
+  }
+
+  setBitcrusher(profile.bits, profile.sampleRate);
+}
+
+void AudioSystem::setOutputGain(float gain, bool ramp)
+{
+  setGain_(GAIN_OUTPUT, gain, ramp);
+}
+
+void AudioSystem::setBitcrusher(uint8_t bits, uint16_t sampleRate)
+{
+  if (bits != bits_)
+  {
+    bitcrusher1.bits(bits);
+    bits_ = bits;
+  }
+  if (sampleRate != sampleRate_)
+  {
+    bitcrusher1.sampleRate(sampleRate);
+    sampleRate_ = sampleRate;
+  }
+}
+
+void AudioSystem::update()
+{
+  uint32_t blocks = (micros() - lastRampUpdate_) / BLOCK_US;
+  if (blocks == 0)
+  {
+    return;
+  }
+  lastRampUpdate_ += blocks * BLOCK_US;
+
+  for (uint8_t i = 0; i < GAIN_COUNT; i++)
+  {
+    GainRamp &ramp = gains_[i];
+    if (ramp.current == ramp.target)
+    {
+      continue;
+    }
+    float remaining = ramp.target - ramp.current;
+    float change = ramp.step * blocks;
+    ramp.current = fabsf(change) >= fabsf(remaining) ? ramp.target : ramp.current + change;
+    writeGain_(i, ramp.current);
+  }
+}
+
+bool AudioSystem::isRamping() const
+{
+  for (uint8_t i = 0; i < GAIN_COUNT; i++)
+  {
+    if (gains_[i].current != gains_[i].target)
+      return true;
+  }
+  return false;
+}
+
+void AudioSystem::setGain_(uint8_t index, float gain, bool ramp)
+{
+  GainRamp &gainRamp = gains_[index];
+  if (!ramp)
+  {
+    gainRamp.current = gainRamp.target = gain;
+    writeGain_(index, gain);
+    return;
+  }
+  if (gain == gainRamp.target)
+  {
+    return;
+  }
+  if (!isRamping())
+  {
+    lastRampUpdate_ = micros();
+  }
+  gainRamp.target = gain;
+  gainRamp.step = (gain - gainRamp.current) / RAMP_BLOCKS;
+}
+
+void AudioSystem::writeGain_(uint8_t index, float gain)
+{
+  if (index < GAIN_MAIN)
+    mixerMonoDownmix.gain(index - GAIN_MONO, gain);
+  else if (index < GAIN_FFT)
+    mixerMain.gain(index - GAIN_MAIN, gain);
+  else if (index < GAIN_OUTPUT)
+    mixerFFTInput.gain(index - GAIN_FFT, gain);
+  else
+    outputAmp.gain(gain);
 }
 
 void AudioSystem::setBandValue(int band, float value)
@@ -0,0 +1,21 @@
+#include "BootTimeline.h"
+
+void BootTimeline::markAt(const char *phase, unsigned long time)
+{
+  if (count_ == MAX_PHASES)
+  {
+    return;
+  }
+  phases_[count_++] = {phase, time};
+}
+
+void BootTimeline::print(Print &out) const
+{
+  out.printf("Boot timeline (%d phases)\n", count_);
+  unsigned long previous = 0;
+  for (uint8_t i = 0; i < count_; i++)
+  {
+    out.printf("  %-14s %6lu ms  +%lu\n", phases_[i].name, phases_[i].time, phases_[i].time - previous);
+    previous = phases_[i].time;
+  }
+}
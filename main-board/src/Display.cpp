@@ -5,15 +5,17 @@
 #include "font/neuropolitical_12.h"
 #include "sprites/sprites.h"
 #include "Log.h"
+#include "BootTimeline.h"
+#include <I2CBus.h>
 
 DMAMEM uint16_t _fb1[320 * 240];
+static PanelBackend panel;
 
-Display::Display(void) : tft(TFT_CS, TFT_DC, TFT_RST, TFT_MOSI, TFT_SCK, TFT_MISO) {};
+Display::Display(void) : tft(TFT_CS, TFT_DC, TFT_RST, TFT_MOSI, TFT_SCK, TFT_MISO), backend(&panel) {};
 
 void Display::init()
 {
-  tft.begin();
-  tft.invertDisplay(true); // True for IPS display
+  backend->begin(tft);
   tft.setRotation(ROTATION);
   tft.useFrameBuffer(true);
   tft.setFrameBuffer(_fb1);
@@ -32,12 +34,16 @@ void Display::update()
   {
     handleSplashScreen(); // Call the new function to handle splash screen logic
   }
-  tft.updateScreen();
+  backend->push(tft);
+  pushCount++;
 }
 
 void Display::updateAsync()
 {
-  tft.updateScreenAsync(false);
+  if (backend->pushAsync(tft))
+  {
+    pushCount++;
+  }
 }
 
 // Handle splash screen logic
@@ -151,7 +157,7 @@ void Display::updateClock()
 
 void Display::debugText(char *text)
 {
-  LOG_DISPLAY_MSG(text);
+  LOG_DISPLAY_MSGF("%s\n", text);
   tft.setFont(neuropolitical_10);
   tft.setTextSize(2);
   tft.fillRect(20, 0, 200, 40, ILI9341_BLACK);
@@ -160,6 +166,55 @@ void Display::debugText(char *text)
   tft.print(text);
 }
 
+void Display::drawI2CStats()
+{
+  // One line per device, drawn over the spectrum with the small built-in font
+  tft.setFontAdafruit();
+  tft.setTextSize(1);
+  tft.fillRect(0, 40, 320, 10 * i2cBus.getDeviceCount() + 4, ILI9341_BLACK);
+  tft.setTextColor(ILI9341_YELLOW);
+  for (uint8_t i = 0; i < i2cBus.getDeviceCount(); i++)
+  {
+    const I2CDeviceStats &stats = i2cBus.getStatsAt(i);
+    uint32_t average = stats.transactions ? stats.totalLatencyUs / stats.transactions : 0;
+    tft.setCursor(4, 42 + 10 * i);
+    tft.printf("%02X %-4s t%lu n%lu s%lu to%lu r%lu %luus/%luus",
+               stats.address, stats.name ? stats.name : "?", (unsigned long)stats.transactions,
+               (unsigned long)stats.nacks, (unsigned long)stats.shortReads, (unsigned long)stats.timeouts,
+               (unsigned long)stats.busResets, (unsigned long)average, (unsigned long)stats.maxLatencyUs);
+  }
+  tft.setFont(neuropolitical_10);
+}
+
+void Display::drawBootTimeline(const BootTimeline &timeline)
+{
+  // Two columns of phases over the spectrum, like drawI2CStats()
+  static const uint8_t rows = 10;
+  tft.setFontAdafruit();
+  tft.setTextSize(1);
+  uint8_t lines = timeline.size() < rows ? timeline.size() : rows;
+  tft.fillRect(0, 40, 320, 10 * lines + 4, ILI9341_BLACK);
+  tft.setTextColor(ILI9341_CYAN);
+  for (uint8_t i = 0; i < timeline.size(); i++)
+  {
+    tft.setCursor(4 + (i / rows) * 160, 42 + 10 * (i % rows));
+    tft.printf("%-14s %5lu", timeline.nameAt(i), timeline.timeAt(i));
+  }
+  tft.setFont(neuropolitical_10);
+}
+
+void Display::drawPerfHud(const char *line)
+{
+  // Fixed cost: one rect and a single line of the small built-in font
+  tft.setFontAdafruit();
+  tft.setTextSize(1);
+  tft.fillRect(0, 4, 320, 10, ILI9341_BLACK);
+  tft.setTextColor(ILI9341_GREEN);
+  tft.setCursor(2, 5);
+  tft.print(line);
+  tft.setFont(neuropolitical_10);
+}
+
 void Display::clampAndPrint(const char *text, int maxWidth)
 {
   int pixelLen = tft.strPixelLen(text);
@@ -483,6 +538,51 @@ void Display::drawBtIcon(bool connected)
   }
 }
 
+void Display::drawSignalBar(uint8_t bars, uint8_t maxBars, bool stereo)
+{
+  static int left = 84;
+  static int top = 19;
+  static int height = 16;
+  tft.fillRect(left, top, 4 * maxBars + 16, height, ILI9341_BLACK);
+  for (uint8_t i = 0; i < maxBars; i++)
+  {
+    int barHeight = 4 + i * (height - 4) / (maxBars - 1);
+    int barTop = top + height - barHeight;
+    if (i < bars)
+    {
+      tft.fillRect(left + 4 * i, barTop, 3, barHeight, theme.modeTitle);
+    }
+    else
+    {
+      tft.drawRect(left + 4 * i, barTop, 3, barHeight, theme.clockColor);
+    }
+  }
+  if (stereo)
+  {
+    tft.setFontAdafruit();
+    tft.setTextSize(1);
+    tft.setTextColor(theme.modeTitle);
+    tft.setCursor(left + 4 * maxBars + 2, top + height - 8);
+    tft.print("ST");
+    tft.setFont(neuropolitical_10);
+  }
+}
+
+void Display::drawProgressBar(uint32_t position, uint32_t duration)
+{
+  static int left = 20;
+  static int top = 230;
+  static int width = 280;
+  tft.fillRect(left, top, width, 3, ILI9341_BLACK);
+  if (duration == 0)
+  {
+    return;
+  }
+  int done = (uint64_t)min(position, duration) * width / duration;
+  tft.drawFastHLine(left + done, top + 1, width - done, theme.metadataLine2);
+  tft.fillRect(left, top, done, 3, theme.metadataLine1);
+}
+
 void Display::drawRecIcon(bool recording)
 {
   static int left = 122;
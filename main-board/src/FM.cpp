@@ -1,19 +1,20 @@
 #include "FM.h"
 #include "Log.h"
-#include "../lib/RDA5807/src/RDA5807.h" // Using Wire1 (renamed all Wire calls in RDA5807.cpp to Wire1)
+#include "../lib/RDA5807/src/RDA5807.h" // Using Wire1 through i2cBus (renamed all Wire calls in RDA5807.cpp to i2cBus)
 #include <TimeLib.h>
 
 void FM::init()
 {
-  static elapsedMillis initTimer = 0;
-  static uint8_t initStep = 0;
-  static bool initStarted = false;
-
   if (!initStarted)
   {
     LOG_FM_MSG("Starting FM radio initialization");
     initStarted = true;
+    initStart = millis();
     initTimer = 0;
+    if (quickBoot && warmStart())
+    {
+      return;
+    }
   } else {
     LOG_FM_MSG("FM radio initialization already started");
   }
@@ -54,91 +55,151 @@ void FM::init()
   {
     LOG_FM_MSG("Setting initial frequency");
     i2cTimer->startManualOperation();
-    if (SNVS_LPGPR0 > 8760 && SNVS_LPGPR0 < 10800)
+    if (hasValidFrequency())
     {
       LOG_FM_MSGF("Setting initial frequency to %u", SNVS_LPGPR0);
-      rx.setFrequency(SNVS_LPGPR0);
-      rx.waitAndFinishTune();
-      i2cTimer->releaseBus();
+      startTune(SNVS_LPGPR0);
     }
     rx.setFmDeemphasis(1);
     i2cTimer->releaseBus();
-    LOG_FM_MSG("FM radio initialization complete");
-    initComplete = true;
+    finishInit();
     initStep++;
   }
 }
 
+bool FM::warmStart()
+{
+  if (!hasValidFrequency())
+  {
+    return false;
+  }
+
+  // Only trust the chip if it reads back exactly as the init sequence leaves it
+  i2cTimer->startManualOperation();
+  uint16_t chipId = rx.getDeviceId();
+  rx.loadRegisters();
+  bool configured = (chipId >> 8) == CHIP_ID &&
+                    rx.isPoweredUp() &&
+                    rx.isRdsFifoEnabled() &&
+                    rx.getBand() == RDA_FM_BAND_USA_EU &&
+                    rx.getSpace() == 0 &&
+                    rx.getVolume() == VOLUME &&
+                    rx.getSeekThreshold() == (SEEK_THRESHOLD & 0x0F) && // SEEKTH is 4 bits wide
+                    rx.getFmDeemphasis() == 1;
+  if (configured)
+  {
+    LOG_FM_MSGF("Warm start, restoring %u", SNVS_LPGPR0);
+    rx.restoreTune(SNVS_LPGPR0);
+    tuneFrequency = SNVS_LPGPR0;
+    tuneState = TUNE_WAIT;
+    tuneTimer = 0;
+  }
+  i2cTimer->releaseBus();
+
+  if (!configured)
+  {
+    LOG_FM_MSGF("Radio not configured (ID %04X), cold start", chipId);
+    return false;
+  }
+  warmStarted = true;
+  finishInit();
+  return true;
+}
+
+void FM::finishInit()
+{
+  if (stations.load())
+  {
+    // Treat a saved list like a fresh scan
+    hasScanned = stations.size() > 0;
+    sinceScan = 0;
+  }
+  LOG_FM_MSGF("FM radio initialization complete (%s start, %lu ms)",
+              warmStarted ? "warm" : "cold", millis() - initStart);
+  initComplete = true;
+}
+
 void FM::checkRDS()
 {
-  LOG_FM_MSGF("Checking RDS %d", millis());
+  decodeRdsGroup();
+  onRdsChanged();
 
-  updateRealFrequency();
+  RDSClockTime clockTime;
+  if (rds.takeClockTime(clockTime))
+  {
+    clockSync.feed(clockTime);
+  }
+}
 
-  if (!rx.hasRdsInfo())
+void FM::decodeRdsGroup()
+{
+  // Only decode RDS groups, not RBDS E blocks
+  if (rx.getBlockId() != 0)
   {
-    LOG_FM_MSG("No RDS info available");
     return;
   }
 
-  LOG_FM_MSG("RDS info available");
-  char *tempRdsMsg = rx.getRdsText2A();
-  char *tempStationName = rx.getRdsText0A();
+  // The blocks were read along with the status registers by getRdsReady()
+  uint16_t blocks[4];
+  rx.getRdsBlocks(blocks);
 
-  if (tempRdsMsg != nullptr)
+  // A level of 3 means the block could not be corrected, the chip doesn't report C and D
+  uint8_t errors = 0;
+  uint8_t errorBlocks = 0;
+  if (rx.getErrorBlockA() == 3)
   {
-    // Validate RDS message contains only printable characters
-    bool valid = true;
-    for (int i = 0; tempRdsMsg[i] != '\0' && i < 64; i++) {
-      if (!isprint(tempRdsMsg[i]) && !isspace(tempRdsMsg[i])) {
-        valid = false;
-        break;
-      }
-    }
+    errors |= RDS_ERROR_A;
+    errorBlocks++;
+  }
+  if (rx.getErrorBlockB() == 3)
+  {
+    errors |= RDS_ERROR_B;
+    errorBlocks++;
+  }
+  rds.decode(blocks[0], blocks[1], blocks[2], blocks[3], errors);
+  (scanState != SCAN_OFF ? scanSignal : signal).addRdsGroup(errorBlocks);
+}
 
-    if (valid) {
-      LOG_FM_MSGF("RDS message: %s", tempRdsMsg);
-      tempRdsMsg[22] = '\0';
-      newRDSMsg = strcmp(bufferRdsMsg, tempRdsMsg) != 0;
-      if (newRDSMsg) {
-        strncpy(bufferRdsMsg, tempRdsMsg, sizeof(bufferRdsMsg) - 1);
-        bufferRdsMsg[sizeof(bufferRdsMsg) - 1] = '\0';
-        rdsMsg = bufferRdsMsg;
-      }
-    }
+void FM::sampleSignal()
+{
+  // Status registers were just read by getRdsReady()
+  signal.addSample(rx.getReadRssi(), rx.isReadStereo());
+  if (signal.getSampleCount() >= SignalQuality::MIN_SAMPLES)
+  {
+    applyBlendMode(signal.getBlendMode());
   }
+}
 
-  if (tempStationName != nullptr && (millis() - stationNameElapsed) > 1000)
+void FM::applyBlendMode(SignalQuality::BlendMode mode)
+{
+  if (mode == appliedBlend)
   {
-    // Validate station name contains only printable characters
-    bool valid = true;
-    for (int i = 0; tempStationName[i] != '\0' && i < 16; i++) {
-      if (!isprint(tempStationName[i]) && !isspace(tempStationName[i])) {
-        valid = false;
-        break;
-      }
-    }
+    return;
+  }
+  LOG_FM_MSGF("Blend mode %d (rssi %u)", mode, signal.getRssi());
+  rx.setMono(mode == SignalQuality::BLEND_MONO);
+  rx.setSoftBlendEnable(mode == SignalQuality::BLEND_SOFT);
+  appliedBlend = mode;
+}
 
-    if (valid) {
-      LOG_FM_MSGF("Station name: %s", tempStationName);
-      newStationName = strncmp(bufferStatioName, tempStationName, 3) != 0;
-      if (newStationName) {
-        strncpy(bufferStatioName, tempStationName, sizeof(bufferStatioName) - 1);
-        bufferStatioName[sizeof(bufferStatioName) - 1] = '\0';
-        stationName = bufferStatioName;
-      }
-    }
-    else
-    {
-      LOG_FM_MSG("No station name available");
-    }
-    stationNameElapsed = millis();
+void FM::onRdsChanged()
+{
+  if (rds.takeProgramServiceChanged())
+  {
+    LOG_FM_MSGF("Station name: %s", rds.getProgramService());
+    strncpy(bufferStationName, rds.getProgramService(), sizeof(bufferStationName) - 1);
+    bufferStationName[sizeof(bufferStationName) - 1] = '\0';
+    stationName = bufferStationName;
+    newStationName = true;
   }
 
-  if ((millis() - clear_fifo) > 10000)
+  if (rds.takeRadioTextChanged())
   {
-    rx.clearRdsFifo();
-    clear_fifo = millis();
+    LOG_FM_MSGF("RDS message: %s", rds.getRadioText());
+    strncpy(bufferRdsMsg, rds.getRadioText(), sizeof(bufferRdsMsg) - 1);
+    bufferRdsMsg[sizeof(bufferRdsMsg) - 1] = '\0';
+    rdsMsg = bufferRdsMsg;
+    newRDSMsg = true;
   }
 }
 
@@ -158,17 +219,246 @@ void FM::on()
 
 void FM::seek(bool up)
 {
+  suspendScan();
   i2cTimer->startManualOperation();
-  rx.seek(RDA_SEEK_WRAP, up ? RDA_SEEK_UP : RDA_SEEK_DOWN, FM::nullFunc);
-  currentFreq = SNVS_LPGPR0 = rx.getFrequency();
+  const FMStation *station = stations.next(SNVS_LPGPR0, up);
+  if (station != nullptr)
+  {
+    LOG_FM_MSGF("Jumping to %u", station->frequency);
+    startTune(station->frequency);
+  }
+  else
+  {
+    // Nothing scanned yet
+    rx.startSeek(RDA_SEEK_WRAP, up ? RDA_SEEK_UP : RDA_SEEK_DOWN);
+    tuneFrequency = SNVS_LPGPR0;
+    tuneState = TUNE_SEEK;
+    tuneTimer = 0;
+  }
   i2cTimer->releaseBus();
 }
 
-void FM::waitSeekComplete(void)
+void FM::startTune(uint16_t frequency)
+{
+  rx.startTune(frequency);
+  tuneFrequency = frequency;
+  tuneState = TUNE_WAIT;
+  tuneTimer = 0;
+}
+
+void FM::tuneUpdate()
+{
+  bool complete = rx.isTuneComplete();
+  if (tuneState == TUNE_SEEK)
+  {
+    tuneFrequency = rx.getReadFrequency();
+  }
+
+  if (!complete)
+  {
+    if (tuneTimer >= TUNE_TIMEOUT)
+    {
+      LOG_FM_MSGF("Tune timeout at %u", tuneFrequency);
+      if (tuneState == TUNE_SEEK)
+      {
+        rx.finishSeek();
+      }
+      tuneState = TUNE_IDLE;
+    }
+    return;
+  }
+
+  if (tuneState == TUNE_SEEK)
+  {
+    // Tune the channel found so register 0x03 follows, like RDA5807::seek() does
+    startTune(rx.finishSeek());
+    return;
+  }
+  onTuneComplete();
+}
+
+void FM::onTuneComplete()
+{
+  tuneState = TUNE_IDLE;
+  rx.clearRdsFifo();
+  rds.reset();
+  clockSync.reset();
+  signal.reset();
+  if (scanState != SCAN_OFF)
+  {
+    // A scanned channel, not the station being listened to
+    scanTimer = 0;
+    return;
+  }
+  LOG_FM_MSGF("Tuned to %u", tuneFrequency);
+  if (timeToAudio == 0)
+  {
+    timeToAudio = millis();
+    LOG_FM_MSGF("First audio after %lu ms (%s start, %lu ms since init)",
+                timeToAudio, warmStarted ? "warm" : "cold", timeToAudio - initStart);
+  }
+  currentFreq = SNVS_LPGPR0 = tuneFrequency;
+  candidateFrequency = tuneFrequency;
+}
+
+void FM::startScan()
+{
+  // A tune in progress is the station to listen to, not a scanned channel
+  if (!initComplete || scanState != SCAN_OFF || tuneState != TUNE_IDLE)
+  {
+    return;
+  }
+  if (scanSuspended)
+  {
+    LOG_FM_MSGF("Band scan resumed at %u", scanFrequency);
+    scanSuspended = false;
+    scanState = SCAN_TUNE;
+    return;
+  }
+  if (hasScanned && sinceScan < SCAN_REFRESH)
+  {
+    return;
+  }
+  LOG_FM_MSG("Starting band scan");
+  scanFrequency = SCAN_START;
+  scanState = SCAN_TUNE;
+}
+
+void FM::suspendScan()
+{
+  if (scanState == SCAN_OFF)
+  {
+    return;
+  }
+  // The channel being scanned is done again on resume
+  LOG_FM_MSGF("Band scan suspended at %u", scanFrequency);
+  scanState = SCAN_OFF;
+  scanSuspended = true;
+}
+
+void FM::stopScan()
+{
+  scanSuspended = false;
+  if (scanState == SCAN_OFF)
+  {
+    return;
+  }
+  LOG_FM_MSGF("Band scan stopped at %u", scanFrequency);
+  scanState = SCAN_OFF;
+  if (hasValidFrequency())
+  {
+    i2cTimer->startManualOperation();
+    startTune(SNVS_LPGPR0);
+    i2cTimer->releaseBus();
+  }
+  resetRDSData();
+}
+
+void FM::scanUpdate()
 {
+  switch (scanState)
+  {
+  case SCAN_TUNE:
+    // Let the pilot show on every channel, the scan runs muted anyway
+    applyBlendMode(SignalQuality::BLEND_STEREO);
+    // update() waits for the end of the tune, which restarts scanTimer
+    startTune(scanFrequency);
+    scanState = SCAN_SETTLE;
+    break;
+
+  case SCAN_SETTLE:
+    if (scanTimer < SCAN_SETTLE_TIME)
+    {
+      break;
+    }
+    scanStation = {};
+    scanStation.frequency = scanFrequency;
+    scanStation.rssi = rx.getRssi();
+    scanStation.stereo = rx.isStereo();
+    if (!rx.isFmTrue() || scanStation.rssi < SCAN_MIN_RSSI)
+    {
+      stations.remove(scanFrequency);
+      scanNext();
+      break;
+    }
+    scanSignal.reset();
+    scanSignal.addSample(scanStation.rssi, scanStation.stereo);
+    scanTimer = 0;
+    scanState = SCAN_RDS;
+    break;
+
+  case SCAN_RDS:
+    if (rx.getRdsReady())
+    {
+      decodeRdsGroup();
+    }
+    if (rds.getProgramService()[0] != '\0' || scanTimer >= SCAN_RDS_TIME)
+    {
+      // Second sample carries the RDS error counts
+      scanSignal.addSample(rx.getReadRssi(), rx.isReadStereo());
+      scanStation.pi = rds.getPI();
+      scanStation.quality = scanSignal.getScore();
+      strlcpy(scanStation.ps, rds.getProgramService(), sizeof(scanStation.ps));
+      LOG_FM_MSGF("Found %u rssi %u stereo %d PI %04X quality %u %s", scanStation.frequency, scanStation.rssi,
+                  scanStation.stereo, scanStation.pi, scanStation.quality, scanStation.ps);
+      stations.update(scanStation);
+      scanNext();
+    }
+    break;
+
+  default:
+    break;
+  }
+}
+
+void FM::scanNext()
+{
+  scanFrequency += SCAN_STEP;
+  if (scanFrequency <= SCAN_END)
+  {
+    scanState = SCAN_TUNE;
+    return;
+  }
+
+  LOG_FM_MSGF("Band scan complete, %d stations", stations.size());
+  stationsDirty = true;
+  hasScanned = true;
+  sinceScan = 0;
+  // Back to the station that was playing
+  scanState = SCAN_OFF;
+  if (hasValidFrequency())
+  {
+    startTune(SNVS_LPGPR0);
+  }
+  else
+  {
+    tuneStrongestStation();
+  }
+}
+
+bool FM::tuneStrongestStation()
+{
+  const FMStation *strongest = nullptr;
+  for (uint8_t i = 0; i < stations.size(); i++)
+  {
+    const FMStation &station = stations.at(i);
+    // Only stations with RDS can give the time
+    if (station.pi != 0 && (strongest == nullptr || station.quality > strongest->quality ||
+                            (station.quality == strongest->quality && station.rssi > strongest->rssi)))
+    {
+      strongest = &station;
+    }
+  }
+  if (strongest == nullptr)
+  {
+    return false;
+  }
+  LOG_FM_MSGF("Tuning strongest station %u", strongest->frequency);
+  scanState = SCAN_OFF;
   i2cTimer->startManualOperation();
-  rx.waitAndFinishTune();
+  startTune(strongest->frequency);
   i2cTimer->releaseBus();
+  return true;
 }
 
 void FM::resetRDSData()
@@ -176,6 +466,9 @@ void FM::resetRDSData()
   i2cTimer->startManualOperation();
   rx.clearRdsFifo();
   i2cTimer->releaseBus();
+  rds.reset();
+  rds.takeProgramServiceChanged();
+  rds.takeRadioTextChanged();
   newStationName = true;
   newRDSMsg = true;
   stationName = (char *)"";
@@ -187,7 +480,7 @@ void FM::updateRealFrequency(void)
   uint16_t testFreq = rx.getRealFrequency();
   unsigned long currentTime = millis();
 
-  if (testFreq < 8760 || testFreq > 10800)
+  if (testFreq < SCAN_START || testFreq > SCAN_END)
   {
     LOGF("Invalid frequency %d detected, keeping previous frequency %d\n", testFreq, SNVS_LPGPR0);
     // Optionally attempt recovery
@@ -216,9 +509,10 @@ void FM::updateRealFrequency(void)
 
 void FM::setFrequency(int newFreq)
 { 
+  suspendScan();
   i2cTimer->startManualOperation();
   currentFreq = newFreq;
-  rx.setFrequency(newFreq);
+  startTune(newFreq);
   i2cTimer->releaseBus();
 }
 
@@ -246,14 +540,56 @@ char *FM::getFrequencyString()
   return freq;
 }
 
+void FM::saveStations()
+{
+  if (stationsDirty)
+  {
+    stationsDirty = false;
+    stations.save();
+  }
+}
+
 void FM::update()
 {
+  if (tuneState != TUNE_IDLE)
+  {
+    // No RDS until the tune is complete
+    if (i2cTimer->shouldPollTune())
+    {
+      tuneUpdate();
+      i2cTimer->markTunePolled();
+      i2cTimer->releaseBus();
+    }
+    return;
+  }
+
   if (!i2cTimer->shouldPollRDS())
   {
     return;
   }
-  rx.getRdsReady();
-  checkRDS();
+  if (scanState != SCAN_OFF)
+  {
+    scanUpdate();
+    i2cTimer->markRDSPolled();
+    i2cTimer->releaseBus();
+    return;
+  }
+
+  // One read gets the status registers and the whole RDS group
+  if (rx.getRdsReady())
+  {
+    checkRDS();
+  }
+  if (signalTimer >= SIGNAL_SAMPLE_INTERVAL)
+  {
+    signalTimer = 0;
+    sampleSignal();
+  }
+  if (frequencyCheckTimer >= FREQUENCY_CHECK_INTERVAL)
+  {
+    frequencyCheckTimer = 0;
+    updateRealFrequency();
+  }
 
   i2cTimer->markRDSPolled();
   i2cTimer->releaseBus();
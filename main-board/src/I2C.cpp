@@ -1,14 +1,23 @@
 #include "I2C.h"
 #include "Log.h"
+#include "I2CSimDevices.h"
 #include <Wire.h>
+#include <I2CBus.h>
 
 void I2C::init()
 {
-  Wire1.setSCL(SCL_PIN);
-  Wire1.setSDA(SDA_PIN);
-  Wire1.begin();
-  Wire1.setClock(100000);
-  delay(300); // Give devices time to initialize
+  i2cBus.setSCL(SCL_PIN);
+  i2cBus.setSDA(SDA_PIN);
+  i2cBus.begin();
+  i2cBus.registerDevice(IO_BOARD_I2C_ADDRESS, "io");
+  i2cBus.registerDevice(BT_MODULE_I2C_ADDRESS, "bt");
+  i2cBus.registerDevice(FM_FULL_ACCESS_I2C_ADDRESS, "fm");
+  i2cBus.registerDevice(FM_DIRECT_ACCESS_I2C_ADDRESS, "fm-d");
+#ifdef I2C_SIMULATED_BUS
+  attachSimulatedDevices();
+#endif
+  speed_.begin();
+  initTime_ = millis(); // isReady() once the devices had time to initialize
 
   LOG_I2C_MSG("LOG_I2C Debug: scanning I2C bus...");
 #if LOG_I2C
@@ -34,13 +43,13 @@ bool paused = false;
 bool wasPlaying = false;
 void I2C::loop()
 {
-  static uint8_t btFailCount = 0;
-  static uint8_t ioFailCount = 0;
-  static elapsedMillis lastWireReset = 0;
   static elapsedMillis lastSuccessfulComm = 0;
-  const unsigned long WIRE_RESET_COOLDOWN = 1000;
 
   i2cTimer.update();
+  if (i2cTimer.getCurrentOperation() == I2CTimer::NONE)
+  {
+    speed_.update();
+  }
 
   // Check for audio state change and maintain I2C when stopped
   bool isPlaying = (currentMode_ == MODE_BLUETOOTH && metadata_.isPlaying);
@@ -48,29 +57,20 @@ void I2C::loop()
   {
     // Audio just stopped - force a full I2C reset sequence
     LOG_I2C_MSG("Audio stopped - resetting I2C");
-    Wire1.end(); // Completely shut down I2C
+    i2cBus.end(); // Completely shut down I2C
     yield();
-    Wire1.begin(); // Restart I2C fresh
-    lastWireReset = 0;
-    btFailCount = 0;
-    ioFailCount = 0;
+    i2cBus.resetBus(); // Restart I2C fresh
   }
   wasPlaying = isPlaying;
 
   if (i2cTimer.hasTimeout())
   {
     LOG_I2C_MSG("I2C timeout");
-    if (lastWireReset >= WIRE_RESET_COOLDOWN)
-    {
-      LOG_I2C_MSGF("Time since last successful comm: %d ms\n", (int)lastSuccessfulComm);
-      LOG_I2C_MSG("Resetting I2C bus");
-      i2cTimer.startManualOperation();
-      Wire1.begin();
-      lastWireReset = 0;
-      btFailCount = 0;
-      ioFailCount = 0;
-      i2cTimer.releaseBus();
-    }
+    LOG_I2C_MSGF("Time since last successful comm: %d ms\n", (int)lastSuccessfulComm);
+    i2cBus.recordTimeout();
+    i2cTimer.startManualOperation();
+    watchdog_.reportTimeout();
+    i2cTimer.releaseBus();
     i2cTimer.resetTimeout();
     return;
   }
@@ -84,30 +84,19 @@ void I2C::loop()
       i2cTimer.resetTimeout();
       i2cTimer.markIOPolled();
       i2cTimer.releaseBus();
-      ioFailCount = 0;
+      watchdog_.reportSuccess();
       lastSuccessfulComm = 0; // Reset timer on success
       // Process control changes
       if (!ioState_.controlProcessed && controlCallback_)
       {
-        controlCallback_(ioState_.control);
+        queueEvent_(EVENT_CONTROL, ioState_.control);
         ioState_.controlProcessed = true;
       }
     }
     else
     {
-      ioFailCount++;
-      LOG_I2C_MSGF("IO poll failed (%d times, %d ms since last success)\n",
-                   ioFailCount, (int)lastSuccessfulComm);
-      if (ioFailCount >= 3 && lastWireReset >= WIRE_RESET_COOLDOWN)
-      {
-        LOG_I2C_MSG("Multiple IO failures, resetting bus");
-        i2cTimer.startManualOperation();
-        Wire1.begin();
-        lastWireReset = 0;
-        ioFailCount = 0;
-        btFailCount = 0;
-        i2cTimer.releaseBus();
-      }
+      LOG_I2C_MSGF("IO poll failed (%d ms since last success)\n", (int)lastSuccessfulComm);
+      watchdog_.reportFailure(IO_BOARD_I2C_ADDRESS);
       yield();
     }
   }
@@ -123,22 +112,22 @@ void I2C::loop()
     {
       LOG_BT_MSGF("Attempting to send command: %c (retry: %d)\n", pendingBTCommand_, cmdRetryCount);
       i2cTimer.startManualOperation();
-      Wire1.beginTransmission(BT_MODULE_I2C_ADDRESS);
-      Wire1.write(pendingBTCommand_);
-      byte error = Wire1.endTransmission();
-      i2cTimer.releaseBus();
+      i2cBus.beginTransmission(BT_MODULE_I2C_ADDRESS);
+      i2cBus.write(pendingBTCommand_);
+      byte error = i2cBus.endTransmission();
 
       if (error == 0)
       {
         LOG_BT_MSG("Command sent successfully");
         pendingBTCommand_ = 0;
         cmdRetryCount = 0;
-        btFailCount = 0;
+        watchdog_.reportSuccess();
       }
       else
       {
         cmdRetryCount++;
         LOG_BT_MSGF("Command failed (error: %d)\n", error);
+        watchdog_.reportFailure(BT_MODULE_I2C_ADDRESS);
 
         if (cmdRetryCount >= 3)
         {
@@ -147,6 +136,7 @@ void I2C::loop()
           cmdRetryCount = 0;
         }
       }
+      i2cTimer.releaseBus();
       lastRetryTime = 0;
     }
   }
@@ -160,49 +150,122 @@ void I2C::loop()
       return;
     }
     LOG_BT_MSG("Polling Bluetooth");
-    String data = requestDataFromBluetooth();
-    if (data.length() > 0)
+    if (requestDataFromBluetooth())
     {
       i2cTimer.resetTimeout();
       i2cTimer.markBTPolled();
-      btFailCount = 0;
+      watchdog_.reportSuccess();
       lastSuccessfulComm = 0; // Reset timer on success
       i2cTimer.releaseBus();
     }
     else
     {
-      btFailCount++;
-      LOG_BT_MSGF("BT poll failed (%d times, %d ms since last success)\n",
-                  btFailCount, (int)lastSuccessfulComm);
-      if (btFailCount >= 3 && lastWireReset >= WIRE_RESET_COOLDOWN)
-      {
-        LOG_BT_MSG("Multiple BT failures, resetting bus");
-        i2cTimer.startManualOperation();
-        Wire1.begin();
-        lastWireReset = 0;
-        btFailCount = 0;
-        ioFailCount = 0;
-        i2cTimer.releaseBus();
-      }
+      LOG_BT_MSGF("BT poll failed (%d ms since last success)\n", (int)lastSuccessfulComm);
+      watchdog_.reportFailure(BT_MODULE_I2C_ADDRESS);
+      // The sink may have restarted with new revisions, read all fields again
+      for (int16_t &revision : btFieldRevisions_)
+        revision = -1;
+      // Retry on the next interval, an immediate retry would only hit the
+      // requestDataFromBluetooth() rate limit and count as another failure
+      i2cTimer.markBTPolled();
+      i2cTimer.releaseBus();
     }
   }
 }
 
-static void processAnalogValue(byte newValue, byte &currentValue, bool warmingUp = false)
+void I2C::queueEvent_(I2CEventType type, uint8_t value, const char *uid)
 {
+  I2CEvent event;
+  event.type = type;
+  event.value = value;
+  event.uid[0] = '\0';
+  if (uid)
+  {
+    strncpy(event.uid, uid, NFC_UID_STRING_LENGTH - 1);
+    event.uid[NFC_UID_STRING_LENGTH - 1] = '\0';
+  }
+  event.enqueuedAt = micros();
 
-  // Allow first reading to pass through
-  if (warmingUp) {
-      currentValue = newValue;
-      LOG_I2C_MSGF("Initial value set: %d\n", newValue);
-      return;
+  uint8_t previousHighWater = eventQueue_.highWaterMark();
+  if (!eventQueue_.push(event))
+  {
+    LOG_I2C_MSGF("Event queue full, dropped event %d (%lu dropped)\n", type, eventQueue_.dropped());
+  }
+  else if (eventQueue_.highWaterMark() > previousHighWater)
+  {
+    LOG_I2C_MSGF("Event queue depth high-water mark: %d\n", eventQueue_.highWaterMark());
   }
+}
 
-  // Smooth out the value with a recursive filter
-  currentValue = (float)currentValue * 0.7 + (float)newValue * 0.3;
-  // Make zero values more stable
-  if (newValue < 2) {
-    currentValue = 0;
+void I2C::dispatchEvents()
+{
+  I2CEvent event;
+  while (eventQueue_.pop(event))
+  {
+    uint32_t dispatchStart = micros();
+    switch (event.type)
+    {
+    case EVENT_ORANGE_BUTTON:
+      if (orangeButtonCallback_)
+        orangeButtonCallback_(event.value);
+      break;
+    case EVENT_BAND_BUTTON:
+      if (bandButtonCallback_)
+        bandButtonCallback_(event.value);
+      break;
+    case EVENT_INPUT_BUTTON:
+      if (inputButtonCallback_)
+        inputButtonCallback_(event.value);
+      break;
+    case EVENT_CONTROL:
+      if (controlCallback_)
+        controlCallback_(static_cast<ControlCommand>(event.value));
+      break;
+    case EVENT_NFC_TAG:
+      if (nfcTagCallback_)
+        nfcTagCallback_(String(event.uid));
+      break;
+    default:
+      break;
+    }
+
+    uint32_t latency = dispatchStart - event.enqueuedAt;
+    uint32_t handlerTime = micros() - dispatchStart;
+    I2CEventStats &stats = eventStats_[event.type];
+    stats.count++;
+    stats.totalLatencyUs += latency;
+    stats.maxLatencyUs = max(stats.maxLatencyUs, latency);
+    stats.maxHandlerUs = max(stats.maxHandlerUs, handlerTime);
+    LOG_I2C_MSGF("Dispatched event %d: queued %lu us, handler %lu us\n", event.type, latency, handlerTime);
+  }
+}
+
+void I2C::printStats(Print &out) const
+{
+  static const char *eventNames[EVENT_TYPE_COUNT] = {"orange", "band", "input", "control", "nfc"};
+
+  i2cBus.printStats(out);
+  speed_.printStatus(out);
+  watchdog_.printStatus(out);
+  out.printf("Event queue: depth %d, high-water %d, dropped %lu\n",
+             eventQueue_.size(), eventQueue_.highWaterMark(), (unsigned long)eventQueue_.dropped());
+  for (int i = 0; i < EVENT_TYPE_COUNT; i++)
+  {
+    const I2CEventStats &stats = eventStats_[i];
+    uint32_t average = stats.count ? stats.totalLatencyUs / stats.count : 0;
+    out.printf("  %-7s %5lu events, latency avg %lu us max %lu us, handler max %lu us\n",
+               eventNames[i], (unsigned long)stats.count, (unsigned long)average,
+               (unsigned long)stats.maxLatencyUs, (unsigned long)stats.maxHandlerUs);
+  }
+}
+
+void I2C::resetStats()
+{
+  i2cBus.resetStats();
+  eventQueue_.resetStats();
+  for (int i = 0; i < EVENT_TYPE_COUNT; i++)
+  {
+    eventStats_[i] = I2CEventStats();
   }
 }
 
@@ -210,23 +273,27 @@ bool I2C::requestDataFromIO(bool isRetry)
 {
   static const int IO_DATA_LENGTH = 13;
 
-  Wire1.requestFrom(static_cast<int>(IO_BOARD_I2C_ADDRESS), IO_DATA_LENGTH);
+  i2cBus.requestFrom(static_cast<int>(IO_BOARD_I2C_ADDRESS), IO_DATA_LENGTH);
 
-  if (Wire1.available() >= IO_DATA_LENGTH)
+  if (i2cBus.available() >= IO_DATA_LENGTH)
   {
-    byte newButtons = Wire1.read();
-    byte rawVolume = Wire1.read();
-    byte rawTone = Wire1.read();
-    byte rawTuning = Wire1.read();
-    byte rawBrightness = Wire1.read();
-    byte newFmValue = Wire1.read();
-    ControlCommand newControl = static_cast<ControlCommand>(Wire1.read());
+    byte rawButtons = i2cBus.read();
+    byte newButtons = rawButtons & BUTTONS_MASK;
+    byte rawVolume = i2cBus.read();
+    byte rawTone = i2cBus.read();
+    byte rawTuning = i2cBus.read();
+    byte rawBrightness = i2cBus.read();
+    byte newFmValue = i2cBus.read();
+    ControlCommand newControl = static_cast<ControlCommand>(i2cBus.read());
+    IOTraceFrame frame = {millis(), rawButtons, rawVolume, rawTone, rawTuning, rawBrightness, newFmValue,
+                          static_cast<uint8_t>(newControl)};
     
     // Read NFC UID (7 bytes)
     String newNfcUidString = "";
     // LOG_I2C_MSG("I2C receiving NFC UID");
     for (int i = 0; i < 7; i++) {
-        uint8_t b = Wire1.read();
+        uint8_t b = i2cBus.read();
+        frame.nfcUid[i] = b;
         // Add leading zero if needed
         if (b < 0x10) {
             newNfcUidString += "0";
@@ -234,6 +301,7 @@ bool I2C::requestDataFromIO(bool isRetry)
         newNfcUidString += String(b, HEX);
     }
     newNfcUidString.toUpperCase();  // Convert to uppercase for consistency
+    ioTrace_.record(frame);
 
     if (newNfcUidString != ioState_.nfcUidString) {
         if (newNfcUidString == "000000000000FF" || newNfcUidString == "00000000000000" || newNfcUidString == "F1000000000000") {  // No tag detected / spurious codes
@@ -246,7 +314,7 @@ bool I2C::requestDataFromIO(bool isRetry)
                 LOG_I2C_MSGF("NFC UID changed (no tag): %s\n", newNfcUidString.c_str());
                 ioState_.nfcUidString = newNfcUidString;
                 if (nfcTagCallback_ && !i2cTimer.isWarmingUp()) {
-                    nfcTagCallback_("000000000000FF");
+                    queueEvent_(EVENT_NFC_TAG, 0, "000000000000FF");
                 }
                 noTagTimerStarted = false;
             }
@@ -255,7 +323,7 @@ bool I2C::requestDataFromIO(bool isRetry)
             LOG_I2C_MSGF("NFC UID changed: %s\n", newNfcUidString.c_str());
             ioState_.nfcUidString = newNfcUidString;
             if (nfcTagCallback_) {
-                nfcTagCallback_(newNfcUidString);
+                queueEvent_(EVENT_NFC_TAG, 0, newNfcUidString.c_str());
             }
             noTagTimerStarted = false;
         }
@@ -274,7 +342,7 @@ bool I2C::requestDataFromIO(bool isRetry)
         bool oldOrangeState = ioState_.buttonStates & ORANGE_BTN;
         if (newOrangeState != oldOrangeState)
         {
-          orangeButtonCallback_(newOrangeState);
+          queueEvent_(EVENT_ORANGE_BUTTON, newOrangeState);
         }
       }
 
@@ -286,7 +354,7 @@ bool I2C::requestDataFromIO(bool isRetry)
         bool oldBandState = ioState_.buttonStates & BAND_BTN;
         if (newBandState != oldBandState)
         {
-          bandButtonCallback_(newBandState);
+          queueEvent_(EVENT_BAND_BUTTON, newBandState);
         }
       }
 
@@ -298,7 +366,7 @@ bool I2C::requestDataFromIO(bool isRetry)
         bool oldInputState = ioState_.buttonStates & INPUT_BTN;
         if (newInputState != oldInputState)
         {
-          inputButtonCallback_(newInputState);
+          queueEvent_(EVENT_INPUT_BUTTON, newInputState);
         }
       }
     }
@@ -311,12 +379,13 @@ bool I2C::requestDataFromIO(bool isRetry)
       LOG_I2C_MSGF("Control command changed: %d\n", newControl);
     }
 
-    // Process all analog values with spike filtering
-    bool isWarmingUp = i2cTimer.isWarmingUp();
-    processAnalogValue(rawVolume, ioState_.volume, isWarmingUp);
-    processAnalogValue(rawTone, ioState_.tone, isWarmingUp);
-    processAnalogValue(rawTuning, ioState_.tuning, isWarmingUp);
-    processAnalogValue(rawBrightness, ioState_.brightness, isWarmingUp);
+    // The IO board sends the pots already smoothed, with hysteresis. The
+    // change flags add up until taken, a frame can span several polls
+    ioState_.volume = rawVolume;
+    ioState_.tone = rawTone;
+    ioState_.tuning = rawTuning;
+    ioState_.brightness = rawBrightness;
+    ioState_.potsChanged |= rawButtons & POTS_CHANGED_MASK;
 
     // Process buttons and store other values...
     ioState_.buttonStates = newButtons;
@@ -328,7 +397,24 @@ bool I2C::requestDataFromIO(bool isRetry)
   return false;
 }
 
-String I2C::requestDataFromBluetooth()
+// Reads the bytes of a requestFrom(), returns how many came before the timeout
+static size_t readBTFrame(uint8_t *buffer, size_t length)
+{
+  size_t bytesRead = 0;
+  elapsedMillis readTimeout = 0;
+  const unsigned long READ_TIMEOUT = 5; // 5ms timeout
+
+  while (readTimeout < READ_TIMEOUT && bytesRead < length)
+  {
+    if (i2cBus.available())
+    {
+      buffer[bytesRead++] = i2cBus.read();
+    }
+  }
+  return bytesRead;
+}
+
+bool I2C::requestDataFromBluetooth()
 {
   static elapsedMillis lastPollTime = 0;
   const unsigned int MIN_POLL_INTERVAL = 50;
@@ -336,162 +422,145 @@ String I2C::requestDataFromBluetooth()
   if (lastPollTime < MIN_POLL_INTERVAL)
   {
     yield();
-    return "";
+    return false;
   }
   lastPollTime = 0;
 
-  // Request data
-  size_t bytesRequested = Wire1.requestFrom(static_cast<int>(BT_MODULE_I2C_ADDRESS), MAX_BT_DATA_LENGTH);
+  // Request the status
+  size_t bytesRequested = i2cBus.requestFrom(static_cast<int>(BT_MODULE_I2C_ADDRESS), BT_STATUS_LENGTH);
   LOG_BT_MSGF("Requested %d bytes\n", bytesRequested);
 
-  if (bytesRequested != MAX_BT_DATA_LENGTH)
+  if (bytesRequested != BT_STATUS_LENGTH)
   {
     LOG_BT_MSGF("Request failed, got %d bytes\n", bytesRequested);
-    return "";
+    return false;
   }
 
-  static char buffer[MAX_BT_DATA_LENGTH];
-  memset(buffer, 0, MAX_BT_DATA_LENGTH);
-
-  // Read available bytes with timeout
-  size_t bytesRead = 0;
-  elapsedMillis readTimeout = 0;
-  const unsigned long READ_TIMEOUT = 5; // 5ms timeout
+  uint8_t frame[BT_STATUS_LENGTH];
+  size_t bytesRead = readBTFrame(frame, BT_STATUS_LENGTH);
+  LOG_BT_MSGF("Read %d bytes\n", bytesRead);
 
-  while (readTimeout < READ_TIMEOUT && bytesRead < MAX_BT_DATA_LENGTH)
+  if (bytesRead != BT_STATUS_LENGTH || frame[0] != '#')
   {
-    if (Wire1.available())
+    LOG_BT_MSG("Corrupted data received:");
+    for (size_t j = 0; j < bytesRead; j++)
     {
-      buffer[bytesRead++] = Wire1.read();
+      LOG_BT_MSGF("%02X ", frame[j]);
     }
-    if (bytesRead % 32 == 0)
-      yield();
+    LOG_BT_MSG("");
+    return false;
   }
 
-  LOG_BT_MSGF("Read %d bytes\n", bytesRead);
+  parseBTStatus_(frame);
+  return true;
+}
 
-  if (bytesRead == 0)
+// Reads one text field of the sink, false if the transfer failed
+bool I2C::requestBTField_(uint8_t field, bool &changed)
+{
+  i2cBus.beginTransmission(BT_MODULE_I2C_ADDRESS);
+  i2cBus.write('f');
+  i2cBus.write(field);
+  if (i2cBus.endTransmission() != 0)
   {
-    LOG_BT_MSG("No bytes read");
-    return "";
+    LOG_BT_MSGF("Field %d select failed\n", field);
+    return false;
   }
 
-  // Ensure null termination
-  buffer[MAX_BT_DATA_LENGTH - 1] = '\0';
-
-  // Parse metadata
-  char *dataStart = strchr(buffer, '|');
-  if (dataStart)
+  uint8_t frame[BT_FIELD_LENGTH + 1];
+  if (i2cBus.requestFrom(static_cast<int>(BT_MODULE_I2C_ADDRESS), BT_FIELD_LENGTH) != BT_FIELD_LENGTH ||
+      readBTFrame(frame, BT_FIELD_LENGTH) != BT_FIELD_LENGTH || frame[0] != 'F' || frame[1] != field)
   {
-    parseMetadata_(dataStart + 1);
+    LOG_BT_MSGF("Field %d read failed\n", field);
+    return false;
   }
-  else
-  {
-    LOG_BT_MSG("Corrupted data received:");
-    for (size_t j = 0; j < min(bytesRead, (size_t)16); j++)
-    {
-      LOG_BT_MSGF("%02X ", buffer[j]);
-    }
-    LOG_BT_MSG("");
-    return "";
-  }
-
-  return buffer;
+  frame[BT_FIELD_LENGTH] = '\0';
+  String value = (const char *)&frame[3];
+  btFieldRevisions_[field] = frame[2];
+  LOG_BT_MSGF("Field %d (revision %d) = '%s'\n", field, frame[2], value.c_str());
+
+  String &target = field == BT_FIELD_TITLE    ? metadata_.title
+                   : field == BT_FIELD_ARTIST ? metadata_.artist
+                   : field == BT_FIELD_ALBUM  ? metadata_.album
+                                              : btDeviceName_;
+  changed = value != target;
+  target = value;
+  return true;
 }
 
-void I2C::parseMetadata_(const String &data)
+void I2C::parseBTStatus_(const uint8_t *frame)
 {
-  String title, artist, playingState, connectionStatus;
   bool hasChanges = false;
 
-  // Add debug logging for raw data
-  LOG_BT_MSG("Raw metadata: " + data);
-
-  size_t pos = 0;
-  while (pos < data.length())
+  // Only the text fields that changed since the last read are transferred.
+  // One that fails keeps its old revision and is read again on the next poll.
+  for (uint8_t field = 0; field < BT_FIELD_COUNT; field++)
   {
-    // Safeguard against buffer overrun
-    if (pos >= data.length())
-      break;
-
-    char type = data[pos++];
-    int delimPos = data.indexOf('|', pos);
-
-    // Handle case where this is the last field
-    String value;
-    if (delimPos != -1)
+    bool changed = false;
+    if (frame[2 + field] != btFieldRevisions_[field] && requestBTField_(field, changed))
     {
-      value = data.substring(pos, delimPos);
-    }
-    else
-    {
-      value = data.substring(pos);
-      // Trim any null characters or whitespace
-      value.trim();
+      hasChanges |= changed;
     }
+  }
 
-    // Log each field for debugging
-    LOG_BT_MSGF("Parsing field: %c = '%s'\n", type, value.c_str());
+  bool isConnected = frame[1] != 'D';
+  String deviceName = isConnected ? btDeviceName_ : String("disconnected");
+  if (deviceName != metadata_.deviceName || isConnected != metadata_.isConnected)
+  {
+    metadata_.deviceName = deviceName;
+    metadata_.isConnected = isConnected;
+    hasChanges = true;
+  }
 
-    switch (type)
-    {
-    case 'T':
-      if (value != metadata_.title)
-      {
-        metadata_.title = value;
-        hasChanges = true;
-      }
-      break;
-    case 'A':
-      if (value != metadata_.artist)
-      {
-        // Add extra logging for artist field
-        LOG_BT_MSG("Previous artist: '" + metadata_.artist + "'");
-        LOG_BT_MSG("New artist: '" + value + "'");
-        metadata_.artist = value;
-        hasChanges = true;
-      }
-      break;
-    case 'S':
-      playingState = value;
-      break;
-    case 'C':
-      if (value != metadata_.deviceName)
-      {
-        metadata_.deviceName = value;
-        metadata_.isConnected = (value != "disconnected");
-        hasChanges = true;
-      }
-      break;
-    }
+  // Both boards are little endian
+  uint32_t position, duration;
+  uint16_t trackNumber, trackCount;
+  memcpy(&position, &frame[8], 4);
+  memcpy(&duration, &frame[12], 4);
+  memcpy(&trackNumber, &frame[16], 2);
+  memcpy(&trackCount, &frame[18], 2);
+  if (duration != metadata_.duration || trackNumber != metadata_.trackNumber || trackCount != metadata_.trackCount)
+  {
+    metadata_.duration = duration;
+    metadata_.trackNumber = trackNumber;
+    metadata_.trackCount = trackCount;
+    hasChanges = true;
+  }
 
-    if (delimPos == -1)
-      break;
-    pos = delimPos + 1;
+  bool newPlayingState = (frame[1] == 'P');
+  if (frame[6] != btPositionRevision_)
+  {
+    // New position notification, interpolate from here
+    btPositionRevision_ = frame[6];
+    metadata_.position = position;
+    metadata_.positionTime = millis();
+  }
+  else if (newPlayingState != metadata_.isPlaying)
+  {
+    // Freeze or restart the interpolation where it is
+    metadata_.position = metadata_.getPosition();
+    metadata_.positionTime = millis();
   }
 
-  // Handle playing state separately since it needs special processing
-  if (playingState.length() > 0)
+  if (newPlayingState != metadata_.isPlaying)
   {
-    bool newPlayingState = (playingState == "PLAYING");
-    if (newPlayingState != metadata_.isPlaying)
-    {
-      metadata_.isPlaying = newPlayingState;
-      hasChanges = true;
-      LOG_BT_MSG("Play state changed to: " + String(newPlayingState ? "Playing" : "Not Playing"));
-    }
-    metadata_.awaitingUpdate = false; // Clear the waiting flag when we get a status update
-    LOG_BT_MSG("Cleared awaiting update flag");
+    metadata_.isPlaying = newPlayingState;
+    hasChanges = true;
+    LOG_BT_MSGF("Play state changed to: %s\n", newPlayingState ? "Playing" : "Not Playing");
   }
+  metadata_.awaitingUpdate = false; // Clear the waiting flag when we get a status update
+  LOG_BT_MSG("Cleared awaiting update flag");
 
   if (hasChanges)
   {
     metadata_.updated = true;
-    LOG_BT_MSG("Title: " + metadata_.title);
-    LOG_BT_MSG("Artist: " + metadata_.artist);
-    LOG_BT_MSG("Playing: " + String(metadata_.isPlaying ? "Yes" : "No"));
-    LOG_BT_MSG("Connected: " + String(metadata_.isConnected ? "Yes" : "No"));
-    LOG_BT_MSG("Device: " + metadata_.deviceName);
+    LOG_BT_MSGF("Title: %s\n", metadata_.title.c_str());
+    LOG_BT_MSGF("Artist: %s\n", metadata_.artist.c_str());
+    LOG_BT_MSGF("Album: %s\n", metadata_.album.c_str());
+    LOG_BT_MSGF("Track: %d / %d, %lu ms\n", metadata_.trackNumber, metadata_.trackCount, (unsigned long)metadata_.duration);
+    LOG_BT_MSGF("Playing: %s\n", metadata_.isPlaying ? "Yes" : "No");
+    LOG_BT_MSGF("Connected: %s\n", metadata_.isConnected ? "Yes" : "No");
+    LOG_BT_MSGF("Device: %s\n", metadata_.deviceName.c_str());
   }
 }
 
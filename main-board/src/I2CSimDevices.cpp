@@ -0,0 +1,510 @@
+#include "I2CSimDevices.h"
+
+#ifdef I2C_SIMULATED_BUS
+
+#include "I2C.h"
+#include "Log.h"
+#include <TimeLib.h>
+
+// ------------------ IO board --------------------- //
+
+#define SIM_NO_TAG {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}
+#define SIM_TAG {0x04, 0xA1, 0xB2, 0xC3, 0xD4, 0xE5, 0xF6}
+
+// Walks through the paths that otherwise need the real rig: pot jumps, control
+// commands, mode buttons and the NFC removal debounce
+static const IOSimFrame ioScript[] = {
+    // polls, buttons, vol, tone, tuning, bright, fm, control, uid
+    {60, INPUT_BTN, 128, 200, 100, 200, 0, NONE, SIM_NO_TAG},            // Bluetooth mode, warmup
+    {3, INPUT_BTN, 255, 200, 100, 200, 0, NONE, SIM_NO_TAG},             // Volume jump
+    {20, INPUT_BTN, 128, 200, 100, 200, 0, NONE, SIM_NO_TAG},
+    {20, INPUT_BTN, 0, 200, 100, 200, 0, NONE, SIM_NO_TAG},              // Zero volume
+    {3, INPUT_BTN, 128, 200, 100, 200, 0, NEXT, SIM_NO_TAG},             // Control command
+    {20, INPUT_BTN, 128, 200, 100, 200, 0, NONE, SIM_NO_TAG},
+    {60, INPUT_BTN | BAND_BTN, 128, 200, 100, 200, 0, NONE, SIM_NO_TAG}, // Radio mode
+    {3, INPUT_BTN | BAND_BTN, 128, 200, 100, 200, 0, PREV, SIM_NO_TAG},
+    {60, INPUT_BTN | BAND_BTN, 128, 200, 180, 200, 0, NONE, SIM_NO_TAG},
+    {50, BAND_BTN, 128, 200, 100, 200, 0, NONE, SIM_TAG},                // NFC tag inserted
+    {2, BAND_BTN, 128, 200, 100, 200, 0, NONE, SIM_NO_TAG},              // Read glitch, shorter than the debounce
+    {30, BAND_BTN, 128, 200, 100, 200, 0, NONE, SIM_TAG},
+    {60, BAND_BTN, 128, 200, 100, 200, 0, NONE, SIM_NO_TAG},             // Tag removed
+    {40, ORANGE_BTN | BAND_BTN, 128, 200, 100, 200, 0, NONE, SIM_NO_TAG},
+    {40, BAND_BTN, 128, 200, 100, 200, 0, NONE, SIM_NO_TAG},
+};
+
+uint8_t IOBoardSim::onRequest(uint8_t address, uint8_t *buffer, uint8_t quantity)
+{
+  // Like the real board this is 14 bytes, the main board only requests 13 so the
+  // last UID byte is never received (and reads back as 0xFF)
+  const IOSimFrame &frame = isLive_ ? live_ : script_[step_];
+  // The pots are already smoothed by the board, which flags the ones that
+  // changed since the previous request. Recorded frames get their flags again.
+  const uint8_t pots[4] = {frame.volume, frame.tone, frame.tuning, frame.brightness};
+  const uint8_t changedFlags[4] = {VOLUME_CHANGED, TONE_CHANGED, TUNING_CHANGED, BRIGHTNESS_CHANGED};
+  uint8_t buttons = frame.buttons & BUTTONS_MASK;
+  for (int i = 0; i < 4; i++)
+  {
+    if (pots[i] != sentPots_[i])
+    {
+      buttons |= changedFlags[i];
+      sentPots_[i] = pots[i];
+    }
+  }
+  uint8_t data[14] = {buttons, frame.volume, frame.tone, frame.tuning, frame.brightness, frame.fmValue, frame.control};
+  memcpy(&data[7], frame.nfcUid, 7);
+
+  if (!isLive_ && ++pollsInStep_ >= frame.polls)
+  {
+    pollsInStep_ = 0;
+    step_ = (step_ + 1) % length_;
+  }
+
+  uint8_t length = min(quantity, (uint8_t)sizeof(data));
+  memcpy(buffer, data, length);
+  return length;
+}
+
+// ------------------ Bluetooth sink --------------------- //
+
+static const BTSimTrack btTracks[] = {
+    {"Lullaby", "The Cure", "Disintegration", 248000},
+    {"Sweet Jane", "The Velvet Underground", "Loaded", 198000},
+    {"A rather long title that will be clamped to thirty two chars", "Nobody", "", 0}, // No duration
+};
+
+void BluetoothSinkSim::onReceive(uint8_t address, const uint8_t *data, uint8_t length)
+{
+  if (length < 1)
+  {
+    return;
+  }
+  switch (data[0])
+  {
+  case 'p':
+  case 's':
+    position_ = positionNow_();
+    positionTime_ = millis();
+    playing_ = data[0] == 'p';
+    break;
+  case 'r':
+    changeTrack_((track_ + length_ - 1) % length_);
+    break;
+  case 'n':
+    changeTrack_((track_ + 1) % length_);
+    break;
+  case 'f':
+    selectedField_ = (length >= 2 && data[1] < BT_FIELD_COUNT) ? data[1] : -1;
+    break;
+  }
+}
+
+void BluetoothSinkSim::setConnected(bool connected)
+{
+  connected_ = connected;
+  for (uint8_t &revision : revisions_)
+  {
+    revision++;
+  }
+}
+
+uint32_t BluetoothSinkSim::positionNow_() const
+{
+  uint32_t position = playing_ ? position_ + (millis() - positionTime_) : position_;
+  uint32_t duration = tracks_[track_].duration;
+  return duration ? min(position, duration) : position;
+}
+
+void BluetoothSinkSim::changeTrack_(uint8_t track)
+{
+  track_ = track;
+  revisions_[BT_FIELD_TITLE]++;
+  revisions_[BT_FIELD_ARTIST]++;
+  revisions_[BT_FIELD_ALBUM]++;
+  position_ = 0;
+  positionTime_ = millis();
+  notifyPosition_();
+}
+
+void BluetoothSinkSim::notifyPosition_()
+{
+  reportedPosition_ = positionNow_();
+  positionRevision_++;
+  lastReport_ = millis();
+}
+
+uint8_t BluetoothSinkSim::onRequest(uint8_t address, uint8_t *buffer, uint8_t quantity)
+{
+  const int MAX_FIELD_LENGTH = 32;
+  uint8_t frame[BT_FIELD_LENGTH] = {0};
+  uint8_t frameLength;
+
+  int8_t field = selectedField_;
+  selectedField_ = -1;
+  if (field >= 0)
+  {
+    const BTSimTrack &track = tracks_[track_];
+    const char *text = !connected_                     ? ""
+                       : field == BT_FIELD_TITLE       ? track.title
+                       : field == BT_FIELD_ARTIST      ? track.artist
+                       : field == BT_FIELD_ALBUM       ? track.album
+                                                       : peerName_;
+    if (!text[0] && (field == BT_FIELD_TITLE || field == BT_FIELD_ARTIST))
+    {
+      text = "-";
+    }
+    frame[0] = 'F';
+    frame[1] = field;
+    frame[2] = revisions_[field];
+    strncpy((char *)&frame[3], text, MAX_FIELD_LENGTH);
+    frameLength = BT_FIELD_LENGTH;
+  }
+  else
+  {
+    if (playing_ && millis() - lastReport_ >= POSITION_INTERVAL)
+    {
+      notifyPosition_();
+    }
+    uint32_t duration = connected_ ? tracks_[track_].duration : 0;
+    uint16_t trackNumber = connected_ ? track_ + 1 : 0;
+    uint16_t trackCount = connected_ ? length_ : 0;
+    frame[0] = '#';
+    frame[1] = !connected_ ? 'D' : playing_ ? 'P' : 'S';
+    memcpy(&frame[2], revisions_, BT_FIELD_COUNT);
+    frame[6] = positionRevision_;
+    memcpy(&frame[8], &reportedPosition_, 4);
+    memcpy(&frame[12], &duration, 4);
+    memcpy(&frame[16], &trackNumber, 2);
+    memcpy(&frame[18], &trackCount, 2);
+    frameLength = BT_STATUS_LENGTH;
+  }
+
+  // The sink always sends the whole frame
+  uint8_t length = min(quantity, frameLength);
+  memcpy(buffer, frame, length);
+  return length;
+}
+
+// ------------------ RDA5807 --------------------- //
+
+static const FMSimStation fmStations[] = {
+    {8850, 42, true, 0xF201, "FIP     ", "FIP, la radio la plus eclectique du monde"},
+    {9120, 18, false, 0x0000, nullptr, nullptr}, // Weak, no RDS
+    {9480, 55, true, 0xF212, "JACKAL  ", "Now playing: simulated radio on a simulated bus"},
+    {10110, 35, true, 0xF0AA, "NEWS  FM", "Breaking: the I2C bus works"},
+    {10530, 25, false, 0xF3C1, "MONO FM ", "Mono station"},
+};
+
+#define RDA_CHIP_ID 0x5804
+#define RDA_RDS_GROUP_MS 88 // 104 bits at 1187.5 bps
+#define RDA_TUNE_MS 10
+#define RDA_SEEK_STEP_MS 8 // Per channel
+#define RDA_CLEAN_RDS_RSSI 35 // Block errors below this
+
+void RDA5807Sim::reset_()
+{
+  memset(registers_, 0, sizeof(registers_));
+  registers_[0x00] = RDA_CHIP_ID;
+  registers_[0x0B] = 1 << 7; // FM_READY
+  channel_ = 0;
+  groupIndex_ = 0;
+}
+
+void RDA5807Sim::onReceive(uint8_t address, const uint8_t *data, uint8_t length)
+{
+  if (address == FM_FULL_ACCESS_I2C_ADDRESS)
+  {
+    // Sequential writes always start at 0x02
+    for (uint8_t i = 0; i + 1 < length; i += 2)
+    {
+      writeRegister_(0x02 + i / 2, (data[i] << 8) | data[i + 1]);
+    }
+    return;
+  }
+
+  if (length < 1)
+  {
+    return;
+  }
+  pointer_ = data[0] & 0x0F;
+  for (uint8_t i = 1; i + 1 < length; i += 2)
+  {
+    writeRegister_(pointer_ + i / 2, (data[i] << 8) | data[i + 1]);
+  }
+}
+
+uint8_t RDA5807Sim::onRequest(uint8_t address, uint8_t *buffer, uint8_t quantity)
+{
+  // Sequential reads always start at 0x0A
+  uint8_t reg = address == FM_FULL_ACCESS_I2C_ADDRESS ? 0x0A : pointer_;
+  if (reg <= 0x0A && reg + quantity / 2 > 0x0A)
+  {
+    updateStatus_();
+  }
+
+  uint8_t length = quantity & ~1;
+  for (uint8_t i = 0; i < length; i += 2)
+  {
+    uint16_t value = registers_[(reg + i / 2) & 0x0F];
+    buffer[i] = value >> 8;
+    buffer[i + 1] = value & 0xFF;
+  }
+  return length;
+}
+
+void RDA5807Sim::writeRegister_(uint8_t reg, uint16_t value)
+{
+  if (reg >= 0x0A)
+  {
+    return; // Status registers are read only
+  }
+  registers_[reg] = value;
+
+  if (reg == 0x02)
+  {
+    if (value & (1 << 1)) // SOFT_RESET
+    {
+      reset_();
+      registers_[0x02] = value & ~(1 << 1);
+    }
+    else if (value & (1 << 8)) // SEEK
+    {
+      registers_[0x02] &= ~(1 << 8);
+      seek_(value & (1 << 9));
+    }
+  }
+  else if (reg == 0x03 && (value & (1 << 4))) // TUNE
+  {
+    registers_[0x03] &= ~(1 << 4);
+    tune_(value >> 6);
+  }
+  else if (reg == 0x04 && (value & (1 << 9))) // RDS_FIFO_CLR
+  {
+    registers_[0x04] &= ~(1 << 9);
+    groupIndex_ = 0;
+  }
+}
+
+uint16_t RDA5807Sim::frequency_(uint16_t channel) const
+{
+  static const uint16_t spacings[] = {10, 20, 5, 2};
+  uint8_t band = (registers_[0x03] >> 2) & 0x03;
+  uint16_t bottom = band == 0 ? 8700 : (band == 3 ? 6500 : 7600);
+  return bottom + channel * spacings[registers_[0x03] & 0x03];
+}
+
+void RDA5807Sim::tune_(uint16_t channel)
+{
+  // STC goes high after RDA_TUNE_MS, see progress_()
+  fromChannel_ = channel_;
+  targetChannel_ = channel & 0x3FF;
+  seekSteps_ = 0;
+  seekFailed_ = false;
+  tuneStart_ = millis();
+  tuning_ = true;
+  registers_[0x0A] &= ~((1 << 14) | (1 << 13)); // Clear STC, SF
+}
+
+void RDA5807Sim::seek_(bool up)
+{
+  uint16_t current = frequency_(channel_);
+  bool wrap = !(registers_[0x02] & (1 << 7)); // SKMODE
+  int16_t best = -1;
+  int16_t wrapped = -1;
+  for (uint8_t i = 0; i < length_; i++)
+  {
+    uint16_t frequency = stations_[i].frequency;
+    if (up ? frequency > current : frequency < current)
+    {
+      if (best < 0 || (up ? frequency < stations_[best].frequency : frequency > stations_[best].frequency))
+        best = i;
+    }
+    if (wrapped < 0 || (up ? frequency < stations_[wrapped].frequency : frequency > stations_[wrapped].frequency))
+      wrapped = i;
+  }
+  if (best < 0 && wrap)
+  {
+    best = wrapped;
+  }
+
+  // The chip walks the channels one by one, READCHAN follows the sweep
+  uint16_t spacing = frequency_(1) - frequency_(0);
+  uint16_t channels = channelCount_();
+  uint16_t target = best < 0 ? (up ? channels - 1 : 0) : (stations_[best].frequency - frequency_(0)) / spacing;
+  tune_(target);
+  seekUp_ = up;
+  seekFailed_ = best < 0;
+  seekSteps_ = up ? (target + channels - fromChannel_) % channels : (fromChannel_ + channels - target) % channels;
+}
+
+uint16_t RDA5807Sim::channelCount_() const
+{
+  static const uint16_t tops[] = {10800, 9100, 10800, 7600};
+  uint8_t band = (registers_[0x03] >> 2) & 0x03;
+  return (tops[band] - frequency_(0)) / (frequency_(1) - frequency_(0)) + 1;
+}
+
+void RDA5807Sim::progress_()
+{
+  if (!tuning_)
+  {
+    return;
+  }
+  uint32_t elapsed = millis() - tuneStart_;
+  if (seekSteps_ > 0)
+  {
+    uint16_t channels = channelCount_();
+    uint16_t walked = min(elapsed / RDA_SEEK_STEP_MS, (uint32_t)seekSteps_);
+    channel_ = seekUp_ ? (fromChannel_ + walked) % channels : (fromChannel_ + channels - walked) % channels;
+  }
+  if (elapsed < RDA_TUNE_MS + (uint32_t)seekSteps_ * RDA_SEEK_STEP_MS)
+  {
+    registers_[0x0A] = (registers_[0x0A] & ~0x3FF) | channel_;
+    return;
+  }
+
+  tuning_ = false;
+  channel_ = targetChannel_;
+  groupIndex_ = 0;
+  registers_[0x0A] = (registers_[0x0A] & ~0x3FF) | (1 << 14) | channel_; // STC
+  if (seekFailed_)
+  {
+    registers_[0x0A] |= 1 << 13; // SF
+  }
+  LOG_FM_MSGF("Sim FM: tuned to %u\n", frequency_(channel_));
+}
+
+const FMSimStation *RDA5807Sim::station_() const
+{
+  uint16_t frequency = frequency_(channel_);
+  for (uint8_t i = 0; i < length_; i++)
+  {
+    if (stations_[i].frequency == frequency)
+      return &stations_[i];
+  }
+  return nullptr;
+}
+
+void RDA5807Sim::updateStatus_()
+{
+  progress_();
+
+  bool enabled = registers_[0x02] & 1;
+  bool mono = registers_[0x02] & (1 << 13);
+  bool rdsEnabled = registers_[0x02] & (1 << 3);
+  const FMSimStation *station = enabled ? station_() : nullptr;
+
+  uint16_t reg0a = registers_[0x0A] & ((1 << 14) | (1 << 13) | 0x3FF); // Keep STC, SF, READCHAN
+  uint16_t reg0b = 1 << 7;                                               // FM_READY
+  if (station)
+  {
+    uint8_t rssi = constrain(station->rssi + random(-2, 3), 0, 0x7F);
+    reg0b |= rssi << 9 | (1 << 8); // RSSI, FM_TRUE
+    if (station->stereo && !mono)
+      reg0a |= 1 << 10; // ST
+  }
+  else if (enabled)
+  {
+    reg0b |= random(0, 8) << 9; // Noise floor
+  }
+
+  if (station && station->ps && rdsEnabled && !tuning_)
+  {
+    reg0a |= 1 << 12; // RDSS
+    if (millis() - lastGroup_ >= RDA_RDS_GROUP_MS)
+    {
+      lastGroup_ = millis();
+      nextRdsGroup_();
+      reg0a |= 1 << 15; // RDSR
+      // Weak stations get uncorrectable blocks
+      if (random(0, 100) < (RDA_CLEAN_RDS_RSSI - (int)station->rssi) * 3)
+      {
+        reg0b |= random(0, 2) ? 3 << 2 : 3; // BLERA or BLERB
+      }
+    }
+    else
+    {
+      reg0b |= registers_[0x0B] & 0x0F; // Keep the levels of the last group
+    }
+  }
+  registers_[0x0A] = reg0a;
+  registers_[0x0B] = reg0b;
+}
+
+void RDA5807Sim::nextRdsGroup_()
+{
+  const FMSimStation *station = station_();
+  const uint16_t pty = 10; // Pop music
+  uint16_t blockB = pty << 5;
+  uint16_t blockC = 0;
+  uint16_t blockD = 0;
+
+  // Interleave 4 PS segments (0A) with 16 radio text segments (2A), with a
+  // clock time group (4A) at the start of every minute like real stations
+  time_t t = now();
+  if (t / 60 != lastClockMinute_)
+  {
+    lastClockMinute_ = t / 60;
+    uint32_t mjd = t / 86400 + 40587;
+    blockB |= (4 << 12) | ((mjd >> 15) & 0x03);
+    blockC = ((mjd & 0x7FFF) << 1) | (hour(t) >> 4);
+    blockD = ((hour(t) & 0x0F) << 12) | (minute(t) << 6);
+    groupIndex_--; // Don't skip a PS / RT segment
+  }
+  else if (groupIndex_ % 2 == 0)
+  {
+    uint8_t segment = (groupIndex_ / 2) % 4;
+    blockB |= (0 << 12) | segment;
+    blockC = 0xE0CD; // No AF
+    blockD = (station->ps[segment * 2] << 8) | station->ps[segment * 2 + 1];
+  }
+  else
+  {
+    uint8_t segment = (groupIndex_ / 2) % 16;
+    char text[4];
+    for (uint8_t i = 0; i < 4; i++)
+    {
+      uint8_t index = segment * 4 + i;
+      size_t length = strlen(station->radioText);
+      text[i] = index < length ? station->radioText[index] : index == length ? '\r' : ' ';
+    }
+    blockB |= (2 << 12) | segment;
+    blockC = (text[0] << 8) | text[1];
+    blockD = (text[2] << 8) | text[3];
+  }
+  groupIndex_++;
+
+  registers_[0x0C] = station->pi;
+  registers_[0x0D] = blockB;
+  registers_[0x0E] = blockC;
+  registers_[0x0F] = blockD;
+}
+
+// ------------------ Setup --------------------- //
+
+static IOBoardSim ioBoardSim(ioScript, sizeof(ioScript) / sizeof(ioScript[0]));
+static BluetoothSinkSim bluetoothSinkSim(btTracks, sizeof(btTracks) / sizeof(btTracks[0]), "Sim phone");
+static RDA5807Sim rda5807Sim(fmStations, sizeof(fmStations) / sizeof(fmStations[0]));
+
+void attachSimulatedDevices()
+{
+  LOG_I2C_MSG("Attaching simulated I2C devices");
+
+  ioBoardSim.faults.nackEvery = 50;
+  ioBoardSim.faults.holdSdaEvery = 600; // Stuck bus roughly every minute
+  ioBoardSim.faults.holdSdaClocks = 4;
+
+  bluetoothSinkSim.faults.stretchUs = 300;
+  bluetoothSinkSim.faults.shortReadEvery = 40;
+
+  i2cBus.attachSimDevice(IO_BOARD_I2C_ADDRESS, &ioBoardSim);
+  i2cBus.attachSimDevice(BT_MODULE_I2C_ADDRESS, &bluetoothSinkSim);
+  i2cBus.attachSimDevice(FM_FULL_ACCESS_I2C_ADDRESS, &rda5807Sim);
+  i2cBus.attachSimDevice(FM_DIRECT_ACCESS_I2C_ADDRESS, &rda5807Sim);
+}
+
+IOBoardSim &simulatedIOBoard()
+{
+  return ioBoardSim;
+}
+
+#endif // I2C_SIMULATED_BUS
@@ -0,0 +1,116 @@
+#include "I2CSpeedController.h"
+#include "Log.h"
+
+const uint32_t I2CSpeedController::SPEEDS[SPEED_COUNT] = {400000, 100000};
+
+static uint32_t errorCount(const I2CDeviceStats &stats)
+{
+  return stats.nacks + stats.shortReads + stats.timeouts + stats.busResets;
+}
+
+// Counters can go back to 0 when the stats are cleared from the serial console
+static uint32_t delta(uint32_t current, uint32_t last)
+{
+  return current >= last ? current - last : current;
+}
+
+void I2CSpeedController::begin()
+{
+  setLevel_(0);
+  probing_ = false;
+  probeDelay_ = PROBE_DELAY;
+  windowTimer_ = 0;
+  cleanTimer_ = 0;
+}
+
+void I2CSpeedController::update()
+{
+  if (windowTimer_ < WINDOW)
+  {
+    return;
+  }
+  unsigned long window = windowTimer_;
+  windowTimer_ = 0;
+
+  uint32_t transactions = 0;
+  uint32_t errors = 0;
+  for (uint8_t i = 0; i < i2cBus.getDeviceCount(); i++)
+  {
+    const I2CDeviceStats &stats = i2cBus.getStatsAt(i);
+    uint32_t deviceTransactions = delta(stats.transactions, lastTransactions_[i]);
+    uint32_t deviceErrors = delta(errorCount(stats), lastErrors_[i]);
+    throughput_[i] = delta(stats.bytes, lastBytes_[i]) * 1000 / window;
+    transactions += deviceTransactions;
+    errors += deviceErrors;
+
+    if (deviceTransactions > 0)
+    {
+      LOG_I2C_MSGF("I2C 0x%02X %s: %lu B/s, %lu errors / %lu transactions\n", stats.address,
+                   stats.name ? stats.name : "?", throughput_[i], deviceErrors, deviceTransactions);
+    }
+    lastTransactions_[i] = stats.transactions;
+    lastErrors_[i] = errorCount(stats);
+    lastBytes_[i] = stats.bytes;
+  }
+
+  if (errors > 0)
+  {
+    cleanTimer_ = 0;
+  }
+
+  bool tooManyErrors = errors * 100 > transactions * MAX_ERROR_PERCENT;
+  if (tooManyErrors && (transactions >= MIN_TRANSACTIONS || probing_))
+  {
+    if (probing_)
+    {
+      // The faster speed did not hold, wait longer before the next attempt
+      probeDelay_ = min(probeDelay_ * 2, MAX_PROBE_DELAY);
+      probing_ = false;
+    }
+    if (level_ < SPEED_COUNT - 1)
+    {
+      LOG_I2C_MSGF("I2C error rate %lu/%lu, stepping down\n", errors, transactions);
+      stepDowns_++;
+      setLevel_(level_ + 1);
+    }
+    return;
+  }
+
+  if (probing_ && transactions >= MIN_TRANSACTIONS)
+  {
+    // A full window at the new speed without trouble
+    probing_ = false;
+    probeDelay_ = PROBE_DELAY;
+  }
+  else if (level_ > 0 && cleanTimer_ >= probeDelay_)
+  {
+    LOG_I2C_MSGF("I2C clean for %lu ms, probing up\n", (unsigned long)cleanTimer_);
+    stepUps_++;
+    probing_ = true;
+    cleanTimer_ = 0;
+    setLevel_(level_ - 1);
+  }
+}
+
+void I2CSpeedController::setLevel_(uint8_t level)
+{
+  level_ = level;
+  i2cBus.setClock(SPEEDS[level_]);
+  LOG_I2C_MSGF("I2C clock set to %lu Hz\n", SPEEDS[level_]);
+}
+
+void I2CSpeedController::printStatus(Print &out) const
+{
+  out.printf("Bus speed: %lu Hz, %lu step downs, %lu probes%s, next probe after %lu ms clean\n",
+             (unsigned long)SPEEDS[level_], (unsigned long)stepDowns_, (unsigned long)stepUps_,
+             probing_ ? " (probing)" : "", (unsigned long)probeDelay_);
+  for (uint8_t i = 0; i < i2cBus.getDeviceCount(); i++)
+  {
+    const I2CDeviceStats &stats = i2cBus.getStatsAt(i);
+    if (throughput_[i] > 0)
+    {
+      out.printf("  0x%02X %-5s %lu B/s\n", stats.address, stats.name ? stats.name : "?",
+                 (unsigned long)throughput_[i]);
+    }
+  }
+}
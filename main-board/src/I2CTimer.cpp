@@ -1,11 +1,33 @@
 #include "I2CTimer.h"
 #include "Log.h"
+#include "I2C.h"
+#include <I2CBus.h>
+
+// Device charged with a timeout when an operation holds the bus for too long
+static uint8_t operationAddress(I2CTimer::BusOperation operation)
+{
+  switch (operation)
+  {
+  case I2CTimer::IO_POLL:
+    return IO_BOARD_I2C_ADDRESS;
+  case I2CTimer::BT_STATUS:
+    return BT_MODULE_I2C_ADDRESS;
+  case I2CTimer::RDS_POLL:
+    return FM_FULL_ACCESS_I2C_ADDRESS;
+  case I2CTimer::TUNE_POLL:
+    return FM_DIRECT_ACCESS_I2C_ADDRESS;
+  default:
+    return 0;
+  }
+}
 
 I2CTimer::I2CTimer()
 {
   firstIOPoll = 0;
   lastIOPoll = 0;
   lastBTPoll = 0;
+  lastRDSPoll = 0;
+  lastTunePoll = 0;
   lastResponse = 0;
   lastRetry = 0;
   timeoutFlag = false;
@@ -26,6 +48,7 @@ void I2CTimer::begin()
   currentRetryCount = 0;
   isRetrying = false;
   lastRDSPoll = now;
+  lastTunePoll = now;
   currentOperation = NONE;
   operationStartTime = 0;
 }
@@ -89,6 +112,24 @@ bool I2CTimer::shouldPollRDS()
   return false;
 }
 
+bool I2CTimer::shouldPollTune()
+{
+  if (currentOperation != NONE && currentOperation != TUNE_POLL)
+  {
+    return false;
+  }
+  if ((millis() - lastTunePoll) >= TUNE_POLL_INTERVAL)
+  {
+    if (currentOperation == NONE)
+    {
+      currentOperation = TUNE_POLL;
+      operationStartTime = millis();
+    }
+    return true;
+  }
+  return false;
+}
+
 bool I2CTimer::hasTimeout()
 {
   return timeoutFlag;
@@ -115,7 +156,8 @@ void I2CTimer::update()
   {
     if ((currentTime - operationStartTime) >= OPERATION_TIMEOUT)
     {
-      LOG_I2C_MSG("I2C Timer: Operation timeout - releasing bus from " + String(currentOperation));
+      LOG_I2C_MSGF("I2C Timer: Operation timeout - releasing bus from %d\n", currentOperation);
+      i2cBus.recordTimeout(operationAddress(currentOperation));
       releaseBus();
     }
   }
@@ -136,6 +178,11 @@ void I2CTimer::markRDSPolled()
   lastRDSPoll = millis();
 }
 
+void I2CTimer::markTunePolled()
+{
+  lastTunePoll = millis();
+}
+
 bool I2CTimer::shouldRetry()
 {
   if (!isRetrying || currentRetryCount >= MAX_RETRIES)
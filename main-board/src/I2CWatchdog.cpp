@@ -0,0 +1,80 @@
+#include "I2CWatchdog.h"
+#include "Log.h"
+#include <I2CBus.h>
+
+void I2CWatchdog::reportSuccess()
+{
+  if (state_ != HEALTHY && recoveredInIncident_)
+  {
+    uint32_t recoverMs = millis() - incidentStart_;
+    incidents_++;
+    totalRecoverMs_ += recoverMs;
+    maxRecoverMs_ = max(maxRecoverMs_, recoverMs);
+    LOG_I2C_MSGF("I2C bus back after %lu ms\n", recoverMs);
+  }
+  state_ = HEALTHY;
+  failures_ = 0;
+  backoff_ = INITIAL_BACKOFF;
+  recoveredInIncident_ = false;
+}
+
+bool I2CWatchdog::reportFailure(uint8_t address)
+{
+  if (state_ == HEALTHY)
+  {
+    state_ = FAILING;
+    incidentStart_ = millis();
+  }
+  failures_++;
+
+  if (failures_ < FAILURE_THRESHOLD)
+  {
+    return false;
+  }
+  return recover_(address);
+}
+
+bool I2CWatchdog::reportTimeout()
+{
+  if (state_ == HEALTHY)
+  {
+    state_ = FAILING;
+    incidentStart_ = millis();
+  }
+  return recover_(0);
+}
+
+bool I2CWatchdog::recover_(uint8_t address)
+{
+  if (state_ == BACKOFF && sinceRecovery_ < backoff_)
+  {
+    return false;
+  }
+  if (state_ == BACKOFF)
+  {
+    // Still failing after the previous recovery
+    backoff_ = min(backoff_ * 2, MAX_BACKOFF);
+  }
+
+  LOG_I2C_MSGF("Recovering I2C bus after %d failures (0x%02X)\n", failures_, address);
+  if (!i2cBus.recoverBus(address))
+  {
+    failedRecoveries_++;
+    LOG_I2C_MSG("SDA still held low after recovery");
+  }
+  recoveries_++;
+  recoveredInIncident_ = true;
+  state_ = BACKOFF;
+  failures_ = 0;
+  sinceRecovery_ = 0;
+  return true;
+}
+
+void I2CWatchdog::printStatus(Print &out) const
+{
+  uint32_t average = incidents_ ? totalRecoverMs_ / incidents_ : 0;
+  out.printf("Watchdog: state %d, %lu recoveries (%lu with SDA still low), backoff %lu ms\n",
+             state_, (unsigned long)recoveries_, (unsigned long)failedRecoveries_, (unsigned long)backoff_);
+  out.printf("  time to recover: %lu incidents, mean %lu ms, max %lu ms\n", (unsigned long)incidents_,
+             (unsigned long)average, (unsigned long)maxRecoverMs_);
+}
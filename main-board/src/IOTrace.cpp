@@ -0,0 +1,160 @@
+#include "IOTrace.h"
+#include "Log.h"
+
+static const char *IO_TRACE_HEADER = "ms,buttons,volume,tone,tuning,brightness,fm,control,uid\n";
+
+bool IOTrace::startSD()
+{
+  stop();
+  if (!SD.exists(IO_TRACE_FOLDER))
+  {
+    SD.mkdir(IO_TRACE_FOLDER);
+  }
+  for (int i = 0; i < 1000; i++)
+  {
+    snprintf(path_, sizeof(path_), IO_TRACE_FOLDER "/io%03d.csv", i);
+    if (!SD.exists(path_))
+    {
+      file_ = SD.open(path_, FILE_WRITE);
+      break;
+    }
+  }
+  if (!file_)
+  {
+    LOG("Unable to create the IO trace file");
+    path_[0] = '\0';
+    return false;
+  }
+  LOGF("Recording IO trace to %s\n", path_);
+  start_(&file_);
+  return true;
+}
+
+void IOTrace::startSerial()
+{
+  stop();
+  start_(&Serial);
+}
+
+void IOTrace::start_(Print *out)
+{
+  head_ = tail_ = 0;
+  hasLast_ = false;
+  dropped_ = 0;
+  out->print(IO_TRACE_HEADER);
+  flushTimer_ = 0;
+  out_ = out;
+}
+
+void IOTrace::stop()
+{
+  if (!out_)
+  {
+    return;
+  }
+  drain();
+  if (out_ == &file_)
+  {
+    file_.close();
+  }
+  out_ = nullptr;
+}
+
+void IOTrace::record(const IOTraceFrame &frame)
+{
+  if (!out_)
+  {
+    return;
+  }
+  // Everything but the timestamp, the struct ends with padding
+  static const size_t COMPARED = offsetof(IOTraceFrame, nfcUid) + sizeof(frame.nfcUid) - offsetof(IOTraceFrame, buttons);
+  if (hasLast_ && memcmp(&frame.buttons, &last_.buttons, COMPARED) == 0)
+  {
+    return;
+  }
+  last_ = frame;
+  hasLast_ = true;
+
+  uint8_t next = (head_ + 1) & (CAPACITY - 1);
+  if (next == tail_)
+  {
+    dropped_++;
+    return;
+  }
+  ring_[head_] = frame;
+  head_ = next;
+}
+
+void IOTrace::drain()
+{
+  if (!out_)
+  {
+    return;
+  }
+  bool toSerial = (out_ != &file_);
+  char line[LINE_LENGTH];
+  while (tail_ != head_)
+  {
+    // Serial output must not block the loop, what doesn't fit waits
+    if (toSerial && Serial.availableForWrite() < LINE_LENGTH)
+    {
+      break;
+    }
+    format(ring_[tail_], line);
+    out_->print(line);
+    tail_ = (tail_ + 1) & (CAPACITY - 1);
+  }
+
+  if (!toSerial && flushTimer_ >= FLUSH_INTERVAL)
+  {
+    flushTimer_ = 0;
+    file_.flush();
+  }
+}
+
+void IOTrace::format(const IOTraceFrame &frame, char *line)
+{
+  int length = snprintf(line, LINE_LENGTH, "%lu,%u,%u,%u,%u,%u,%u,%u,", (unsigned long)frame.ms,
+                        frame.buttons, frame.volume, frame.tone, frame.tuning, frame.brightness,
+                        frame.fmValue, frame.control);
+  for (int i = 0; i < 7; i++)
+  {
+    length += snprintf(line + length, LINE_LENGTH - length, "%02X", frame.nfcUid[i]);
+  }
+  snprintf(line + length, LINE_LENGTH - length, "\n");
+}
+
+bool IOTrace::parse(const char *line, IOTraceFrame &frame)
+{
+  unsigned long ms;
+  unsigned int values[7];
+  char uid[15];
+  if (sscanf(line, "%lu,%u,%u,%u,%u,%u,%u,%u,%14[0-9A-Fa-f]", &ms, &values[0], &values[1], &values[2],
+             &values[3], &values[4], &values[5], &values[6], uid) != 9 ||
+      strlen(uid) != 14)
+  {
+    return false;
+  }
+  for (int i = 0; i < 7; i++)
+  {
+    if (values[i] > 255)
+    {
+      return false;
+    }
+  }
+
+  frame.ms = ms;
+  frame.buttons = values[0];
+  frame.volume = values[1];
+  frame.tone = values[2];
+  frame.tuning = values[3];
+  frame.brightness = values[4];
+  frame.fmValue = values[5];
+  frame.control = values[6];
+  for (int i = 0; i < 7; i++)
+  {
+    char hex[3] = {uid[i * 2], uid[i * 2 + 1], '\0'};
+    frame.nfcUid[i] = strtoul(hex, nullptr, 16);
+  }
+  return true;
+}
@@ -0,0 +1,87 @@
+#include "PerfHud.h"
+#include <Audio.h>
+#include <I2CBus.h>
+
+// Counters can go back to 0 when the stats are cleared from the serial console
+static uint32_t delta(uint32_t current, uint32_t last)
+{
+  return current >= last ? current - last : current;
+}
+
+// Keeps a field within the digits it has on the strip
+static unsigned int cap(uint32_t value, unsigned int max)
+{
+  return value < max ? value : max;
+}
+
+void PerfHud::toggle()
+{
+  visible_ = !visible_;
+  if (visible_)
+  {
+    // Start from a fresh window
+    refresh_();
+  }
+  else
+  {
+    display_.drawPerfHud("");
+  }
+}
+
+void PerfHud::frameRendered(uint32_t renderUs)
+{
+  frames_++;
+  totalRenderUs_ += renderUs;
+  if (renderUs > maxRenderUs_)
+  {
+    maxRenderUs_ = renderUs;
+  }
+}
+
+const char *PerfHud::getLine()
+{
+  if (refreshTimer_ >= REFRESH_INTERVAL)
+  {
+    refresh_();
+  }
+  return line_;
+}
+
+void PerfHud::refresh_()
+{
+  unsigned long elapsed = refreshTimer_;
+  refreshTimer_ = 0;
+
+  uint32_t pushes = delta(display_.getPushCount(), lastPushes_);
+  lastPushes_ = display_.getPushCount();
+
+  uint32_t transactions = 0;
+  uint32_t errors = 0;
+  for (uint8_t i = 0; i < i2cBus.getDeviceCount(); i++)
+  {
+    const I2CDeviceStats &stats = i2cBus.getStatsAt(i);
+    transactions += stats.transactions;
+    errors += stats.nacks + stats.shortReads + stats.timeouts + stats.busResets;
+  }
+  uint32_t windowTransactions = delta(transactions, lastTransactions_);
+  uint32_t windowErrors = delta(errors, lastI2CErrors_);
+  lastTransactions_ = transactions;
+  lastI2CErrors_ = errors;
+
+  // Tenths, the HUD doesn't use float formatting
+  unsigned int renderAverage = cap(frames_ ? totalRenderUs_ / frames_ / 100 : 0, 9999);
+  unsigned int renderMax = cap(maxRenderUs_ / 100, 9999);
+  unsigned int fps = cap(elapsed ? pushes * 1000 / elapsed : 0, 999);
+  unsigned int i2cErrors = cap(windowTransactions ? windowErrors * 1000 / windowTransactions : 0, 1000);
+
+  // At most "CPU100/100 BLK999/999 R999.9/999.9ms 999fps I2C100.0%"
+  snprintf(line_, sizeof(line_), "CPU%u/%u BLK%u/%u R%u.%u/%u.%ums %ufps I2C%u.%u%%",
+           cap(AudioProcessorUsage(), 100), cap(AudioProcessorUsageMax(), 100),
+           cap(AudioMemoryUsage(), 999), cap(AudioMemoryUsageMax(), 999),
+           renderAverage / 10, renderAverage % 10, renderMax / 10, renderMax % 10,
+           fps, i2cErrors / 10, i2cErrors % 10);
+
+  frames_ = 0;
+  totalRenderUs_ = 0;
+  maxRenderUs_ = 0;
+}
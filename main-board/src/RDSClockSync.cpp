@@ -0,0 +1,61 @@
+#include "RDSClockSync.h"
+#include "Log.h"
+#include <TimeLib.h>
+
+bool RDSClockSync::feed(const RDSClockTime &time)
+{
+  unsigned long received = millis();
+  // The RTC keeps local time, like the time setup screen sets it
+  uint32_t localTime = time.unixTime() + time.offset * 1800;
+
+  if (consistentGroups_ > 0)
+  {
+    uint32_t expected = lastTime_ + (received - lastReceived_) / 1000;
+    uint32_t mismatch = localTime > expected ? localTime - expected : expected - localTime;
+    if (mismatch > MAX_MISMATCH || time.offset != lastOffset_)
+    {
+      LOG_FM_MSGF("RDS clock time off by %lu s from the previous group", mismatch);
+      consistentGroups_ = 0;
+    }
+  }
+  if (consistentGroups_ < REQUIRED_GROUPS)
+  {
+    consistentGroups_++;
+  }
+  lastTime_ = localTime;
+  lastOffset_ = time.offset;
+  lastReceived_ = received;
+
+  if (consistentGroups_ < REQUIRED_GROUPS || (syncs_ > 0 && received - lastSync_ < SYNC_INTERVAL))
+  {
+    return false;
+  }
+  // CT groups are sent on the minute
+  sync_(localTime);
+  return true;
+}
+
+void RDSClockSync::sync_(uint32_t radioTime)
+{
+  int32_t correction = (int32_t)(Teensy3Clock.get() - radioTime);
+  if (syncs_ > 0)
+  {
+    // Rough estimate, the RTC only has a one second resolution
+    uint32_t elapsed = (millis() - lastSync_) / 1000;
+    driftPpm_ = elapsed ? (int64_t)correction * 1000000 / elapsed : 0;
+  }
+  lastSync_ = millis();
+  syncs_++;
+
+  if (abs(correction) < (int32_t)MIN_CORRECTION)
+  {
+    LOG_FM_MSGF("RTC in sync with RDS (%ld s)", correction);
+    return;
+  }
+
+  LOG_FM_MSGF("Setting RTC from RDS, correcting %ld s (%ld ppm)", correction, driftPpm_);
+  Teensy3Clock.set(radioTime);
+  setTime(radioTime);
+  lastCorrection_ = correction;
+  SNVS_LPGPR3 = (uint32_t)correction;
+}
@@ -0,0 +1,234 @@
+#include "RDSDecoder.h"
+#include <string.h>
+
+// Group types, from the upper 4 bits of block B
+#define RDS_GROUP_PS 0
+#define RDS_GROUP_RT 2
+#define RDS_GROUP_CT 4
+
+static bool isPrintable(char c)
+{
+  return c >= 0x20 && c < 0x7F;
+}
+
+void RDSDecoder::reset()
+{
+  pi_ = 0;
+  pty_ = 0;
+  tp_ = false;
+  memset(psBuffer_, ' ', RDS_PS_LENGTH);
+  psSegments_ = 0;
+  ps_[0] = '\0';
+  psChanged_ = true;
+  rtFlag_ = -1;
+  clearRadioText_();
+  rt_[0] = '\0';
+  rtChanged_ = true;
+  clockTimeValid_ = false;
+}
+
+void RDSDecoder::decode(uint16_t blockA, uint16_t blockB, uint16_t blockC, uint16_t blockD, uint8_t errors)
+{
+  groups_++;
+  if (errors & RDS_ERROR_B)
+  {
+    // Without block B there is no way to tell what the other blocks hold
+    droppedGroups_++;
+    return;
+  }
+
+  uint8_t groupType = blockB >> 12;
+  bool versionB = blockB & 0x0800;
+
+  // Version B groups repeat the PI code in block C
+  uint16_t pi = 0;
+  if (!(errors & RDS_ERROR_A))
+  {
+    pi = blockA;
+  }
+  else if (versionB && !(errors & RDS_ERROR_C))
+  {
+    pi = blockC;
+  }
+  if (pi != 0 && pi != pi_)
+  {
+    if (pi_ != 0)
+    {
+      // Another station, drop whatever was assembled for the previous one
+      reset();
+    }
+    pi_ = pi;
+  }
+
+  tp_ = blockB & 0x0400;
+  pty_ = (blockB >> 5) & 0x1F;
+
+  switch (groupType)
+  {
+  case RDS_GROUP_PS:
+    if (!(errors & RDS_ERROR_D))
+    {
+      decodeProgramService_(blockB, blockD);
+    }
+    break;
+  case RDS_GROUP_RT:
+    decodeRadioText_(blockB, blockC, blockD, versionB, errors);
+    break;
+  case RDS_GROUP_CT:
+    if (!versionB && !(errors & (RDS_ERROR_C | RDS_ERROR_D)))
+    {
+      decodeClockTime_(blockB, blockC, blockD);
+    }
+    break;
+  default:
+    break;
+  }
+}
+
+void RDSDecoder::decodeProgramService_(uint16_t blockB, uint16_t blockD)
+{
+  uint8_t segment = blockB & 0x03;
+  char first = blockD >> 8;
+  char second = blockD & 0xFF;
+  if (!isPrintable(first) || !isPrintable(second))
+  {
+    return;
+  }
+
+  psBuffer_[segment * 2] = first;
+  psBuffer_[segment * 2 + 1] = second;
+  psSegments_ |= 1 << segment;
+  if (psSegments_ == 0x0F)
+  {
+    publish_(ps_, psBuffer_, RDS_PS_LENGTH, psChanged_);
+    psSegments_ = 0;
+  }
+}
+
+void RDSDecoder::decodeRadioText_(uint16_t blockB, uint16_t blockC, uint16_t blockD, bool versionB, uint8_t errors)
+{
+  // 2A carries 4 chars in blocks C and D, 2B only 2 in block D
+  if (errors & (versionB ? RDS_ERROR_D : (RDS_ERROR_C | RDS_ERROR_D)))
+  {
+    return;
+  }
+
+  // A toggle of the text A/B flag (or a switch between 2A and 2B) means a new text
+  int8_t flag = (versionB ? 2 : 0) | ((blockB >> 4) & 0x01);
+  if (flag != rtFlag_)
+  {
+    clearRadioText_();
+    rtFlag_ = flag;
+  }
+
+  uint8_t segmentSize = versionB ? 2 : 4;
+  uint8_t maxLength = versionB ? RDS_RT_LENGTH / 2 : RDS_RT_LENGTH;
+  uint8_t segment = blockB & 0x0F;
+  char chars[4] = {(char)(blockC >> 8), (char)(blockC & 0xFF), (char)(blockD >> 8), (char)(blockD & 0xFF)};
+  const char *text = versionB ? chars + 2 : chars;
+
+  for (uint8_t i = 0; i < segmentSize; i++)
+  {
+    if (text[i] != '\r' && !isPrintable(text[i]))
+    {
+      return;
+    }
+  }
+  for (uint8_t i = 0; i < segmentSize; i++)
+  {
+    uint8_t position = segment * segmentSize + i;
+    if (text[i] == '\r')
+    {
+      // End of a text shorter than the full 64 / 32 chars
+      if (position < rtLength_)
+        rtLength_ = position;
+      break;
+    }
+    rtBuffer_[position] = text[i];
+  }
+  rtSegments_ |= 1 << segment;
+
+  if (rtLength_ > maxLength)
+  {
+    rtLength_ = maxLength;
+  }
+  uint8_t needed = (rtLength_ + segmentSize - 1) / segmentSize;
+  uint16_t mask = needed >= 16 ? 0xFFFF : (1 << needed) - 1;
+  if ((rtSegments_ & mask) == mask)
+  {
+    publish_(rt_, rtBuffer_, rtLength_, rtChanged_);
+    // Collect the next repetition from scratch, the station may edit it
+    rtSegments_ = 0;
+    rtLength_ = RDS_RT_LENGTH;
+  }
+}
+
+void RDSDecoder::decodeClockTime_(uint16_t blockB, uint16_t blockC, uint16_t blockD)
+{
+  RDSClockTime time;
+  time.mjd = ((uint32_t)(blockB & 0x03) << 15) | (blockC >> 1);
+  time.hour = ((blockC & 0x01) << 4) | (blockD >> 12);
+  time.minute = (blockD >> 6) & 0x3F;
+  time.offset = blockD & 0x1F;
+  if (blockD & 0x20)
+  {
+    time.offset = -time.offset;
+  }
+
+  // Stations without a clock send all zeros
+  if (time.mjd == 0 || time.hour > 23 || time.minute > 59)
+  {
+    return;
+  }
+  clockTime_ = time;
+  clockTimeValid_ = true;
+}
+
+void RDSDecoder::clearRadioText_()
+{
+  memset(rtBuffer_, ' ', RDS_RT_LENGTH);
+  rtBuffer_[RDS_RT_LENGTH] = '\0';
+  rtSegments_ = 0;
+  rtLength_ = RDS_RT_LENGTH;
+}
+
+void RDSDecoder::publish_(char *target, const char *source, uint8_t length, bool &changed)
+{
+  // Stations pad with spaces
+  while (length > 0 && source[length - 1] == ' ')
+  {
+    length--;
+  }
+  if (strncmp(target, source, length) == 0 && target[length] == '\0')
+  {
+    return;
+  }
+  memcpy(target, source, length);
+  target[length] = '\0';
+  changed = true;
+}
+
+bool RDSDecoder::takeProgramServiceChanged()
+{
+  bool changed = psChanged_;
+  psChanged_ = false;
+  return changed;
+}
+
+bool RDSDecoder::takeRadioTextChanged()
+{
+  bool changed = rtChanged_;
+  rtChanged_ = false;
+  return changed;
+}
+
+bool RDSDecoder::takeClockTime(RDSClockTime &time)
+{
+  if (!clockTimeValid_)
+  {
+    return false;
+  }
+  time = clockTime_;
+  clockTimeValid_ = false;
+  return true;
+}
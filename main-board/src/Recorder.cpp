@@ -78,8 +78,7 @@ void Recorder::continueRecording()
 
     if (usec > 3000)
     {
-      LOG_RECORDER_MSG("Long SD write: ");
-      LOG_RECORDER_MSG(usec);
+      LOG_RECORDER_MSGF("Long SD write: %lu us\n", (unsigned long)usec);
     }
   }
 }
@@ -151,8 +150,7 @@ void Recorder::play()
 
 void Recorder::playFile(const char *filename)
 {
-  LOG_RECORDER_MSG("playFile");
-  LOG_RECORDER_MSG(filename);
+  LOG_RECORDER_MSGF("playFile %s\n", filename);
 
   // Enforce cooldown period
   elapsedMillis cooldownTimer = 0;
@@ -297,8 +295,7 @@ bool Recorder::deleteCurrentFile()
     stopPlaying();
   }
 
-  LOG("Deleting file: ");
-  LOG(currentFilename);
+  LOGF("Deleting file: %s\n", currentFilename);
 
   char oldFilename[255];
   strncpy(oldFilename, currentFilename, sizeof(oldFilename));
@@ -0,0 +1,133 @@
+#include "Scheduler.h"
+#include "Log.h"
+
+bool Scheduler::addTask(const char *name, TaskFunction function, uint32_t periodUs,
+                        uint32_t deadlineUs, uint32_t budgetUs)
+{
+  if (count_ == MAX_TASKS)
+  {
+    return false;
+  }
+  Task &task = tasks_[count_++];
+  task = {};
+  task.name = name;
+  task.function = function;
+  task.periodUs = periodUs;
+  task.deadlineUs = deadlineUs;
+  task.budgetUs = budgetUs;
+  task.nextReleaseUs = micros();
+  if (count_ == 1)
+  {
+    statsStartUs_ = task.nextReleaseUs;
+  }
+  return true;
+}
+
+void Scheduler::run()
+{
+  for (uint8_t i = 0; i < count_; i++)
+  {
+    Task &task = tasks_[i];
+    uint32_t now = micros();
+    if (!task.yielded)
+    {
+      if (task.periodUs && (int32_t)(now - task.nextReleaseUs) < 0)
+      {
+        continue;
+      }
+      task.releasedUs = task.periodUs ? task.nextReleaseUs : now;
+    }
+
+    current_ = i;
+    sliceStartUs_ = now;
+    TRACE_BEGIN(TRACE_SCHED, task.name);
+    TaskResult result = task.function();
+    TRACE_END(TRACE_SCHED, task.name);
+    uint32_t end = micros();
+    current_ = -1;
+
+    uint32_t slice = end - now;
+    task.slices++;
+    task.totalUs += slice;
+    if (slice > task.maxSliceUs)
+    {
+      task.maxSliceUs = slice;
+    }
+
+    task.yielded = (result == TASK_YIELD);
+    if (!task.yielded)
+    {
+      complete_(task, end);
+    }
+  }
+}
+
+bool Scheduler::shouldYield() const
+{
+  if (current_ < 0 || tasks_[current_].budgetUs == 0)
+  {
+    return false;
+  }
+  return micros() - sliceStartUs_ >= tasks_[current_].budgetUs;
+}
+
+void Scheduler::complete_(Task &task, uint32_t endUs)
+{
+  task.runs++;
+  uint32_t response = endUs - task.releasedUs;
+  if (response > task.maxResponseUs)
+  {
+    task.maxResponseUs = response;
+  }
+  if (task.deadlineUs && response > task.deadlineUs)
+  {
+    task.overruns++;
+    LOGF("Task %s overran: %lu us (deadline %lu us)\n", task.name, response, task.deadlineUs);
+  }
+
+  if (task.periodUs)
+  {
+    task.nextReleaseUs += task.periodUs;
+    // Don't try to catch up when more than a period behind
+    uint32_t late = endUs - task.nextReleaseUs;
+    if ((int32_t)late >= (int32_t)task.periodUs)
+    {
+      task.skipped += late / task.periodUs;
+      task.nextReleaseUs = endUs;
+    }
+  }
+}
+
+void Scheduler::resetStats()
+{
+  for (uint8_t i = 0; i < count_; i++)
+  {
+    Task &task = tasks_[i];
+    task.runs = 0;
+    task.slices = 0;
+    task.totalUs = 0;
+    task.maxSliceUs = 0;
+    task.maxResponseUs = 0;
+    task.overruns = 0;
+    task.skipped = 0;
+  }
+  statsStartUs_ = micros();
+}
+
+void Scheduler::print(Print &out) const
+{
+  uint32_t elapsed = micros() - statsStartUs_;
+  out.printf("Scheduler, %lu ms\n", (unsigned long)(elapsed / 1000));
+  out.printf("  %-8s %7s %7s %7s %8s %9s %8s %7s %5s\n",
+             "task", "period", "runs", "avg us", "max us", "max resp", "overrun", "skipped", "load");
+  for (uint8_t i = 0; i < count_; i++)
+  {
+    const Task &task = tasks_[i];
+    uint32_t average = task.slices ? task.totalUs / task.slices : 0;
+    uint32_t load = elapsed ? task.totalUs * 1000 / elapsed : 0; // Per mille
+    out.printf("  %-8s %7lu %7lu %7lu %8lu %9lu %8lu %7lu %3lu.%lu%%\n",
+               task.name, (unsigned long)task.periodUs, (unsigned long)task.runs, (unsigned long)average,
+               (unsigned long)task.maxSliceUs, (unsigned long)task.maxResponseUs, (unsigned long)task.overruns,
+               (unsigned long)task.skipped, (unsigned long)(load / 10), (unsigned long)(load % 10));
+  }
+}
@@ -0,0 +1,146 @@
+#include "SignalQuality.h"
+
+void SignalQuality::reset()
+{
+  head_ = 0;
+  count_ = 0;
+  rdsBlocks_ = 0;
+  rdsErrors_ = 0;
+}
+
+void SignalQuality::addSample(uint8_t rssi, bool stereo)
+{
+  history_[head_] = {rssi, stereo, rdsBlocks_, rdsErrors_};
+  head_ = (head_ + 1) % HISTORY_LENGTH;
+  if (count_ < HISTORY_LENGTH)
+  {
+    count_++;
+  }
+  rdsBlocks_ = 0;
+  rdsErrors_ = 0;
+
+  if (count_ >= MIN_SAMPLES)
+  {
+    updateBlendMode_();
+  }
+}
+
+void SignalQuality::addRdsGroup(uint8_t errorBlocks)
+{
+  // Only A and B have an error level
+  if (rdsBlocks_ <= UINT8_MAX - 2)
+  {
+    rdsBlocks_ += 2;
+    rdsErrors_ += errorBlocks;
+  }
+}
+
+uint8_t SignalQuality::getRssi() const
+{
+  if (count_ == 0)
+  {
+    return 0;
+  }
+  uint16_t total = 0;
+  for (uint8_t i = 0; i < count_; i++)
+  {
+    total += history_[i].rssi;
+  }
+  return total / count_;
+}
+
+uint8_t SignalQuality::getStereoPercent() const
+{
+  if (count_ == 0)
+  {
+    return 0;
+  }
+  uint8_t stereo = 0;
+  for (uint8_t i = 0; i < count_; i++)
+  {
+    if (history_[i].stereo)
+      stereo++;
+  }
+  return stereo * 100 / count_;
+}
+
+bool SignalQuality::hasRds() const
+{
+  for (uint8_t i = 0; i < count_; i++)
+  {
+    if (history_[i].rdsBlocks > 0)
+      return true;
+  }
+  return false;
+}
+
+uint8_t SignalQuality::getRdsErrorPercent() const
+{
+  uint16_t blocks = 0;
+  uint16_t errors = 0;
+  for (uint8_t i = 0; i < count_; i++)
+  {
+    blocks += history_[i].rdsBlocks;
+    errors += history_[i].rdsErrors;
+  }
+  return blocks ? errors * 100 / blocks : 0;
+}
+
+uint8_t SignalQuality::getScore() const
+{
+  uint8_t rssi = getRssi();
+  if (rssi <= SCORE_MIN_RSSI)
+  {
+    return 0;
+  }
+  if (rssi > SCORE_MAX_RSSI)
+  {
+    rssi = SCORE_MAX_RSSI;
+  }
+  // RSSI counts for 60, the stereo pilot for 15 and clean RDS for 25
+  uint8_t score = (rssi - SCORE_MIN_RSSI) * 60 / (SCORE_MAX_RSSI - SCORE_MIN_RSSI);
+  score += getStereoPercent() * 15 / 100;
+  if (hasRds())
+  {
+    score += (100 - getRdsErrorPercent()) * 25 / 100;
+  }
+  return score;
+}
+
+uint8_t SignalQuality::getBars() const
+{
+  uint8_t rssi = getRssi();
+  if (count_ == 0 || rssi < BAR_MIN_RSSI)
+  {
+    return 0;
+  }
+  uint8_t bars = (rssi - BAR_MIN_RSSI) / BAR_STEP + 1;
+  return bars > BARS ? BARS : bars;
+}
+
+void SignalQuality::updateBlendMode_()
+{
+  // Going up needs the threshold, going down needs HYSTERESIS below it
+  uint8_t rssi = getRssi();
+  switch (blendMode_)
+  {
+  case BLEND_MONO:
+    if (rssi >= STEREO_RSSI)
+      blendMode_ = BLEND_STEREO;
+    else if (rssi >= SOFT_BLEND_RSSI)
+      blendMode_ = BLEND_SOFT;
+    break;
+  case BLEND_SOFT:
+    if (rssi >= STEREO_RSSI)
+      blendMode_ = BLEND_STEREO;
+    else if (rssi + HYSTERESIS < SOFT_BLEND_RSSI)
+      blendMode_ = BLEND_MONO;
+    break;
+  case BLEND_STEREO:
+    if (rssi + HYSTERESIS < SOFT_BLEND_RSSI)
+      blendMode_ = BLEND_MONO;
+    else if (rssi + HYSTERESIS < STEREO_RSSI)
+      blendMode_ = BLEND_SOFT;
+    break;
+  }
+}
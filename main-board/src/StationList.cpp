@@ -0,0 +1,213 @@
+#include "StationList.h"
+#include "Log.h"
+#include <SD.h>
+
+// frequency,rssi,stereo,PI,quality,PS - the PS is optional, and may hold commas
+#define STATION_LINE_FORMAT "%u,%u,%u,%04X,%u,%s\n"
+#define STATION_LINE_SCAN "%u,%u,%u,%x,%u,%8[^\r\n]"
+
+static bool parseStation(const char *line, FMStation &station)
+{
+  unsigned int frequency, rssi, stereo, pi, quality;
+  station = {};
+  int fields = sscanf(line, STATION_LINE_SCAN, &frequency, &rssi, &stereo, &pi, &quality, station.ps);
+  if (fields < 5 || frequency < 8760 || frequency > 10800)
+  {
+    return false;
+  }
+  station.frequency = frequency;
+  station.rssi = rssi;
+  station.stereo = stereo;
+  station.pi = pi;
+  station.quality = quality;
+  return true;
+}
+
+bool StationList::load(const char *path)
+{
+  File file = SD.open(path);
+  if (!file)
+  {
+    LOG_FM_MSG("No station list on the SD card");
+    return false;
+  }
+
+  clear();
+  char line[48];
+  uint8_t length = 0;
+  while (file.available() || length > 0)
+  {
+    int c = file.available() ? file.read() : '\n'; // Last line may not be terminated
+    if (c != '\n')
+    {
+      if (length < sizeof(line) - 1)
+        line[length++] = c;
+      continue;
+    }
+    line[length] = '\0';
+    length = 0;
+
+    // The file may have been edited, keep the list sorted
+    FMStation station;
+    if (parseStation(line, station) && count_ < MAX_STATIONS)
+    {
+      insert_(station);
+    }
+  }
+  file.close();
+  LOG_FM_MSGF("Loaded %d stations", count_);
+  return true;
+}
+
+bool StationList::save(const char *path) const
+{
+  if (!SD.exists(STATION_LIST_FOLDER))
+  {
+    SD.mkdir(STATION_LIST_FOLDER);
+  }
+  if (SD.exists(path))
+  {
+    SD.remove(path);
+  }
+  File file = SD.open(path, FILE_WRITE);
+  if (!file)
+  {
+    LOG_FM_MSG("Unable to write the station list");
+    return false;
+  }
+
+  for (uint8_t i = 0; i < count_; i++)
+  {
+    const FMStation &station = stations_[i];
+    file.printf(STATION_LINE_FORMAT, station.frequency, station.rssi, station.stereo, station.pi,
+                station.quality, station.ps);
+  }
+  file.close();
+  LOG_FM_MSGF("Saved %d stations", count_);
+  return true;
+}
+
+void StationList::update(const FMStation &station)
+{
+  // Keep only the strongest of neighbouring channels carrying the same station.
+  // A PI of 0 is unknown, the RSSI drop then tells a shoulder from a station
+  for (uint8_t i = 0; i < count_; i++)
+  {
+    const FMStation &other = stations_[i];
+    bool neighbour = other.frequency != station.frequency &&
+                     abs((int)other.frequency - (int)station.frequency) <= NEIGHBOUR_SPACING;
+    bool samePI = other.pi != 0 && other.pi == station.pi;
+    bool shoulder = (other.pi == 0 || station.pi == 0) &&
+                    abs((int)other.rssi - (int)station.rssi) >= SHOULDER_RSSI_DROP;
+    if (!neighbour || !(samePI || shoulder))
+    {
+      continue;
+    }
+    if (other.rssi >= station.rssi)
+    {
+      remove(station.frequency);
+      return;
+    }
+    removeAt_(i);
+    i--;
+  }
+
+  int8_t index = indexOf_(station.frequency);
+  if (index >= 0)
+  {
+    stations_[index] = station;
+    return;
+  }
+
+  if (count_ == MAX_STATIONS)
+  {
+    // Make room by dropping the weakest station, unless it's this one
+    uint8_t weakest = 0;
+    for (uint8_t i = 1; i < count_; i++)
+    {
+      if (stations_[i].rssi < stations_[weakest].rssi)
+        weakest = i;
+    }
+    if (stations_[weakest].rssi >= station.rssi)
+    {
+      return;
+    }
+    removeAt_(weakest);
+  }
+  insert_(station);
+}
+
+void StationList::remove(uint16_t frequency)
+{
+  int8_t index = indexOf_(frequency);
+  if (index >= 0)
+  {
+    removeAt_(index);
+  }
+}
+
+const FMStation *StationList::next(uint16_t frequency, bool up) const
+{
+  if (count_ == 0)
+  {
+    return nullptr;
+  }
+  if (up)
+  {
+    for (uint8_t i = 0; i < count_; i++)
+    {
+      if (stations_[i].frequency > frequency)
+        return &stations_[i];
+    }
+    return &stations_[0];
+  }
+  for (int8_t i = count_ - 1; i >= 0; i--)
+  {
+    if (stations_[i].frequency < frequency)
+      return &stations_[i];
+  }
+  return &stations_[count_ - 1];
+}
+
+const FMStation *StationList::find(uint16_t frequency) const
+{
+  int8_t index = indexOf_(frequency);
+  return index >= 0 ? &stations_[index] : nullptr;
+}
+
+int8_t StationList::indexOf_(uint16_t frequency) const
+{
+  for (uint8_t i = 0; i < count_; i++)
+  {
+    if (stations_[i].frequency == frequency)
+      return i;
+  }
+  return -1;
+}
+
+void StationList::insert_(const FMStation &station)
+{
+  int8_t index = indexOf_(station.frequency);
+  if (index >= 0)
+  {
+    stations_[index] = station;
+    return;
+  }
+  uint8_t position = count_;
+  while (position > 0 && stations_[position - 1].frequency > station.frequency)
+  {
+    stations_[position] = stations_[position - 1];
+    position--;
+  }
+  stations_[position] = station;
+  count_++;
+}
+
+void StationList::removeAt_(uint8_t index)
+{
+  for (uint8_t i = index; i + 1 < count_; i++)
+  {
+    stations_[i] = stations_[i + 1];
+  }
+  count_--;
+}
@@ -0,0 +1,116 @@
+#include "Log.h"
+#include "Trace.h"
+
+#if TRACE_ENABLED
+Trace trace;
+#endif
+
+void Trace::begin(uint8_t category, const char *name)
+{
+  if (!isEnabled(category))
+  {
+    return;
+  }
+  Record record;
+  start_(record, category, TYPE_BEGIN, name);
+  commit_(record);
+}
+
+void Trace::end(uint8_t category, const char *name)
+{
+  if (!isEnabled(category))
+  {
+    return;
+  }
+  Record record;
+  start_(record, category, TYPE_END, name);
+  commit_(record);
+}
+
+void Trace::drain(Print &out)
+{
+  if (millis() - lastSync_ >= SYNC_INTERVAL)
+  {
+    sync_();
+  }
+  while (tail_ != head_ && out.availableForWrite() >= (int)sizeof(Record))
+  {
+    out.write((const uint8_t *)&ring_[tail_ % CAPACITY], sizeof(Record));
+    tail_ = tail_ + 1;
+  }
+}
+
+void Trace::start_(Record &record, uint8_t category, uint8_t type, const char *format)
+{
+  record.cycles = ARM_DWT_CYCCNT;
+  record.magic = MAGIC;
+  record.info = (category << 4) | type;
+  record.length = 0;
+  record.format = (uint32_t)(uintptr_t)format;
+}
+
+void Trace::commit_(Record &record)
+{
+  memset(record.payload + record.length, 0, PAYLOAD_SIZE - record.length);
+  const uint8_t *bytes = (const uint8_t *)&record;
+  uint8_t checksum = 0;
+  for (uint8_t i = 0; i < sizeof(Record); i++)
+  {
+    if (i != offsetof(Record, checksum))
+      checksum += bytes[i];
+  }
+  record.checksum = checksum;
+
+  // Records may come from interrupts
+  __disable_irq();
+  if ((uint16_t)(head_ - tail_) >= CAPACITY)
+  {
+    dropped_++;
+  }
+  else
+  {
+    ring_[head_ % CAPACITY] = record;
+    head_ = head_ + 1;
+  }
+  __enable_irq();
+}
+
+void Trace::sync_()
+{
+  lastSync_ = millis();
+  Record record;
+  start_(record, TRACE_MAIN, TYPE_SYNC, nullptr);
+  uint32_t values[] = {(uint32_t)lastSync_, F_CPU_ACTUAL, dropped_};
+  putBytes_(record, values, sizeof(values));
+  commit_(record);
+}
+
+void Trace::putBytes_(Record &record, const void *data, uint8_t size)
+{
+  // What doesn't fit is lost, the decoder stops at the end of the payload
+  uint8_t room = PAYLOAD_SIZE - record.length;
+  if (size > room)
+  {
+    size = room;
+  }
+  memcpy(record.payload + record.length, data, size);
+  record.length += size;
+}
+
+void Trace::put_(Record &record, const char *value)
+{
+  if (value == nullptr)
+  {
+    value = "(null)";
+  }
+  // Cut strings keep their terminator
+  uint8_t room = PAYLOAD_SIZE - record.length;
+  if (room == 0)
+  {
+    return;
+  }
+  size_t length = strnlen(value, room - 1);
+  memcpy(record.payload + record.length, value, length);
+  record.payload[record.length + length] = 0;
+  record.length += length + 1;
+}
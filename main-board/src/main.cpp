@@ -1,5 +1,7 @@
 #define DEBUG
 #define ENABLE_MTP
+// #define I2C_STATS_OVERLAY // Draw the I2C bus counters over the spectrum at boot (toggle with 'o' on serial)
+// #define BOOT_TIMELINE_OVERLAY // Draw the boot phases over the spectrum (toggle with 't' on serial)
 
 #include <EEPROM.h>
 #include <Audio.h>
@@ -9,8 +11,12 @@
 #include <SD.h>
 #include <SerialFlash.h>
 #include <MTP_Teensy.h>
+#include <I2CBus.h>
 
 #include "Log.h"
+#include "BootTimeline.h"
+#include "Scheduler.h"
+#include "PerfHud.h"
 #include "FFT.h"
 #include "FM.h"
 #include "Display.h"
@@ -22,13 +28,7 @@
 #include "AudioSystem.h"
 #include "AudioModeController.h"
 #include "AudioModeControllerNull.h"
-#include "AudioModeControllerBluetooth.h"
-#include "AudioModeControllerNFCPlayer.h"
-#include "AudioModeControllerPong.h"
-#include "AudioModeControllerRadio.h"
-#include "AudioModeControllerSDPlayer.h"
-#include "AudioModeControllerSDRecorder.h"
-#include "AudioModeControllerTimeSetup.h"
+#include "AudioModeControllerPool.h"
 
 #define PIN_VUMETER 14
 #define PIN_BRIGHTNESS 2
@@ -41,7 +41,7 @@
 Display display;
 FFT fft;
 I2C i2c;
-I2CTimer timer = i2c.getTimer();
+I2CTimer &timer = i2c.getTimer(); // Shared so FM and I2C::loop() don't use the bus at the same time
 FM radio(&timer);
 
 AudioSystem audioSystem;
@@ -49,9 +49,33 @@ AudioAnalyzePeak *currentPeak = audioSystem.getPlaybackPeak();
 Recorder recorder(*audioSystem.getWavPlayer(), *audioSystem.getRecordQueue());
 
 AudioModeControllerNull nullController(audioSystem);
+AudioModeControllerPool controllerPool; // Holds every other controller, one at a time
 AudioModeController *audioController = &nullController;
 
+// Mode switch latency, from exit() to the first frameLoop() of the new mode
+struct ModeSwitchStats
+{
+  uint32_t count = 0;
+  uint32_t enterUs = 0; // exit() to the end of enter()
+  uint32_t frameUs = 0; // exit() to the end of the first frameLoop()
+  uint32_t maxFrameUs = 0;
+};
+ModeSwitchStats modeSwitchStats;
+uint32_t modeSwitchStart = 0;
+bool awaitingFirstFrame = false;
+bool toneOverridePending = true; // The tone pot overrides the bitcrusher of the mode's audio profile
+
 bool needsTimeSetup = false;
+BootTimeline bootTimeline;
+PerfHud hud(display);
+
+// Main loop, see the tasks at the end of this file
+static const uint32_t FRAME_PERIOD_US = 31000;
+static const uint32_t FRAME_DEADLINE_US = 33333; // 30 fps
+static const uint32_t FRAME_BUDGET_US = 5000;
+static const uint32_t CLOCK_PERIOD_US = 300000;
+Scheduler scheduler;
+void addLoopTasks();
 
 time_t getTeensy3Time()
 {
@@ -124,14 +148,11 @@ void updateMode(AudioMode newMode)
   }
 
   LOGF("Switching to mode %d\n", newMode);
+  modeSwitchStart = micros();
 
   audioController->exit();
-
-  // Delete previous controller if it's not the null controller
-  if (audioController != &nullController)
-  {
-    delete audioController;
-  }
+  // The next controller is built in the same storage
+  controllerPool.release();
 
   AudioMemoryUsageMaxReset();
 
@@ -142,25 +163,25 @@ void updateMode(AudioMode newMode)
   switch (newMode)
   {
   case MODE_BLUETOOTH:
-    audioController = new AudioModeControllerBluetooth(display, i2c, audioSystem);
+    audioController = controllerPool.create<AudioModeControllerBluetooth>(display, i2c, audioSystem);
     break;
   case MODE_RADIO:
-    audioController = new AudioModeControllerRadio(display, i2c, audioSystem, radio);
+    audioController = controllerPool.create<AudioModeControllerRadio>(display, i2c, audioSystem, radio);
     break;
   case MODE_SD_PLAYBACK:
-    audioController = new AudioModeControllerSDPlayer(display, i2c, audioSystem, recorder);
+    audioController = controllerPool.create<AudioModeControllerSDPlayer>(display, i2c, audioSystem, recorder);
     break;
   case MODE_SD_RECORDER:
-    audioController = new AudioModeControllerSDRecorder(display, i2c, audioSystem, recorder);
+    audioController = controllerPool.create<AudioModeControllerSDRecorder>(display, i2c, audioSystem, recorder);
     break;
   case MODE_NFC_PLAYBACK:
-    audioController = new AudioModeControllerNFCPlayer(display, i2c, audioSystem, recorder);
+    audioController = controllerPool.create<AudioModeControllerNFCPlayer>(display, i2c, audioSystem, recorder);
     break;
   case MODE_TIME_SETUP:
-    audioController = new AudioModeControllerTimeSetup(display, i2c, audioSystem);
+    audioController = controllerPool.create<AudioModeControllerTimeSetup>(display, i2c, audioSystem, radio);
     break;
   case MODE_PONG:
-    audioController = new AudioModeControllerPong(display, i2c, audioSystem);
+    audioController = controllerPool.create<AudioModeControllerPong>(display, i2c, audioSystem);
     break;
   default:
     audioController = &nullController;
@@ -172,6 +193,9 @@ void updateMode(AudioMode newMode)
   currentPeak = audioController->getPeak();
 
   audioController->enter();
+  modeSwitchStats.enterUs = micros() - modeSwitchStart;
+  awaitingFirstFrame = true;
+  toneOverridePending = true;
 
   LOGF("Mode switch complete, now in mode: %d\n", audioController->getMode());
 }
@@ -195,9 +219,23 @@ void onInputButton(bool pressed)
   updateMode(newMode);
 }
 
+// BAND position before the first flip toggling the HUD in this orange button
+// hold, -1 when there was none
+int8_t bandBeforeHud = -1;
+
 void onBandButton(bool pressed)
 {
   LOG("Band button ");
+  // Flipping BAND while holding the orange button toggles the HUD instead
+  if (i2c.getIOState().buttonStates & ORANGE_BTN)
+  {
+    if (bandBeforeHud < 0)
+    {
+      bandBeforeHud = !pressed;
+    }
+    hud.toggle();
+    return;
+  }
   bool inputPressed = i2c.getIOState().buttonStates & INPUT_BTN;
   AudioMode newMode = computeMode(inputPressed, pressed);
   updateMode(newMode);
@@ -205,13 +243,25 @@ void onBandButton(bool pressed)
 
 void onOrangeButton(bool pressed)
 {
-  LOG("Orange button ");
-  LOG(pressed ? "pressed" : "released");
+  LOGF("Orange button %s\n", pressed ? "pressed" : "released");
   if (pressed)
   {
     audioSystem.getMemoryPlayer()->play(boop);
   }
   audioController->handleOrangeButton(pressed);
+
+  // The mode catches up with the BAND switch once the HUD flips are over
+  if (!pressed && bandBeforeHud >= 0)
+  {
+    bool bandPressed = i2c.getIOState().buttonStates & BAND_BTN;
+    bool bandMoved = bandPressed != (bool)bandBeforeHud;
+    bandBeforeHud = -1;
+    if (bandMoved)
+    {
+      bool inputPressed = i2c.getIOState().buttonStates & INPUT_BTN;
+      updateMode(computeMode(inputPressed, bandPressed));
+    }
+  }
 }
 
 void onControl(ControlCommand cmd)
@@ -236,6 +286,96 @@ void onNfcTag(String uid)
   }
 }
 
+// ------------------ Boot stages --------------------- //
+
+// Start-up work that doesn't depend on the splash. On a cold boot it runs
+// between splash frames, each call does at most one blocking step.
+enum BootStage
+{
+  BOOT_SD = 0,
+  BOOT_I2C,
+  BOOT_MTP,
+  BOOT_IO, // Waits for the IO board
+  BOOT_FM, // Timed init steps and the first tune, a quick boot doesn't wait for it
+  BOOT_DONE
+};
+
+BootStage bootStage = BOOT_SD;
+elapsedMillis ioRetryTimer;
+static const unsigned long IO_RETRY_INTERVAL = 50;
+
+void bootStep()
+{
+  switch (bootStage)
+  {
+  case BOOT_SD:
+    LOG("Init SD card");
+    SPI.setMOSI(SDCARD_MOSI_PIN);
+    SPI.setSCK(SDCARD_SCK_PIN);
+    if (!(SD.begin(SDCARD_CS_PIN)))
+    {
+      LOG("Unable to access the SD card");
+    }
+    // Optimize SPI for SD card
+    SPI.beginTransaction(SPISettings(50000000, MSBFIRST, SPI_MODE0));
+    bootTimeline.mark("sd");
+    bootStage = BOOT_I2C;
+    break;
+
+  case BOOT_I2C:
+    LOG("Setup I2C");
+    i2c.init();
+    bootTimeline.mark("i2c");
+    bootStage = BOOT_MTP;
+    break;
+
+  case BOOT_MTP:
+    LOG("Enable MTP");
+    MTP.begin();
+    MTP.addFilesystem(SD, "Media");
+    mtpCheckTime = MTP.storage()->get_DeltaDeviceCheckTimeMS();
+    bootTimeline.mark("mtp");
+    bootStage = BOOT_IO;
+    break;
+
+  case BOOT_IO:
+    if (!i2c.isReady() || ioRetryTimer < IO_RETRY_INTERVAL)
+    {
+      break;
+    }
+    ioRetryTimer = 0;
+    if (i2c.requestDataFromIO(false))
+    {
+      bootTimeline.mark("io");
+      bootStage = BOOT_FM;
+    }
+    break;
+
+  case BOOT_FM:
+    if (!radio.isInitialized())
+    {
+      radio.init();
+      if (radio.isInitialized())
+      {
+        bootTimeline.mark("fm");
+      }
+    }
+    else if (radio.isTuning())
+    {
+      radio.update();
+    }
+    else
+    {
+      bootTimeline.mark("fm tuned");
+      bootStage = BOOT_DONE;
+    }
+    break;
+
+  default:
+    break;
+  }
+}
+
 // ------------------ Setup --------------------- //
 
 void setup()
@@ -263,6 +403,7 @@ void setup()
 
   LOGF("RTC valid: %d, Quick boot: %d, last update: %d, now: %d\n",
        rtcValid, quickBoot, SNVS_LPGPR1, now());
+  bootTimeline.mark("rtc");
 
   LOG("Setup pins");
   pinMode(PIN_VUMETER, OUTPUT);
@@ -272,74 +413,59 @@ void setup()
   display.init();
   display.clear();
   display.update();
-
-  LOG("Init SD card");
-  SPI.setMOSI(SDCARD_MOSI_PIN);
-  SPI.setSCK(SDCARD_SCK_PIN);
-  if (!(SD.begin(SDCARD_CS_PIN)))
-  {
-    LOG("Unable to access the SD card");
-  }
-
-  // Optimize SPI for SD card
-  SPI.beginTransaction(SPISettings(50000000, MSBFIRST, SPI_MODE0));
+  bootTimeline.mark("display");
 
   LOG("Init audio board");
   audioSystem.init();
 
-  // audioController->setMixerGains();
-
   LOG("Init FFT");
   fft.init(audioSystem.getFFT());
+  bootTimeline.mark("audio");
 
+  radio.setQuickBoot(quickBoot);
   LOGF("Quick boot: %d, last update: %d, now: %d\n", quickBoot, SNVS_LPGPR1, now());
   if (!quickBoot)
   {
     // Normal boot sequence
     LOG("Start boot animation");
     analogWrite(PIN_BRIGHTNESS, 240);
-    audioSystem.getOutputAmp()->gain(0.04);
+    audioSystem.setOutputGain(0.04, false);
     audioSystem.getMemoryPlayer()->play(boot_sound);
-    audioSystem.getBitcrusher()->bits(14);
-    audioSystem.getBitcrusher()->sampleRate(5512);
+    audioSystem.setBitcrusher(14, 5512);
     display.drawSplash();
 
+    // SD, I2C, MTP and FM come up behind the animation
     elapsedMillis splashTimer = 0;
-    while (splashTimer < 5800) // animationEnd in Display.cpp
+    while (splashTimer < 5800 || bootStage < BOOT_FM) // animationEnd in Display.cpp
     {
+      if (bootStage != BOOT_DONE)
+      {
+        bootStep();
+      }
       display.update();
       yield();
     }
+    bootTimeline.mark("splash");
 
-    audioSystem.getBitcrusher()->bits(16);
-    audioSystem.getBitcrusher()->sampleRate(44100);
+    audioSystem.setBitcrusher(16, 44100);
   }
   else
   {
     LOG("Quick boot sequence");
     analogWrite(PIN_BRIGHTNESS, 240);
-    audioSystem.getOutputAmp()->gain(0);
+    audioSystem.setOutputGain(0, false);
+    // The radio mode finishes the FM init itself
+    while (bootStage < BOOT_FM)
+    {
+      bootStep();
+      yield();
+    }
   }
 
   display.clear();
   display.update();
 
-  LOG("Setup I2C");
-  i2c.init();
-
-  LOG("Setup FM");
-  radio.init();
-
   LOG("Init start mode");
-  while (!i2c.requestDataFromIO(false))
-  {
-    delay(50);
-  }
-
-  LOG("Enable MTP");
-  MTP.begin();
-  MTP.addFilesystem(SD, "Media");
-  mtpCheckTime = MTP.storage()->get_DeltaDeviceCheckTimeMS();
 
   if (needsTimeSetup)
   {
@@ -368,12 +494,101 @@ void setup()
 
   AudioProcessorUsageMaxReset();
   AudioMemoryUsageMaxReset();
+  bootTimeline.mark("mode");
+  addLoopTasks();
 }
 
-// ------------------ Main loop --------------------- //
+// ------------------ Serial commands --------------------- //
 
-elapsedMillis msecs;
-elapsedMillis clockTimer;
+#ifdef I2C_STATS_OVERLAY
+bool showI2CStats = true;
+#else
+bool showI2CStats = false;
+#endif
+
+#ifdef BOOT_TIMELINE_OVERLAY
+bool showBootTimeline = true;
+#else
+bool showBootTimeline = false;
+#endif
+
+#ifdef DEBUG
+// i: dump I2C telemetry, c: clear it, o: toggle the on-screen overlay
+// s: dump the main loop task stats, r: clear them, h: toggle the performance HUD
+// x: start / stop recording the IO board inputs to the SD card, X: to serial
+// 0-7: toggle a trace category (Trace::Category)
+void handleSerialCommands()
+{
+  while (Serial.available())
+  {
+    int command = Serial.read();
+    switch (command)
+    {
+    case 'i':
+      i2c.printStats(Serial);
+      break;
+    case 'c':
+      i2c.resetStats();
+      Serial.println("I2C stats cleared");
+      break;
+    case 'o':
+      showI2CStats = !showI2CStats;
+      break;
+    case 'b':
+      bootTimeline.print(Serial);
+      break;
+    case 'm':
+      Serial.printf("Mode switches: %lu, last enter %lu us, first frame %lu us, max %lu us\n",
+                    (unsigned long)modeSwitchStats.count, (unsigned long)modeSwitchStats.enterUs,
+                    (unsigned long)modeSwitchStats.frameUs, (unsigned long)modeSwitchStats.maxFrameUs);
+      break;
+    case 't':
+      showBootTimeline = !showBootTimeline;
+      break;
+    case 'h':
+      hud.toggle();
+      break;
+    case 's':
+      scheduler.print(Serial);
+      break;
+    case 'r':
+      scheduler.resetStats();
+      Serial.println("Scheduler stats cleared");
+      break;
+    case 'x':
+    case 'X':
+    {
+      IOTrace &ioTrace = i2c.getIOTrace();
+      if (ioTrace.isRecording())
+      {
+        ioTrace.stop();
+        Serial.printf("IO trace stopped, %lu frames dropped\n", (unsigned long)ioTrace.getDropped());
+      }
+      else if (command == 'X')
+      {
+        ioTrace.startSerial();
+      }
+      else if (ioTrace.startSD())
+      {
+        Serial.printf("Recording IO trace to %s\n", ioTrace.getPath());
+      }
+      break;
+    }
+#if TRACE_ENABLED
+    default:
+      if (command >= '0' && command < '0' + Trace::TRACE_CATEGORIES)
+      {
+        trace.toggle(command - '0');
+        Serial.printf("Trace mask: %02lx\n", trace.getMask() & 0xFF);
+      }
+      break;
+#endif
+    }
+  }
+}
+#endif
+
+// ------------------ Main loop --------------------- //
 
 // Audio processing constants
 static const int SAMPLE_RATES[] = {2756, 5512, 5512, 5512, 11025, 11025, 22050, 22050, 44100};
@@ -382,30 +597,62 @@ static const int SAMPLE_RATES_LENGTH = 9;
 static const int BIT_DEPTHS[] = {8, 10, 12, 14, 16};
 static const int BIT_DEPTHS_LENGTH = 5;
 
-void loop()
+Scheduler::TaskResult busTask()
 {
   i2c.loop();
+  // Button / NFC / control callbacks run here, once the bus has been released
+  i2c.dispatchEvents();
+#ifdef DEBUG
+  handleSerialCommands();
+#endif
+  return Scheduler::TASK_DONE;
+}
 
-  if (!recorder.isRecording() && !recorder.isPlaying())
+Scheduler::TaskResult modeTask()
+{
+  audioController->loop();
+  audioSystem.update();
+
+  // Reset to first audio: the start mode is up, and in radio mode tuned. After
+  // a quick boot the tune may complete long after setup()
+  static bool firstAudioMarked = false;
+  if (!firstAudioMarked && (audioController->getMode() != MODE_RADIO || radio.getTimeToAudio()))
   {
-    MTP.loop();
+    firstAudioMarked = true;
+    bootTimeline.mark("first audio");
+    LOGF("First audio %lu ms after reset\n", millis());
+#ifdef DEBUG
+    bootTimeline.print(Serial);
+#endif
   }
+  return Scheduler::TASK_DONE;
+}
 
-  auto currentMode = audioController->getMode();
-  audioController->loop();
+// The frame is done in stages, it yields between them once over budget
+enum FrameStage
+{
+  FRAME_CONTROLS = 0, // Volume, brightness, VU meter, bitcrusher
+  FRAME_FFT,
+  FRAME_MODE, // Mode frameLoop() and overlays
+  FRAME_PUSH, // Display update
+  FRAME_DONE
+};
+
+FrameStage frameStage = FRAME_CONTROLS;
+uint32_t frameRenderUs = 0; // Stages of the current frame, for the HUD
 
-  // Main audio/display loop
-  if (msecs > 30)
+void frameStep(FrameStage stage)
+{
+  auto currentMode = audioController->getMode();
+  switch (stage)
+  {
+  case FRAME_CONTROLS:
   {
-    msecs = 0;
     audioController->updateOutputVolume();
-    analogWrite(PIN_BRIGHTNESS, i2c.getIOState().brightness);
-    // Update clock every 300ms
-    if (clockTimer >= 300 && !needsTimeSetup)
+    byte potsChanged = i2c.takePotsChanged(TONE_CHANGED | BRIGHTNESS_CHANGED);
+    if (potsChanged & BRIGHTNESS_CHANGED)
     {
-      clockTimer = 0;
-      display.updateClock();
-      SNVS_LPGPR1 = now();
+      analogWrite(PIN_BRIGHTNESS, i2c.getIOState().brightness);
     }
 
     if (i2c.getIOState().volume == 0 && currentMode != MODE_SD_RECORDER)
@@ -423,15 +670,18 @@ void loop()
       analogWrite(PIN_VUMETER, monoPeak);
     }
 
-    if (currentMode != MODE_PONG) {
+    if (currentMode != MODE_PONG && ((potsChanged & TONE_CHANGED) || toneOverridePending)) {
+      toneOverridePending = false;
       float tonePotVal = map((float)i2c.getIOState().tone, 0.f, 255.f, 0.f, 1.f);
       int mappedVal = getMappedValue(tonePotVal, BIT_DEPTHS, BIT_DEPTHS_LENGTH);
       int mappedVal2 = getMappedValue(tonePotVal, SAMPLE_RATES, SAMPLE_RATES_LENGTH);
 
-      audioSystem.getBitcrusher()->bits(mappedVal);
-      audioSystem.getBitcrusher()->sampleRate(mappedVal2);
+      audioSystem.setBitcrusher(mappedVal, mappedVal2);
     }
+    break;
+  }
 
+  case FRAME_FFT:
     if (!needsTimeSetup && currentMode != MODE_PONG && fft.available())
     {
       display.clearMainArea();
@@ -441,9 +691,35 @@ void loop()
       fft.drawNewLevels(&display, tuning);
       display.tft.setClipRect();
     }
+    break;
 
+  case FRAME_MODE:
     audioController->frameLoop();
+    if (awaitingFirstFrame)
+    {
+      awaitingFirstFrame = false;
+      modeSwitchStats.count++;
+      modeSwitchStats.frameUs = micros() - modeSwitchStart;
+      modeSwitchStats.maxFrameUs = max(modeSwitchStats.maxFrameUs, modeSwitchStats.frameUs);
+      LOGF("Mode switch: enter after %lu us, first frame after %lu us\n",
+           modeSwitchStats.enterUs, modeSwitchStats.frameUs);
+    }
 
+    if (showI2CStats)
+    {
+      display.drawI2CStats();
+    }
+    if (showBootTimeline)
+    {
+      display.drawBootTimeline(bootTimeline);
+    }
+    if (hud.isVisible())
+    {
+      display.drawPerfHud(hud.getLine());
+    }
+    break;
+
+  case FRAME_PUSH:
     if (recorder.isRecording())
     {
       display.updateAsync();
@@ -452,5 +728,79 @@ void loop()
     {
       display.update();
     }
+    break;
+
+  default:
+    break;
+  }
+}
+
+Scheduler::TaskResult frameTask()
+{
+  while (frameStage != FRAME_DONE)
+  {
+    uint32_t stageStart = micros();
+    frameStep(frameStage);
+    frameRenderUs += micros() - stageStart;
+    frameStage = (FrameStage)(frameStage + 1);
+    if (frameStage != FRAME_DONE && scheduler.shouldYield())
+    {
+      return Scheduler::TASK_YIELD;
+    }
   }
+  frameStage = FRAME_CONTROLS;
+  hud.frameRendered(frameRenderUs);
+  frameRenderUs = 0;
+  return Scheduler::TASK_DONE;
+}
+
+Scheduler::TaskResult clockTask()
+{
+  if (!needsTimeSetup)
+  {
+    display.updateClock();
+    SNVS_LPGPR1 = now();
+  }
+  return Scheduler::TASK_DONE;
+}
+
+Scheduler::TaskResult mtpTask()
+{
+  if (!recorder.isRecording() && !recorder.isPlaying())
+  {
+    MTP.loop();
+  }
+  return Scheduler::TASK_DONE;
+}
+
+Scheduler::TaskResult ioTraceTask()
+{
+  i2c.getIOTrace().drain();
+  return Scheduler::TASK_DONE;
+}
+
+#if TRACE_ENABLED
+Scheduler::TaskResult traceTask()
+{
+  trace.drain(Serial);
+  return Scheduler::TASK_DONE;
+}
+#endif
+
+void addLoopTasks()
+{
+  scheduler.addTask("i2c", busTask, 0);
+  scheduler.addTask("mode", modeTask, 0);
+  scheduler.addTask("frame", frameTask, FRAME_PERIOD_US, FRAME_DEADLINE_US, FRAME_BUDGET_US);
+  scheduler.addTask("clock", clockTask, CLOCK_PERIOD_US);
+  scheduler.addTask("mtp", mtpTask, 0);
+  scheduler.addTask("iotrace", ioTraceTask, 0);
+#if TRACE_ENABLED
+  scheduler.addTask("trace", traceTask, 0);
+#endif
+}
+
+void loop()
+{
+  scheduler.run();
 }
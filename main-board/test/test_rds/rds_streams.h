@@ -0,0 +1,71 @@
+#pragma once
+
+#include <stdint.h>
+#include "RDSDecoder.h"
+
+// One group as read from the RDA5807 RDS registers (0x0C-0x0F), with the
+// blocks its error counters flagged as uncorrectable
+struct RDSGroup
+{
+  uint16_t blockA;
+  uint16_t blockB;
+  uint16_t blockC;
+  uint16_t blockD;
+  uint8_t errors;
+};
+
+#define GROUP_COUNT(stream) (sizeof(stream) / sizeof(stream[0]))
+
+// 0A / 2A / 4A cycle of one station, with a group whose block B could not be corrected
+static const RDSGroup STATION_STREAM[] = {
+  {0xF201, 0x0540, 0xE0CD, 0x4649, 0}, // 0A PS 0 "FI"
+  {0xF201, 0x2140, 0x4E6F, 0x7720, 0}, // 2A RT 0 "Now "
+  {0xF201, 0x0541, 0xE0CD, 0x5020, 0}, // 0A PS 1 "P "
+  {0xF201, 0x2141, 0x706C, 0x6179, 0}, // 2A RT 1 "play"
+  {0xF201, 0x0542, 0xE0CD, 0x2020, 0}, // 0A PS 2 "  "
+  {0xF201, 0x0542, 0xE0CD, 0x5858, RDS_ERROR_B}, // 0A PS 2 "XX", block B errored
+  {0xF201, 0x2142, 0x696E, 0x673A, 0}, // 2A RT 2 "ing:"
+  {0xF201, 0x4141, 0xD85C, 0xA784, 0}, // 4A CT MJD 60462 10:30 offset +4
+  {0xF201, 0x0543, 0xE0CD, 0x2020, 0}, // 0A PS 3 "  "
+  {0xF201, 0x2143, 0x204D, 0x696C, 0}, // 2A RT 3 " Mil"
+  {0xF201, 0x2144, 0x6573, 0x2044, 0}, // 2A RT 4 "es D"
+  {0xF201, 0x2145, 0x6176, 0x6973, 0}, // 2A RT 5 "avis"
+  {0xF201, 0x2146, 0x202D, 0x2053, 0}, // 2A RT 6 " - S"
+  {0xF201, 0x2147, 0x6F20, 0x5768, 0}, // 2A RT 7 "o Wh"
+  {0xF201, 0x2148, 0x6174, 0x0D20, 0}, // 2A RT 8 "at\r "
+};
+
+// A RadioText and the start of its repetition, then a shorter text after the A/B flag toggled
+static const RDSGroup RT_TOGGLE_STREAM[] = {
+  {0xF201, 0x2140, 0x4D6F, 0x726E, 0}, // 2A RT 0 "Morn"
+  {0xF201, 0x2141, 0x696E, 0x6720, 0}, // 2A RT 1 "ing "
+  {0xF201, 0x2142, 0x7368, 0x6F77, 0}, // 2A RT 2 "show"
+  {0xF201, 0x2143, 0x2077, 0x6974, 0}, // 2A RT 3 " wit"
+  {0xF201, 0x2144, 0x6820, 0x416E, 0}, // 2A RT 4 "h An"
+  {0xF201, 0x2145, 0x6E61, 0x2061, 0}, // 2A RT 5 "na a"
+  {0xF201, 0x2146, 0x6E64, 0x2050, 0}, // 2A RT 6 "nd P"
+  {0xF201, 0x2147, 0x6175, 0x6C0D, 0}, // 2A RT 7 "aul\r"
+  {0xF201, 0x2140, 0x4D6F, 0x726E, 0}, // 2A RT 0 "Morn"
+  {0xF201, 0x2151, 0x0D20, 0x2020, 0}, // 2A RT 1 "\r   "
+  {0xF201, 0x2150, 0x4E65, 0x7773, 0}, // 2A RT 0 "News"
+};
+
+// 0B / 2B groups, block A often errored: the PI comes from block C
+static const RDSGroup VERSION_B_STREAM[] = {
+  {0xFFFF, 0x0D40, 0xF212, 0x4A41, RDS_ERROR_A}, // 0B PS 0 "JA"
+  {0xF212, 0x0D41, 0xF212, 0x434B, 0}, // 0B PS 1 "CK"
+  {0xFFFF, 0x0D42, 0xF212, 0x414C, RDS_ERROR_A}, // 0B PS 2 "AL"
+  {0xF212, 0x0D43, 0xF212, 0x2020, 0}, // 0B PS 3 "  "
+  {0x1234, 0x2940, 0xF212, 0x4869, RDS_ERROR_A}, // 2B RT 0 "Hi"
+  {0x1234, 0x2941, 0xF212, 0x2074, RDS_ERROR_A}, // 2B RT 1 " t"
+  {0x1234, 0x2942, 0xF212, 0x6865, RDS_ERROR_A}, // 2B RT 2 "he"
+  {0x1234, 0x2943, 0xF212, 0x7265, RDS_ERROR_A}, // 2B RT 3 "re"
+  {0x1234, 0x2944, 0xF212, 0x0D20, RDS_ERROR_A}, // 2B RT 4 "\r "
+};
+
+// 4A groups: negative local offset, an errored block D, then a station without a clock
+static const RDSGroup CLOCK_STREAM[] = {
+  {0xF201, 0x4141, 0xD85D, 0x7EE7, 0}, // 4A CT MJD 60462 23:59 offset -7
+  {0xF201, 0x4141, 0xD85E, 0x0040, RDS_ERROR_D}, // 4A CT MJD 60463 00:01 offset +0
+  {0xF201, 0x4140, 0x0000, 0x0000, 0}, // 4A CT all zeros, no clock
+};
@@ -0,0 +1,140 @@
+#include <unity.h>
+#include "RDSDecoder.h"
+#include "rds_streams.h"
+
+// Run on the PC against the group streams in rds_streams.h:
+//   pio test -e native_test
+
+static RDSDecoder decoder;
+
+static void feed(const RDSGroup *groups, size_t count)
+{
+  for (size_t i = 0; i < count; i++)
+  {
+    decoder.decode(groups[i].blockA, groups[i].blockB, groups[i].blockC, groups[i].blockD, groups[i].errors);
+  }
+}
+
+void setUp()
+{
+  decoder = RDSDecoder();
+  decoder.reset();
+  decoder.takeProgramServiceChanged();
+  decoder.takeRadioTextChanged();
+}
+
+void tearDown() {}
+
+void test_ps_published_once_all_segments_are_in()
+{
+  // Segments 0-2 (plus the errored group) leave the name unpublished
+  feed(STATION_STREAM, 8);
+  TEST_ASSERT_FALSE(decoder.takeProgramServiceChanged());
+  TEST_ASSERT_EQUAL_STRING("", decoder.getProgramService());
+
+  feed(STATION_STREAM + 8, 1);
+  TEST_ASSERT_TRUE(decoder.takeProgramServiceChanged());
+  TEST_ASSERT_EQUAL_STRING("FIP", decoder.getProgramService());
+  TEST_ASSERT_EQUAL_HEX16(0xF201, decoder.getPI());
+  TEST_ASSERT_EQUAL(10, decoder.getPTY());
+  TEST_ASSERT_TRUE(decoder.hasTrafficProgram());
+
+  // A repetition of the same name is not a change
+  feed(STATION_STREAM, 9);
+  TEST_ASSERT_FALSE(decoder.takeProgramServiceChanged());
+}
+
+void test_rt_stops_at_end_marker()
+{
+  feed(STATION_STREAM, GROUP_COUNT(STATION_STREAM) - 1);
+  TEST_ASSERT_FALSE(decoder.takeRadioTextChanged());
+
+  // Segment 8 holds the 0x0D, segments 9-15 are never sent
+  feed(STATION_STREAM + GROUP_COUNT(STATION_STREAM) - 1, 1);
+  TEST_ASSERT_TRUE(decoder.takeRadioTextChanged());
+  TEST_ASSERT_EQUAL_STRING("Now playing: Miles Davis - So What", decoder.getRadioText());
+}
+
+void test_errored_block_b_dropped()
+{
+  feed(STATION_STREAM, GROUP_COUNT(STATION_STREAM));
+  TEST_ASSERT_EQUAL(GROUP_COUNT(STATION_STREAM), decoder.getGroupCount());
+  TEST_ASSERT_EQUAL(1, decoder.getErrorCount());
+  // Taken as it reads, the errored group would have put "XX" in the name
+  TEST_ASSERT_EQUAL_STRING("FIP", decoder.getProgramService());
+  TEST_ASSERT_EQUAL_STRING("Now playing: Miles Davis - So What", decoder.getRadioText());
+}
+
+void test_rt_toggle_clears_text()
+{
+  // First text and the first segment of its repetition
+  feed(RT_TOGGLE_STREAM, 9);
+  TEST_ASSERT_TRUE(decoder.takeRadioTextChanged());
+  TEST_ASSERT_EQUAL_STRING("Morning show with Anna and Paul", decoder.getRadioText());
+
+  // The end marker of the new text, in segment 1: the segment 0 left over
+  // from the old text must not complete it
+  feed(RT_TOGGLE_STREAM + 9, 1);
+  TEST_ASSERT_FALSE(decoder.takeRadioTextChanged());
+  TEST_ASSERT_EQUAL_STRING("Morning show with Anna and Paul", decoder.getRadioText());
+
+  feed(RT_TOGGLE_STREAM + 10, 1);
+  TEST_ASSERT_TRUE(decoder.takeRadioTextChanged());
+  TEST_ASSERT_EQUAL_STRING("News", decoder.getRadioText());
+}
+
+void test_version_b_pi_from_block_c()
+{
+  feed(VERSION_B_STREAM, 1);
+  TEST_ASSERT_EQUAL_HEX16(0xF212, decoder.getPI());
+
+  // Block A is errored in most groups, its garbage must not reset the decoder
+  feed(VERSION_B_STREAM + 1, GROUP_COUNT(VERSION_B_STREAM) - 1);
+  TEST_ASSERT_EQUAL_HEX16(0xF212, decoder.getPI());
+  TEST_ASSERT_EQUAL_STRING("JACKAL", decoder.getProgramService());
+  TEST_ASSERT_EQUAL_STRING("Hi there", decoder.getRadioText());
+  TEST_ASSERT_EQUAL(0, decoder.getErrorCount());
+}
+
+void test_ct_with_positive_offset()
+{
+  feed(STATION_STREAM, 8);
+  RDSClockTime time;
+  TEST_ASSERT_TRUE(decoder.takeClockTime(time));
+  TEST_ASSERT_EQUAL(60462, time.mjd);
+  TEST_ASSERT_EQUAL(10, time.hour);
+  TEST_ASSERT_EQUAL(30, time.minute);
+  TEST_ASSERT_EQUAL(4, time.offset);
+  // 2024-06-01 10:30 UTC
+  TEST_ASSERT_EQUAL_UINT32(1717237800UL, time.unixTime());
+  // Taken once
+  TEST_ASSERT_FALSE(decoder.takeClockTime(time));
+}
+
+void test_ct_with_negative_offset()
+{
+  RDSClockTime time;
+  feed(CLOCK_STREAM, 1);
+  TEST_ASSERT_TRUE(decoder.takeClockTime(time));
+  TEST_ASSERT_EQUAL(60462, time.mjd);
+  TEST_ASSERT_EQUAL(23, time.hour);
+  TEST_ASSERT_EQUAL(59, time.minute);
+  TEST_ASSERT_EQUAL(-7, time.offset);
+
+  // Errored block D, then a station that sends no clock
+  feed(CLOCK_STREAM + 1, 2);
+  TEST_ASSERT_FALSE(decoder.takeClockTime(time));
+}
+
+int main()
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_ps_published_once_all_segments_are_in);
+  RUN_TEST(test_rt_stops_at_end_marker);
+  RUN_TEST(test_errored_block_b_dropped);
+  RUN_TEST(test_rt_toggle_clears_text);
+  RUN_TEST(test_version_b_pi_from_block_c);
+  RUN_TEST(test_ct_with_positive_offset);
+  RUN_TEST(test_ct_with_negative_offset);
+  return UNITY_END();
+}
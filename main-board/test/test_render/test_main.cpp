@@ -0,0 +1,68 @@
+#include <unity.h>
+#include <string>
+#include <vector>
+#include "Scenes.h"
+
+// Renders the scenes of host/render and checks them against host/golden.txt:
+//   pio test -e native_test
+// After an intended change to the frames, rewrite the list with
+// render --update host/golden.txt
+
+static std::vector<GoldenHash> golden;
+static std::vector<GoldenHash> rendered;
+
+// The list sits two directories up from this file
+static std::string goldenPath()
+{
+  std::string path = __FILE__;
+  return path.substr(0, path.rfind('/') + 1) + "../../host/golden.txt";
+}
+
+static const GoldenHash *find(const std::vector<GoldenHash> &hashes, const std::string &name)
+{
+  for (const GoldenHash &hash : hashes)
+  {
+    if (hash.name == name)
+      return &hash;
+  }
+  return nullptr;
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_golden_list_read()
+{
+  TEST_ASSERT_TRUE(readGolden(goldenPath().c_str(), golden));
+  TEST_ASSERT_EQUAL(rendered.size(), golden.size());
+}
+
+void test_frames_match_golden()
+{
+  for (const GoldenHash &expected : golden)
+  {
+    const GoldenHash *frame = find(rendered, expected.name);
+    TEST_ASSERT_TRUE_MESSAGE(frame != nullptr, expected.name.c_str());
+    TEST_ASSERT_EQUAL_HEX32_MESSAGE(expected.hash, frame->hash, expected.name.c_str());
+  }
+}
+
+void test_every_scene_listed()
+{
+  for (const GoldenHash &frame : rendered)
+  {
+    TEST_ASSERT_TRUE_MESSAGE(find(golden, frame.name) != nullptr, frame.name.c_str());
+  }
+}
+
+int main()
+{
+  static Scenes scenes;
+  scenes.renderAll([](const std::string &name) { rendered.push_back({name, scenes.screen.hash()}); });
+
+  UNITY_BEGIN();
+  RUN_TEST(test_golden_list_read);
+  RUN_TEST(test_frames_match_golden);
+  RUN_TEST(test_every_scene_listed);
+  return UNITY_END();
+}
@@ -0,0 +1,219 @@
+#!/usr/bin/python3
+"""Decodes the binary trace written by Trace::drain() (include/Trace.h).
+
+Records hold the address of their format string, which is looked up in the
+firmware ELF, so the ELF must be the one running on the board:
+
+    cat /dev/ttyACM0 > capture.bin
+    tools/trace_decode.py .pio/build/teensy40/firmware.elf capture.bin
+    tools/trace_decode.py firmware.elf capture.bin --chrome trace.json
+
+The Chrome trace opens in chrome://tracing or https://ui.perfetto.dev.
+Text printed on the same serial port (command output) is kept, prefixed
+with "serial:".
+"""
+
+import argparse
+import json
+import re
+import struct
+import sys
+
+MAGIC = 0xA5
+RECORD_SIZE = 32
+PAYLOAD_SIZE = 20
+
+CATEGORIES = ["main", "i2c", "bt", "recorder", "display", "audio", "fm", "sched"]
+TYPE_MESSAGE, TYPE_BEGIN, TYPE_END, TYPE_SYNC = range(4)
+
+FORMAT_SPEC = re.compile(r"%([-+ #0]*\d*(?:\.\d+)?)(hh|h|ll|l|z|j|t)?([diouxXcsfeEgGp%])")
+
+
+class Elf:
+    """Reads C strings at the addresses of the loadable sections."""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            self.data = f.read()
+        if self.data[:4] != b"\x7fELF":
+            raise ValueError(f"{path} is not an ELF file")
+        is64 = self.data[4] == 2
+        endian = "<" if self.data[5] == 1 else ">"
+        if is64:
+            shoff, = struct.unpack_from(endian + "Q", self.data, 0x28)
+            shentsize, shnum = struct.unpack_from(endian + "HH", self.data, 0x3A)
+            header = endian + "IIQQQQIIQQ"
+        else:
+            shoff, = struct.unpack_from(endian + "I", self.data, 0x20)
+            shentsize, shnum = struct.unpack_from(endian + "HH", self.data, 0x2E)
+            header = endian + "IIIIIIIIII"
+
+        SHT_PROGBITS, SHF_ALLOC = 1, 2
+        self.sections = []
+        for i in range(shnum):
+            _, kind, flags, addr, offset, size = struct.unpack_from(
+                header, self.data, shoff + i * shentsize)[:6]
+            if kind == SHT_PROGBITS and flags & SHF_ALLOC and size:
+                self.sections.append((addr, offset, size))
+        self.cache = {}
+
+    def string(self, address):
+        if address in self.cache:
+            return self.cache[address]
+        text = None
+        for start, offset, size in self.sections:
+            if start <= address < start + size:
+                begin = offset + address - start
+                end = self.data.find(b"\0", begin, offset + size)
+                text = self.data[begin:end if end >= 0 else offset + size].decode("latin-1")
+                break
+        self.cache[address] = text
+        return text
+
+
+def format_message(fmt, payload):
+    """printf on the raw arguments, the format tells their type."""
+    out = []
+    position = 0
+    last = 0
+    for match in FORMAT_SPEC.finditer(fmt):
+        out.append(fmt[last:match.start()])
+        last = match.end()
+        flags, length, conversion = match.groups()
+        if conversion == "%":
+            out.append("%")
+            continue
+        if position >= len(payload):
+            out.append("<?>")
+            continue
+        if conversion == "s":
+            end = payload.find(b"\0", position)
+            end = len(payload) if end < 0 else end
+            value = payload[position:end].decode("latin-1")
+            position = end + 1
+        elif conversion in "feEgG":
+            value, = struct.unpack_from("<f", payload, position)
+            position += 4
+        elif length == "ll":
+            value, = struct.unpack_from("<q" if conversion in "di" else "<Q", payload.ljust(position + 8, b"\0"), position)
+            position += 8
+        else:
+            value, = struct.unpack_from("<i" if conversion in "di" else "<I", payload.ljust(position + 4, b"\0"), position)
+            position += 4
+            if conversion == "c":
+                value = chr(value & 0xFF)
+            elif conversion == "p":
+                conversion, flags, value = "x", "#" + flags, value
+        out.append(("%" + flags + conversion) % value)
+    out.append(fmt[last:])
+    return "".join(out).rstrip("\n")
+
+
+class Decoder:
+    def __init__(self, elf):
+        self.elf = elf
+        self.cycles = None  # Unwrapped
+        self.cycles_per_us = 600.0
+        self.dropped = 0
+        self.events = []
+
+    def records(self, data):
+        """Yields ("record", bytes) and ("text", str), skipping garbage."""
+        text = bytearray()
+        i = 0
+        while i < len(data):
+            if data[i] == MAGIC and i + RECORD_SIZE <= len(data):
+                record = data[i:i + RECORD_SIZE]
+                checksum = (sum(record) - record[3]) & 0xFF
+                if checksum == record[3] and record[2] <= PAYLOAD_SIZE:
+                    if text:
+                        yield "text", text.decode("latin-1")
+                        text = bytearray()
+                    yield "record", record
+                    i += RECORD_SIZE
+                    continue
+            text.append(data[i])
+            i += 1
+        if text:
+            yield "text", text.decode("latin-1")
+
+    def timestamp(self, cycles):
+        if self.cycles is None:
+            self.cycles = cycles
+        else:
+            # The 32 bit counter wraps every few seconds at 600 MHz, sync
+            # records keep the gaps shorter than that. Interrupts may record
+            # slightly out of order, hence the signed delta.
+            delta = (cycles - self.cycles) & 0xFFFFFFFF
+            if delta >= 0x80000000:
+                delta -= 0x100000000
+            self.cycles += delta
+        return self.cycles / self.cycles_per_us
+
+    def decode(self, data, out):
+        for kind, value in self.records(data):
+            if kind == "text":
+                for line in value.splitlines():
+                    if line.strip():
+                        out.write(f"serial: {line}\n")
+                continue
+
+            _, info, length, _, cycles, address = struct.unpack_from("<BBBBII", value)
+            payload = value[12:12 + length]
+            category, kind = info >> 4, info & 0x0F
+            name = CATEGORIES[category] if category < len(CATEGORIES) else str(category)
+
+            if kind == TYPE_SYNC:
+                millis, cpu, dropped = struct.unpack_from("<III", payload)
+                if cpu:
+                    self.cycles_per_us = cpu / 1e6
+                if dropped != self.dropped:
+                    out.write(f"-- {dropped - self.dropped} records dropped on the device\n")
+                    self.dropped = dropped
+                self.timestamp(cycles)
+                continue
+
+            ts = self.timestamp(cycles)
+            fmt = self.elf.string(address)
+            if fmt is None:
+                fmt = f"<unknown format 0x{address:08x}>"
+
+            if kind == TYPE_BEGIN:
+                self.events.append({"name": fmt, "cat": name, "ph": "B", "ts": ts, "pid": 0, "tid": category})
+                continue
+            if kind == TYPE_END:
+                self.events.append({"name": fmt, "cat": name, "ph": "E", "ts": ts, "pid": 0, "tid": category})
+                continue
+
+            message = format_message(fmt, payload)
+            out.write(f"{ts / 1000:12.3f} ms [{name:8}] {message}\n")
+            self.events.append({"name": message, "cat": name, "ph": "i", "s": "t", "ts": ts, "pid": 0, "tid": category})
+
+    def chrome_trace(self):
+        threads = [{"name": "thread_name", "ph": "M", "pid": 0, "tid": i, "args": {"name": name}}
+                   for i, name in enumerate(CATEGORIES)]
+        return {"traceEvents": threads + self.events, "displayTimeUnit": "ms"}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("elf", help="firmware ELF the capture was made with")
+    parser.add_argument("capture", help="raw serial capture, - for stdin")
+    parser.add_argument("--chrome", metavar="JSON", help="also write a Chrome trace")
+    args = parser.parse_args()
+
+    if args.capture == "-":
+        data = sys.stdin.buffer.read()
+    else:
+        with open(args.capture, "rb") as f:
+            data = f.read()
+
+    decoder = Decoder(Elf(args.elf))
+    decoder.decode(data, sys.stdout)
+    if args.chrome:
+        with open(args.chrome, "w") as f:
+            json.dump(decoder.chrome_trace(), f)
+
+
+if __name__ == "__main__":
+    main()